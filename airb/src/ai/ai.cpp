@@ -4,22 +4,35 @@
 #include "caught_state.hpp"
 #include "patrol_state.hpp"
 
-ai::Ai::Ai( physics::RigidBody &rigid_body, entities::LevelTerrain &terrain)
-           : m_attack(new AttackState())
+ai::Ai::Ai( physics::RigidBody &rigid_body, entities::LevelTerrain &terrain, utilities::Random &random)
+           : m_deceleration(0.2f)
+           , m_angular_damp(3.0f)
+           , m_yaw(0.0f)
+           , m_thrust(0.0f)
+           , m_damp(3.0f)
+           , m_attack(new AttackState())
            , m_caught(new CaughtState())
            , m_idle(new IdleState())
            , m_patrol(new PatrolState())
-           , m_path_finder(terrain)
-           , m_terrain(terrain)
            , m_state(m_patrol)
+           , m_path_finder(terrain)
            , m_rigid_body(rigid_body)
+           , m_terrain(terrain)
+           , m_random(random)
            , m_path_finder_state(IDLE)
+           , m_angle_to_node(0.0f)
+           , m_plane_rotation(0.0f)
+           , m_angle_negative_offset(0.0f)
+           , m_angle_positive_offset(0.0f)
+           , m_plane_node_angle(0.0f)
+           , m_offset(0.0f)
+           , m_velocity_angle(0.0f)
+           , m_plane_velocity_angle(0.0f)
+           , m_goal_reached(true)
 {
     m_path_finder.set_world_size(120);
     m_dimensions[X] = 6000;
     m_dimensions[Y] = 4000;
-    m_goal_reached = true;
-    srand(static_cast<unsigned int>(time(NULL)));
 }
 ai::Ai::~Ai()
 {
@@ -87,7 +100,7 @@ void ai::Ai::update_path_finder(std::chrono::milliseconds const dt, float thrust
     }
     case FOUND_GOAL:
     {
-        turn_direction = rand() % 2;
+        turn_direction = m_random.next_int(2);
         m_distance_to_target = m_target_position - m_current_position;
         if (!check_if_at_goal())
         {
@@ -260,70 +273,29 @@ bool ai::Ai::select_next_position()
     int y = current_pos[Y] + 100;
     if (m_plane_rotation <= 0 * M_PI / 180.0f && m_plane_rotation > -90.0f * M_PI / 180.0)
     {
-        x = current_pos[X] + (rand() % m_random_point_scale + m_random_point_start);
-        y = current_pos[Y] - (rand() % m_random_point_scale + m_random_point_start);
+        x = current_pos[X] + (m_random.next_int(m_random_point_scale) + m_random_point_start);
+        y = current_pos[Y] - (m_random.next_int(m_random_point_scale) + m_random_point_start);
     }
     if (m_plane_rotation > 0 * M_PI / 180.0f && m_plane_rotation <= 90.0f * M_PI / 180.0)
     {
-        x = current_pos[X] + (rand() % m_random_point_scale + m_random_point_start);
-        y = current_pos[Y] + (rand() % m_random_point_scale + m_random_point_start);
+        x = current_pos[X] + (m_random.next_int(m_random_point_scale) + m_random_point_start);
+        y = current_pos[Y] + (m_random.next_int(m_random_point_scale) + m_random_point_start);
     }
     if (m_plane_rotation >= 90.0f * M_PI / 180.0f && m_plane_rotation < 180.0f * M_PI / 180.0)
     {
-        x = current_pos[X] - (rand() % m_random_point_scale + m_random_point_start);
-        y = current_pos[Y] + (rand() % m_random_point_scale + m_random_point_start);
+        x = current_pos[X] - (m_random.next_int(m_random_point_scale) + m_random_point_start);
+        y = current_pos[Y] + (m_random.next_int(m_random_point_scale) + m_random_point_start);
     }
     if (m_plane_rotation <= -90.0f * M_PI / 180.0f && m_plane_rotation > -179.0f * M_PI / 180.0)
     {
-        x = current_pos[X] - (rand() % m_random_point_scale + m_random_point_start);
-        y = current_pos[Y] - (rand() % m_random_point_scale + m_random_point_start);
+        x = current_pos[X] - (m_random.next_int(m_random_point_scale) + m_random_point_start);
+        y = current_pos[Y] - (m_random.next_int(m_random_point_scale) + m_random_point_start);
     }
     if (x > 400
         && x < 5600
         && y > 400
         && y < 3600
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y + 25 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y + 50 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y + 75 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y + 100 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y + 150 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 25, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 50, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 75, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 100, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 150, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y - 25 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y - 50 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y - 75 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y - 100 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x, y - 150 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 25, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 50, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 75, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 100, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 150, y }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 25, y + 25 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 50, y + 50 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 75, y + 75 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 100, y + 100 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 150, y + 150 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 25, y - 25 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 50, y - 50 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 75, y - 75 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 100, y - 100 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 150, y - 150 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 25, y - 25 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 50, y - 50 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 75, y - 75 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 100, y - 100 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x + 150, y - 150 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 25, y + 25 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 50, y + 50 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 75, y + 75 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 100, y + 100 }))
-        && !m_terrain.is_pixel_solid(math::Vector2i({ x - 150, y + 150 }))
-        )
+        && is_area_clear(x, y))
     {
         m_target_position[X] = static_cast<float>(x);
         m_target_position[Y] = static_cast<float>(y);
@@ -346,8 +318,8 @@ void ai::Ai::set_target_position(double x, double y)
 }
 void ai::Ai::create_random_target_position()
 {
-    int x = rand() % m_dimensions[X];
-    int y = rand() % m_dimensions[Y];
+    int x = m_random.next_int(m_dimensions[X]);
+    int y = m_random.next_int(m_dimensions[Y]);
     math::Vector2f random_position;
     random_position[X] = static_cast<float>(x);
     random_position[Y] = static_cast<float>(y);
@@ -355,8 +327,8 @@ void ai::Ai::create_random_target_position()
          + (y - m_current_position[Y]) * (y - m_current_position[Y]));
     while (distance > 500.0f)
     {
-        x = rand() % m_dimensions[X];
-        y = rand() % m_dimensions[Y];
+        x = m_random.next_int(m_dimensions[X]);
+        y = m_random.next_int(m_dimensions[Y]);
         distance = sqrt((x - m_current_position[X]) * (x - m_current_position[X])
                               + (y - m_current_position[Y]) * (y - m_current_position[Y]));
         std::cout << "distance " << distance << std::endl;
@@ -366,6 +338,27 @@ void ai::Ai::create_random_target_position()
     std::cout << "target" << std::endl;
     std::cout << m_target_position << std::endl << std::endl;
 }
+bool ai::Ai::is_area_clear(int x, int y)
+{
+    // Walk up to three nav cells (150 px) out from the target in all
+    // eight directions, like the old per-pixel probes did.
+    static int const PROBE_CELLS = 3;
+    int const cell_x = x / entities::LevelTerrain::NAV_CELL_SIZE;
+    int const cell_y = y / entities::LevelTerrain::NAV_CELL_SIZE;
+
+    if (m_terrain.is_nav_cell_blocked(cell_x, cell_y))
+        return false;
+    for (int d_y = -1; d_y <= 1; ++d_y)
+        for (int d_x = -1; d_x <= 1; ++d_x)
+        {
+            if (d_x == 0 && d_y == 0)
+                continue;
+            for (int i = 1; i <= PROBE_CELLS; ++i)
+                if (m_terrain.is_nav_cell_blocked(cell_x + i * d_x, cell_y + i * d_y))
+                    return false;
+        }
+    return true;
+}
 bool ai::Ai::is_pixel_solid(math::Vector2i const& coordinates)
 {
     return m_terrain.is_pixel_solid(coordinates);
@@ -14,6 +14,7 @@
 #include "../entities/level_terrain.hpp"
 #include "../math/matrix.hpp"
 #include "../physics/rigid_body.hpp"
+#include "../utilities/random.hpp"
 #include "ai_states.hpp"
 #include "attack_state.hpp"
 #include "caught_state.hpp"
@@ -56,6 +57,7 @@ private:
     PathFinding m_path_finder;
     physics::RigidBody &m_rigid_body;
     entities::LevelTerrain &m_terrain;
+    utilities::Random &m_random;
     int m_path_finder_state;
     int m_search_cycles = 0;
     float m_angle_to_node;
@@ -77,7 +79,7 @@ private:
     math::Vector2f m_last_position = math::Vector2f({ -1.0, -1.0 });
     
 public:
-    Ai(physics::RigidBody &rigid_body, entities::LevelTerrain &terrain);
+    Ai(physics::RigidBody &rigid_body, entities::LevelTerrain &terrain, utilities::Random &random);
     virtual ~Ai();
     virtual void execute();
     virtual void change_state(AiStates::states next_state);
@@ -95,6 +97,7 @@ public:
     void set_target_position(double x, double y);
     void create_random_target_position();
     bool is_pixel_solid(math::Vector2i const& coordinates);
+    bool is_area_clear(int x, int y);
     bool check_if_at_goal();
     bool get_path_finder_initialization();
     bool get_rotate_direction(float target_angle, float rotation);
@@ -0,0 +1,115 @@
+#include "open_list.hpp"
+
+#include <cassert>
+
+ai::OpenList::OpenList()
+    : m_heap()
+{
+    m_heap.reserve(1024);
+}
+
+bool ai::OpenList::empty() const
+{
+    return m_heap.empty();
+}
+
+int ai::OpenList::size() const
+{
+    return static_cast<int>(m_heap.size());
+}
+
+bool ai::OpenList::contains(SearchNode const* node) const
+{
+    return node->m_heap_index >= 0;
+}
+
+void ai::OpenList::clear()
+{
+    for (unsigned int i = 0; i < m_heap.size(); ++i)
+        m_heap[i]->m_heap_index = -1;
+    m_heap.clear();
+}
+
+void ai::OpenList::push(SearchNode* node)
+{
+    assert(!contains(node));
+
+    m_heap.push_back(node);
+    node->m_heap_index = size() - 1;
+    sift_up(node->m_heap_index);
+}
+
+void ai::OpenList::decrease_key(SearchNode* node)
+{
+    assert(contains(node));
+
+    sift_up(node->m_heap_index);
+}
+
+ai::SearchNode* ai::OpenList::pop()
+{
+    if (m_heap.empty())
+        return nullptr;
+
+    SearchNode* top = m_heap.front();
+    SearchNode* last = m_heap.back();
+    m_heap.pop_back();
+    top->m_heap_index = -1;
+
+    if (!m_heap.empty())
+    {
+        place(last, 0);
+        sift_down(0);
+    }
+    return top;
+}
+
+bool ai::OpenList::is_ordered_before(SearchNode const* lhs, SearchNode const* rhs) const
+{
+    float const lhs_f = lhs->m_accumulated_distance + lhs->m_heuristic_distance;
+    float const rhs_f = rhs->m_accumulated_distance + rhs->m_heuristic_distance;
+    if (lhs_f != rhs_f)
+        return lhs_f < rhs_f;
+
+    // Prefer nodes closer to the goal on ties to cut down on expansions
+    return lhs->m_heuristic_distance < rhs->m_heuristic_distance;
+}
+
+void ai::OpenList::place(SearchNode* node, int index)
+{
+    m_heap[index] = node;
+    node->m_heap_index = index;
+}
+
+void ai::OpenList::sift_up(int index)
+{
+    SearchNode* node = m_heap[index];
+    while (index > 0)
+    {
+        int const parent = (index - 1) / 2;
+        if (!is_ordered_before(node, m_heap[parent]))
+            break;
+        place(m_heap[parent], index);
+        index = parent;
+    }
+    place(node, index);
+}
+
+void ai::OpenList::sift_down(int index)
+{
+    int const count = size();
+    SearchNode* node = m_heap[index];
+    for (;;)
+    {
+        int child = 2 * index + 1;
+        if (child >= count)
+            break;
+        if (child + 1 < count && is_ordered_before(m_heap[child + 1], m_heap[child]))
+            ++child;
+        if (!is_ordered_before(m_heap[child], node))
+            break;
+        place(m_heap[child], index);
+        index = child;
+    }
+    place(node, index);
+}
@@ -0,0 +1,42 @@
+#pragma once
+#ifndef AI_OPEN_LIST_HPP
+#define AI_OPEN_LIST_HPP
+
+#include <vector>
+
+#include "search_node.hpp"
+
+namespace ai
+{
+
+// Indexed binary min-heap ordered by f score. Each node stores its own
+// position in the heap so that membership tests and decrease-key are
+// O(1) and O(log n) instead of linear scans.
+class OpenList
+{
+private:
+    std::vector<SearchNode*> m_heap;
+
+public:
+    OpenList();
+    ~OpenList() = default;
+
+    OpenList(OpenList const&) = delete;
+    OpenList& operator=(OpenList const&) = delete;
+
+    bool empty() const;
+    int size() const;
+    bool contains(SearchNode const* node) const;
+    void clear();
+    void push(SearchNode* node);
+    void decrease_key(SearchNode* node);
+    SearchNode* pop();
+
+private:
+    bool is_ordered_before(SearchNode const* lhs, SearchNode const* rhs) const;
+    void place(SearchNode* node, int index);
+    void sift_up(int index);
+    void sift_down(int index);
+};
+} // namespace ai
+#endif // AI_OPEN_LIST_HPP
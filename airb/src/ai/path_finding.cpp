@@ -70,8 +70,7 @@ void ai::PathFinding::set_start_and_goal()
     m_start_node->m_heuristic_distance = m_start_node->calculate_heuristic_distance(m_goal_node);
     m_start_node->m_parent = nullptr;
 
-    m_open_list.push_back(m_start_node);
-    make_heap(m_open_list.begin(), m_open_list.end(), CompareFCost());
+    m_open_list.push(m_start_node);
 }
 
 void ai::PathFinding::set_world_size(int world_size)
@@ -81,16 +80,10 @@ void ai::PathFinding::set_world_size(int world_size)
 
 ai::SearchNode* ai::PathFinding::get_next_node()
 {
-    SearchNode* next_node = nullptr;
     //std::cout << ++cycle_counter << std::endl;
-    if (!m_open_list.empty())
-    {
-        next_node = m_open_list.front();
-        //m_visited_list.push_back(next_node);
+    SearchNode* next_node = m_open_list.pop();
+    if (next_node != nullptr)
         next_node->m_visited = true;
-        m_open_list.erase(m_open_list.begin());
-        push_heap(m_open_list.begin(), m_open_list.end(), CompareFCost());
-    }
 
     return next_node;
 }
@@ -208,42 +201,23 @@ void ai::PathFinding::is_path_opened(int x, int y, float new_cost, SearchNode* p
     if (m_nodes[id]->m_visited == true)
         return;
     
-    //SearchNode* new_child = new SearchNode(x, y, m_world_size, parent);
-    SearchNode* new_child = m_nodes[y * m_world_size + x];
-    SearchNode* last_parent = new_child->m_parent;
-    float last_accumulated = new_child->m_accumulated_distance;
-    float last_heuristic = new_child->m_heuristic_distance;
-    new_child->m_parent = parent;
-    new_child->m_accumulated_distance = new_cost;
-    new_child->m_heuristic_distance = parent->calculate_heuristic_distance(m_goal_node);
-
-    for (unsigned int i = 0; i < m_open_list.size(); ++i)
+    SearchNode* new_child = m_nodes[id];
+    if (m_open_list.contains(new_child))
     {
-        if(id == m_open_list[i]->m_id)
-        {
-            float new_f = new_child->m_accumulated_distance 
-                                     + new_cost
-                                     + m_open_list[i]->m_heuristic_distance;
-
-            if (m_open_list[i]->get_f_score() > new_f)
-            {
-                m_open_list[i]->m_accumulated_distance = new_child->m_accumulated_distance 
-                                                                    + new_cost;
-                m_open_list[i]->m_parent = new_child;
+        // Already queued, keep whichever route is cheaper
+        if (new_cost >= new_child->m_accumulated_distance)
+            return;
 
-            }
-            else
-            {
-                //delete new_child;
-                new_child->m_parent = last_parent;
-                new_child->m_accumulated_distance = last_accumulated;
-                new_child->m_heuristic_distance = last_heuristic;
-                return;
-            }
-        }
+        new_child->m_parent = parent;
+        new_child->m_accumulated_distance = new_cost;
+        m_open_list.decrease_key(new_child);
+        return;
     }
-    m_open_list.push_back(new_child);
-    push_heap(m_open_list.begin(), m_open_list.end(), CompareFCost());
+
+    new_child->m_parent = parent;
+    new_child->m_accumulated_distance = new_cost;
+    new_child->m_heuristic_distance = new_child->calculate_heuristic_distance(m_goal_node);
+    m_open_list.push(new_child);
 }
 
 void ai::PathFinding::continue_path()
@@ -276,6 +250,7 @@ void ai::PathFinding::continue_path()
                 m_path_to_goal.push_back(goal_coordinates);
             }
             m_found_goal = true;
+            return;
         }
         else
         {
@@ -311,14 +286,6 @@ void ai::PathFinding::continue_path()
             is_path_opened(current_node->m_x + 1, current_node->m_y - 1,
                            current_node->m_accumulated_distance + 1.4141f,
                            current_node);
-
-            for (unsigned int j = 0; j < m_open_list.size(); ++j)
-            {
-                if (current_node->m_id == m_open_list[j]->m_id)
-                {
-                    m_open_list.erase(m_open_list.begin() + j);
-                }
-            }
         }
     }
 }
@@ -356,63 +323,7 @@ bool ai::PathFinding::get_initialized_start_goal()
 
 bool ai::PathFinding::is_node_blocked(int x, int y)
 {
-    if (x * node_size_int > 6000
-        || x * node_size_int < 0
-        || y * node_size_int > 4000
-        || y * node_size_int < 0)
-        return true;
-    node_center = math::Vector2i({ x * node_size_int + (node_size_int / 2)
-                                 , y * node_size_int + (node_size_int / 2) });
-
-    node_center_left = math::Vector2i({ x * node_size_int
-                                      , y * node_size_int + (node_size_int / 2) });
-
-    node_center_right = math::Vector2i({ x * node_size_int + node_size_int
-                                       , y * node_size_int + (node_size_int / 2) });
-
-    node_center_top = math::Vector2i({ x * node_size_int + (node_size_int / 2)
-                                     , y * node_size_int + node_size_int });
-
-    node_center_bottom = math::Vector2i({ x * node_size_int + (node_size_int / 2)
-                                        , y * node_size_int });
-
-    node_top_left = math::Vector2i({ x * node_size_int
-                                   , y * node_size_int + node_size_int });
-
-    node_top_right = math::Vector2i({ x * node_size_int + node_size_int
-                                    , y * node_size_int + node_size_int });
-
-    node_bottom_left = math::Vector2i({ x * node_size_int
-                                      , y * node_size_int });
-
-    node_bottom_right = math::Vector2i({ x * node_size_int + node_size_int
-                                       , y * node_size_int });
-
-    for (int i = 0; i < 50; ++i)
-    {
-        if (m_terrain.is_pixel_solid(math::Vector2i({ x * node_size_int + i
-                                                    , y * node_size_int + (node_size_int / 2) })))
-            return true;
-    }
-
-    //for (int i = 0; i < 70; ++i)
-    //{
-    //    if (m_terrain.is_pixel_solid(math::Vector2i({ x * node_size_int + i
-    //                                                , y * node_size_int + node_size_int - i})))
-    //        return true;
-    //}
-
-    if (m_terrain.is_pixel_solid(node_center)
-        || m_terrain.is_pixel_solid(node_center_left)
-        || m_terrain.is_pixel_solid(node_center_right)
-        || m_terrain.is_pixel_solid(node_center_top)
-        || m_terrain.is_pixel_solid(node_center_bottom)
-        || m_terrain.is_pixel_solid(node_top_left)
-        || m_terrain.is_pixel_solid(node_top_right)
-        || m_terrain.is_pixel_solid(node_bottom_left)
-        || m_terrain.is_pixel_solid(node_bottom_right))
-        return true;
-    return false;
+    return m_terrain.is_nav_cell_blocked(x, y);
 }
 
 void ai::PathFinding::set_initialized_start_goal(bool init)
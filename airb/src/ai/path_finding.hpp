@@ -13,28 +13,19 @@
 
 #include "../entities/level_terrain.hpp"
 #include "../math/matrix.hpp"
-#include "priority_queue.hpp"
+#include "open_list.hpp"
 #include "search_node.hpp"
 
 namespace ai
 {
 
-struct CompareFCost
-{
-    bool operator()(SearchNode* const lhs, SearchNode* const rhs) const
-    {
-        // return "true" if "rhs" is ordered before "lhs"
-        return lhs->get_f_score() > rhs->get_f_score();
-    }
-};
-
 class PathFinding
 {
 private:
     float radius = 150.0f;
-	float node_size = 50.0f;
+	float node_size = static_cast<float>(entities::LevelTerrain::NAV_CELL_SIZE);
     int cycle_counter = 0;
-    int search_cycles = 10;
+    int search_cycles = 500;
     entities::LevelTerrain &m_terrain;
     bool m_found_goal;
     bool m_initialized_start_goal;
@@ -43,16 +34,7 @@ private:
     int m_world_size;
     int node_size_int = static_cast<int>(node_size);
     int m_path_number;
-    math::Vector2i node_center;
-    math::Vector2i node_center_left;
-    math::Vector2i node_center_right;
-    math::Vector2i node_center_top;
-    math::Vector2i node_center_bottom;
-    math::Vector2i node_top_left;
-    math::Vector2i node_top_right;
-    math::Vector2i node_bottom_left;
-    math::Vector2i node_bottom_right;
-    std::vector<SearchNode*> m_open_list;
+    OpenList m_open_list;
     std::vector<SearchNode*> m_visited_list;
     std::vector<SearchNode*> m_nodes;
     std::vector<SearchNode*> m_neighbours;
@@ -12,13 +12,15 @@ namespace ai
 class SearchNode
 {
 public:
-    SearchNode() : m_parent(nullptr) {}
+    SearchNode() : m_heap_index(-1), m_parent(nullptr) {}
     SearchNode(int x, int y, int world_size, SearchNode* parent = nullptr) 
         : m_x(x), m_y(y)
-        , m_parent(parent), m_accumulated_distance(0)
-        , m_heuristic_distance(0)
         , m_world_size(120)
         , m_already_visited(-1)
+        , m_heap_index(-1)
+        , m_accumulated_distance(0)
+        , m_heuristic_distance(0)
+        , m_parent(parent)
     {
         m_id = m_y * m_world_size + m_x; m_visited = false;
     }
@@ -28,6 +30,7 @@ public:
     int m_id;
     int m_world_size;
     int m_already_visited;
+    int m_heap_index; // Position in the open list, -1 when not queued
     bool m_visited;
     float m_accumulated_distance;
     float m_heuristic_distance;
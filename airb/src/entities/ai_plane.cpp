@@ -1,13 +1,21 @@
 #include "ai_plane.hpp"
 
-#include <GLFW/glfw3.h>
-
-#include "../input/keyboard.hpp"
-#include "../input/mouse.hpp"
-
+#include "../logic/game_world.hpp"
 
 namespace entities
 {
+    namespace
+    {
+        int const WEAPON_SWITCH_DELAY_MIN_MS    = 10000;
+        int const WEAPON_SWITCH_DELAY_SPREAD_MS = 10000;
+        int const SHOOT_DELAY_SPREAD_MS         = 2500;
+
+        std::chrono::milliseconds roll_delay(utilities::Random& random, int const min_ms, int const spread_ms)
+        {
+            return std::chrono::milliseconds(min_ms + random.next_int(spread_ms));
+        }
+    }
+
     AiPlane::AiPlane(float const mass,
                                          float const max_spd, float const max_ang_spd,
                                          std::vector<physics::BoxCollider> const& collider,
@@ -15,38 +23,30 @@ namespace entities
                                          utilities::ResourceHolder<
                                          graphics::Texture, graphics::Textures
                                          >& tex_hld,
-                                         logic::GameplayState* const g_st,
+                                         logic::GameWorld* const g_st,
                                          graphics::Texture& tex,
                                          math::Vector2i const& src_pos, math::Vector2i const& src_dim,
                                          math::Vector2i const& dim,
                                          math::Vector2f const& pos,
                                          entities::LevelTerrain &terrain)
         : Plane(mass, max_spd, max_ang_spd, collider, thrust, yaw, tex_hld, g_st, tex, src_pos, src_dim, dim, pos)
-        , m_terrain(terrain), m_ai(m_rigid_body, terrain)
+        , m_ai(m_rigid_body, terrain, g_st->get_random()), m_terrain(terrain)
+        , m_weapon_switch_timer(std::chrono::milliseconds::zero())
+        , m_weapon_switch_delay(roll_delay(g_st->get_random(), WEAPON_SWITCH_DELAY_MIN_MS, WEAPON_SWITCH_DELAY_SPREAD_MS))
+        , m_shoot_timer(std::chrono::milliseconds::zero())
+        , m_shoot_delay(roll_delay(g_st->get_random(), 0, SHOOT_DELAY_SPREAD_MS))
     {
-        srand(static_cast<unsigned int>(time(NULL)));
-        m_weapon_switch_counter = clock();
-        m_shoot_counter = clock();
         m_ai.change_state(ai::AiStates::ST_PATROL);
     }
 
-    void AiPlane::handle_input(math::Vector2f cursor_pos, input::Keyboard const& kb, input::Mouse const& m,
-                                         math::Vector2f const& m_world_pos,
-                                         std::chrono::milliseconds const dt)
+    void AiPlane::set_goal(math::Vector2f const& goal)
     {
-        static float const DECELERATION = 0.2f;
-        static float const ANGULAR_DAMP = 3.0f;
-
-            if (m.was_button_pressed(GLFW_MOUSE_BUTTON_2))
-            {
-                //std::cout << cursor_pos << std::endl;
-                m_ai.set_goal_reached(false);
-                m_ai.set_found_goal(false);
-                m_ai.set_path_finder_initialization(false);
-                m_ai.set_target_position(m_world_pos[X], m_world_pos[Y]);
-                m_ai.set_path_finder_state(ai::Ai::SEARCHING);
-                m_ai.change_state(ai::AiStates::ST_PATROL);
-            }
+        m_ai.set_goal_reached(false);
+        m_ai.set_found_goal(false);
+        m_ai.set_path_finder_initialization(false);
+        m_ai.set_target_position(goal[X], goal[Y]);
+        m_ai.set_path_finder_state(ai::Ai::SEARCHING);
+        m_ai.change_state(ai::AiStates::ST_PATROL);
     }
 
     void AiPlane::update_behavior(math::Vector2f enemy_position, std::chrono::milliseconds const dt)
@@ -54,10 +54,16 @@ namespace entities
         static float const DECELERATION = 0.2f;
         static float const ANGULAR_DAMP = 3.0f;
 
-        if (clock() - m_weapon_switch_counter > float(rand() % 10000 + 10000) / CLOCKS_PER_SEC * 1000)
+        utilities::Random& random = m_game_state->get_random();
+
+        m_weapon_switch_timer += dt;
+        m_shoot_timer         += dt;
+
+        if (m_weapon_switch_timer > m_weapon_switch_delay)
         {
-            set_weapon(rand() % 3);
-            m_weapon_switch_counter = clock();
+            set_weapon(random.next_int(3));
+            m_weapon_switch_timer = std::chrono::milliseconds::zero();
+            m_weapon_switch_delay = roll_delay(random, WEAPON_SWITCH_DELAY_MIN_MS, WEAPON_SWITCH_DELAY_SPREAD_MS);
         }
 
         auto& curr_weap = m_weapons[m_current_weapon];
@@ -80,10 +86,11 @@ namespace entities
             }
             else
             {
-                if (clock() - m_shoot_counter > float(rand() % 2500) / CLOCKS_PER_SEC * 1000)
+                if (m_shoot_timer > m_shoot_delay)
                 {
                     shoot();
-                    m_shoot_counter = clock();
+                    m_shoot_timer = std::chrono::milliseconds::zero();
+                    m_shoot_delay = roll_delay(random, 0, SHOOT_DELAY_SPREAD_MS);
                 }
             }
         }
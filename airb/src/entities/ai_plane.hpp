@@ -10,14 +10,6 @@
 //#include "../input/keyboard.hpp"
 //#include "../input/mouse.hpp"
 
-namespace input
-{
-
-    class Keyboard;
-    class Mouse;
-
-}
-
 namespace entities
 {
 
@@ -26,15 +18,19 @@ namespace entities
     private:
         ai::Ai m_ai;
         entities::LevelTerrain &m_terrain;
-        clock_t m_weapon_switch_counter;
-        clock_t m_shoot_counter;
+        // Simulation time, so the AI acts the same at any frame rate and
+        // on any machine
+        std::chrono::milliseconds m_weapon_switch_timer;
+        std::chrono::milliseconds m_weapon_switch_delay;
+        std::chrono::milliseconds m_shoot_timer;
+        std::chrono::milliseconds m_shoot_delay;
     public:
         AiPlane(float const mass,
                 float const max_spd, float const max_ang_spd,
                 std::vector<physics::BoxCollider> const& collider,
                 float const thrust, float const yaw,
                 utilities::ResourceHolder<graphics::Texture, graphics::Textures>& tex_hld,
-                logic::GameplayState* const g_st,
+                logic::GameWorld* const g_st,
                 graphics::Texture& tex,
                 math::Vector2i const& src_pos, math::Vector2i const& src_dim,
                 math::Vector2i const& dim,
@@ -53,10 +49,7 @@ namespace entities
         AiPlane(AiPlane const&) = delete;
         AiPlane& operator= (AiPlane const&) = delete;
 
-        //void handle_input(math::Vector2f cursor_pos, input::Keyboard const& kb, input::Mouse const& m,
-        //                  math::Vector2f const& m_world_pos, std::chrono::milliseconds const dt);
-        void handle_input(math::Vector2f cursor_pos, input::Keyboard const& kb, input::Mouse const& m,
-                          math::Vector2f const& m_world_pos, std::chrono::milliseconds const dt);
+        void set_goal(math::Vector2f const& goal);
         void update_behavior(math::Vector2f enemy_position, std::chrono::milliseconds const dt);
         bool get_rotate_direction(float target_angle, float rotation);
         float constrain_angle(float angle);
@@ -1,13 +1,23 @@
 #include "controllable_plane.hpp"
 
+#include <cmath>
+
 #include <GLFW/glfw3.h>
 
 #include "../input/keyboard.hpp"
 #include "../input/mouse.hpp"
-#include "../network/utilities/udp_packet.hpp"
 
 namespace entities {
 
+namespace
+{
+    // Differences the snapshot's quantisation can account for; a server
+    // state this close to the prediction confirms it
+    float const POSITION_TOLERANCE = 0.5f;
+    float const ROTATION_TOLERANCE = 0.025f;
+    float const VELOCITY_TOLERANCE = 1.0f;
+}
+
 ControllablePlane::ControllablePlane(float const mass,
                                      float const max_spd, float const max_ang_spd,
                                      std::vector<physics::BoxCollider> const& collider,
@@ -15,21 +25,21 @@ ControllablePlane::ControllablePlane(float const mass,
                                      utilities::ResourceHolder<
                                          graphics::Texture, graphics::Textures
                                      >& tex_hld,
-                                     logic::GameplayState* const g_st,
+                                     logic::GameWorld* const g_st,
                                      graphics::Texture& tex,
                                      math::Vector2i const& src_pos, math::Vector2i const& src_dim,
                                      math::Vector2i const& dim,
                                      math::Vector2f const& pos)
     : Plane(mass, max_spd, max_ang_spd, collider, thrust, yaw, tex_hld, g_st, tex, src_pos, src_dim, dim, pos)
+    , m_history (HISTORY_SIZE, Step { 0, std::chrono::milliseconds::zero(), m_rigid_body })
+    , m_tick    (0)
+    , m_steering(0)
 { }
 
 void ControllablePlane::handle_input(input::Keyboard const& kb, input::Mouse const& m,
                                      math::Vector2f const& m_world_pos,
                                      std::chrono::milliseconds const dt)
 {
-    static float const DECELERATION = 0.2f;
-    static float const ANGULAR_DAMP = 3.0f;
-
     auto& curr_weap = m_weapons[m_current_weapon];
     math::Vector2f const turret_pos(curr_weap->get_turret_position());
     float const weap_rot = atan2f(m_world_pos[Y] - turret_pos[Y], m_world_pos[X] - turret_pos[X]);
@@ -51,11 +61,82 @@ void ControllablePlane::handle_input(input::Keyboard const& kb, input::Mouse con
         set_weapon(2);
     else if (kb.was_key_pressed(input::KEY_WEAPON_PREVIOUS))
         set_weapon(m_previous_weapon);
-        
 
+    m_steering = 0;
     if (kb.is_key_held(input::KEY_THRUST))
-        m_rigid_body.add_force(m_rigid_body.get_forward() * m_thrust);
+        m_steering |= STEER_THRUST;
     if (kb.is_key_held(input::KEY_DECELERATE))
+        m_steering |= STEER_DECELERATE;
+    if (kb.is_key_held(input::KEY_YAW_LEFT))
+        m_steering |= STEER_LEFT;
+    if (kb.is_key_held(input::KEY_YAW_RIGHT))
+        m_steering |= STEER_RIGHT;
+    steer(m_steering, dt);
+}
+
+void ControllablePlane::update(std::chrono::milliseconds const dt, LevelTerrain& terr)
+{
+    Plane::update(dt, terr);
+
+    Step& s = m_history[m_tick % HISTORY_SIZE];
+    s.steering = m_steering;
+    s.dt       = dt;
+    s.body     = m_rigid_body;
+
+    m_steering = 0;
+    ++m_tick;
+}
+
+bool ControllablePlane::reconcile(long const tick,
+                                  math::Vector2f const& pos, float const rot, math::Vector2f const& vel,
+                                  LevelTerrain& terr)
+{
+    if (tick < 0 || tick >= m_tick || m_tick - tick > HISTORY_SIZE)
+        return false;
+
+    Step& base = m_history[tick % HISTORY_SIZE];
+    auto const& predicted = base.body;
+    if ((predicted.get_position() - pos).magnitude() < POSITION_TOLERANCE &&
+        std::abs(std::remainder(predicted.get_rotation() - rot, math::DOUBLE_PI)) < ROTATION_TOLERANCE &&
+        (predicted.get_velocity() - vel).magnitude() < VELOCITY_TOLERANCE)
+        return true;
+
+    m_rigid_body = base.body;
+    m_rigid_body.set_transform(pos, rot);
+    m_rigid_body.set_velocity(vel);
+    base.body = m_rigid_body;
+
+    // Weapons and the other planes are left alone, only the flight is
+    // replayed
+    for (long t = tick + 1; t < m_tick; ++t)
+    {
+        Step& s = m_history[t % HISTORY_SIZE];
+        steer(s.steering, s.dt);
+        m_rigid_body.add_static_forces();
+        m_rigid_body.update(s.dt, terr);
+        s.body = m_rigid_body;
+    }
+
+    math::Vector2f const& rb_pos = m_rigid_body.get_position();
+    m_sprite.set_position(math::Vector2i(rb_pos));
+    m_sprite.set_rotation(m_rigid_body.get_rotation());
+    m_weapons[m_current_weapon]->set_position(rb_pos);
+    return true;
+}
+
+long ControllablePlane::get_tick() const
+{
+    return m_tick;
+}
+
+void ControllablePlane::steer(std::uint8_t const steering, std::chrono::milliseconds const dt)
+{
+    static float const DECELERATION = 0.2f;
+    static float const ANGULAR_DAMP = 3.0f;
+
+    if (steering & STEER_THRUST)
+        m_rigid_body.add_force(m_rigid_body.get_forward() * m_thrust);
+    if (steering & STEER_DECELERATE)
     {
         float const vel_mag = m_rigid_body.get_velocity().magnitude();
         if (vel_mag != 0.0f)
@@ -65,9 +146,9 @@ void ControllablePlane::handle_input(input::Keyboard const& kb, input::Mouse con
     }
 
     float rot_dir = 0.0f;
-    if (kb.is_key_held(input::KEY_YAW_LEFT))
+    if (steering & STEER_LEFT)
         rot_dir += 1.0f;
-    if (kb.is_key_held(input::KEY_YAW_RIGHT))
+    if (steering & STEER_RIGHT)
         rot_dir -= 1.0f;
     if (rot_dir != 0.0f)
         m_rigid_body.add_torque(rot_dir * m_yaw);
@@ -75,52 +156,4 @@ void ControllablePlane::handle_input(input::Keyboard const& kb, input::Mouse con
         m_rigid_body.damp_angular_velocity(ANGULAR_DAMP, dt);
 }
 
-void ControllablePlane::process_packet(network::UdpPacket packet)
-{
-    if (packet.header_contains(network::UDP_H_POS))
-    {
-        char buffer[network::UDP_MAX_DATABLOCK_SIZE] = { '\0' };
-        auto data = packet.get_data_block();
-        float x, y, rot, velx, vely;
-
-        // x
-        auto byte = 0;
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        x = static_cast<float>(atof(buffer));
-
-        // y
-        byte++;
-        auto e = 0; while (buffer[e] != '\0') buffer[e++] = '\0';
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        y = static_cast<float>(atof(buffer));
-
-        // rot
-        byte++;
-        e = 0; while (buffer[e] != '\0') buffer[e++] = '\0';
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        rot = static_cast<float>(atof(buffer));
-
-        // vel x
-        byte++;
-        e = 0; while (buffer[e] != '\0') buffer[e++] = '\0';
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        velx = static_cast<float>(atof(buffer));
-
-        // vel y
-        byte++;
-        e = 0; while (buffer[e] != '\0') buffer[e++] = '\0';
-        for (auto i = 0; data[byte] != '\0'; i++, byte++)
-            buffer[i] = data[byte];
-        vely = static_cast<float>(atof(buffer));
-
-        m_rigid_body.set_position(math::Vector2f({ x, y }));
-        m_rigid_body.set_rotation(rot);
-        m_rigid_body.set_velocity(math::Vector2f({ velx, vely }));
-    }
-}
-
 } // namespace entities
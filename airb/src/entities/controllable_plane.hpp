@@ -2,6 +2,8 @@
 #define ENTITIES_CONTROLLABLE_PLANE_HPP
 
 #include <chrono>
+#include <cstdint>
+#include <vector>
 
 #include "plane.hpp"
 
@@ -12,23 +14,46 @@ class Mouse;
 
 } // namespace input
 
-namespace network {
-
-class UdpPacket;
-
-} // namespace network
-
 namespace entities {
 
+// The local pilot's plane. Every step is predicted straight from the
+// keyboard, and the steering held and the state reached are kept for the
+// last HISTORY_SIZE steps. When the server's state for one of those steps
+// arrives, the plane rewinds to it and replays the steps taken since instead
+// of jumping back to where the server was a round trip ago.
 class ControllablePlane final : public Plane
 {
+public:
+    // A second of steps at the fixed tick
+    static int const HISTORY_SIZE = 128;
+
+private:
+    enum Steering
+    {
+        STEER_THRUST     = 1,
+        STEER_DECELERATE = 1 << 1,
+        STEER_LEFT       = 1 << 2,
+        STEER_RIGHT      = 1 << 3
+    };
+
+    struct Step
+    {
+        std::uint8_t                   steering;
+        std::chrono::milliseconds      dt;
+        physics::RigidBodyWithCollider body;
+    };
+
+    std::vector<Step> m_history;
+    long              m_tick;
+    std::uint8_t      m_steering;
+
 public:
      ControllablePlane(float const mass,
                        float const max_spd, float const max_ang_spd,
                        std::vector<physics::BoxCollider> const& collider,
                        float const thrust, float const yaw,
                        utilities::ResourceHolder<graphics::Texture, graphics::Textures>& tex_hld,
-                       logic::GameplayState* const g_st,
+                       logic::GameWorld* const g_st,
                        graphics::Texture& tex,
                        math::Vector2i const& src_pos, math::Vector2i const& src_dim,
                        math::Vector2i const& dim,
@@ -41,8 +66,20 @@ public:
     void handle_input(input::Keyboard const& kb, input::Mouse const& m,
                       math::Vector2f const& m_world_pos,
                       std::chrono::milliseconds const dt);
+    void update      (std::chrono::milliseconds const dt, LevelTerrain& terr) override;
+
+    // Takes the server's state as the outcome of the given step and replays
+    // the steps taken since with the steering recorded for them. Returns
+    // false if that step has not been taken yet or is no longer kept.
+    bool reconcile(long const tick,
+                   math::Vector2f const& pos, float const rot, math::Vector2f const& vel,
+                   LevelTerrain& terr);
+
+    // Index of the step the next update takes
+    long get_tick() const;
 
-    void process_packet(network::UdpPacket packet);
+private:
+    void steer(std::uint8_t const steering, std::chrono::milliseconds const dt);
 };
 
 } // namespace entities
@@ -1,101 +1,82 @@
 #include "level_terrain.hpp"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 
-#include "../graphics/render_tools.hpp"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AIRB_HAS_SSE2 1
+#include <emmintrin.h>
+#endif
 
 namespace entities {
 
-LevelTerrain::LevelTerrain(graphics::Texture& tex)
-    : m_texture    (tex)
-    , m_dimensions (math::Vector2i({ tex.get_dimensions()[X],
-                                     tex.get_dimensions()[Y] / 2 }))
-    , m_image_data (tex.get_image().get_image_data())
+LevelTerrain::LevelTerrain(graphics::Image& img, graphics::TextureUploader& uploader)
+    : m_uploader      (uploader)
+    , m_dimensions    (math::Vector2i({ img.get_dimensions()[X],
+                                        img.get_dimensions()[Y] / 2 }))
+    , m_image_data    (img.get_image_data())
+    , m_solidity      (m_dimensions, m_image_data, M_RGBA_SIZE)
+    , m_clearance     (m_solidity)
+    , m_use_clearance (true)
+    , m_occupancy     (m_solidity)
+    , m_dirty_region  (m_dimensions, M_RGBA_SIZE)
+
+    , m_nav_dimensions (math::Vector2i({ m_dimensions[X] / NAV_CELL_SIZE,
+                                         m_dimensions[Y] / NAV_CELL_SIZE }))
+    , m_nav_blocked    ()
 
     , m_update_areas            ()
     , m_circles_to_be_destroyed ()
+    , m_destroyed_circles       ()
+    , m_spans                   ()
 {
     m_update_areas.reserve(256);
     m_circles_to_be_destroyed.reserve(256);
+    m_destroyed_circles.reserve(256);
+    m_spans.reserve(4096);
+
+    build_nav_grid();
 }
 
 void LevelTerrain::update()
 {
-    m_texture.bind();
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, m_dimensions[X]);
-
     for (auto const& p : m_circles_to_be_destroyed)
     {
         math::Vector2i const& center = p.first;
         int const r = p.second;
 
-        int x   = r;
-        int y   = 0;
-        int err = 0;
-
-        int ypy;
-        int ymy;
-        int ypx;
-        int ymx;
-
-        while (x >= y)
-        {
-            ypy = std::min(center[Y] + y, m_dimensions[Y] - 1);
-            ymy = std::max(center[Y] - y, 0);
-            ypx = std::min(center[Y] + x, m_dimensions[Y] - 1);
-            ymx = std::max(center[Y] - x, 0);
-
-            int const start_x1 = std::max(center[X] - x, 0);
-            int const end_x1   = std::min(center[X] + x, m_dimensions[X] - 1);
-
-            for (int i = start_x1; i != end_x1; ++i)
-            {
-                clear_pixel(math::Vector2i({ i, ypy }));
-                clear_pixel(math::Vector2i({ i, ymy }));
-            }
-
-            int const start_x2 = std::max(center[X] - y, 0);
-            int const end_x2   = std::min(center[X] + y, m_dimensions[X] - 1);
-
-            for (int i = start_x2; i != end_x2; ++i)
-            {
-                clear_pixel(math::Vector2i({ i, ypx }));
-                clear_pixel(math::Vector2i({ i, ymx }));
-            }
-
-            err += 1 + 2 * (++y);
-            if (2 * (err - x) + 1 > 0)
-                err += 1 - 2 * (--x);
-        }
+        add_circle_spans(center, r);
 
-        add_update_area(
-            math::Vector2i({ std::max(center[X] - r, 0),
-                             std::max(center[Y] - r, 0) }),
-            math::Vector2i({ std::min(center[X] + r, m_dimensions[X] - 1),
-                             std::min(center[Y] + r, m_dimensions[Y] - 1) })
-        );
+        math::Vector2i const bl({ std::max(center[X] - r, 0),
+                                  std::max(center[Y] - r, 0) });
+        math::Vector2i const tr({ std::min(center[X] + r, m_dimensions[X] - 1),
+                                  std::min(center[Y] + r, m_dimensions[Y] - 1) });
+        add_update_area(bl, tr);
     }
 
-    size_t const num_areas = m_update_areas.size();
-    for (size_t i = 0; i < num_areas; ++i)
-    {
-        auto const& p = m_update_areas[i];
-
-        int const area_w = p.second[X] - p.first[X];
-        int const area_h = p.second[Y] - p.first[Y];
+    clear_spans();
 
-        glTexSubImage2D(
-            GL_TEXTURE_2D, 0,
-            p.first[X], p.first[Y], area_w, area_h,
-            GL_RGBA, GL_UNSIGNED_BYTE,
-            &m_image_data[(p.first[Y] * m_dimensions[X] + p.first[X]) * M_RGBA_SIZE]
-        );
+    // Navigation cells, the distance field and the occupancy pyramid sample
+    // the terrain, so they are refreshed only after every circle of this
+    // frame has been cleared. Navigation cells query the pyramid.
+    for (auto const& p : m_update_areas)
+    {
+        m_occupancy.refresh(p.first, p.second);
+        m_clearance.refresh(p.first, p.second);
+        update_nav_area(p.first, p.second);
     }
 
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-    graphics::RenderTools::unbind_texture();
+    m_dirty_region.flush(m_uploader, m_image_data);
+
     m_update_areas.clear();
+    m_destroyed_circles.swap(m_circles_to_be_destroyed);
     m_circles_to_be_destroyed.clear();
+    m_spans.clear();
 }
 
 void LevelTerrain::destroy_circle(math::Vector2i const& center, int const r)
@@ -110,4 +91,254 @@ void LevelTerrain::destroy_circle(math::Vector2i const& center, int const r)
     m_circles_to_be_destroyed.emplace_back(std::make_pair(center, r));
 }
 
+void LevelTerrain::build_nav_grid()
+{
+    m_nav_blocked.assign(m_nav_dimensions[X] * m_nav_dimensions[Y], false);
+
+    for (int y = 0; y < m_nav_dimensions[Y]; ++y)
+        for (int x = 0; x < m_nav_dimensions[X]; ++x)
+            m_nav_blocked[y * m_nav_dimensions[X] + x] = is_nav_cell_solid(x, y);
+}
+
+void LevelTerrain::update_nav_area(math::Vector2i const& bl, math::Vector2i const& tr)
+{
+    // Cells sample their far edges too, so the cell left of / below the
+    // area may also be affected.
+    int const start_x = std::max(bl[X] / NAV_CELL_SIZE - 1, 0);
+    int const start_y = std::max(bl[Y] / NAV_CELL_SIZE - 1, 0);
+    int const end_x   = std::min(tr[X] / NAV_CELL_SIZE, m_nav_dimensions[X] - 1);
+    int const end_y   = std::min(tr[Y] / NAV_CELL_SIZE, m_nav_dimensions[Y] - 1);
+
+    for (int y = start_y; y <= end_y; ++y)
+        for (int x = start_x; x <= end_x; ++x)
+        {
+            // Terrain can only be destroyed, so free cells stay free.
+            int const i = y * m_nav_dimensions[X] + x;
+            if (m_nav_blocked[i])
+                m_nav_blocked[i] = is_nav_cell_solid(x, y);
+        }
+}
+
+void LevelTerrain::add_circle_spans(math::Vector2i const& center, int const r)
+{
+    // Midpoint circle, emitted as one span per octant pair instead of
+    // per-pixel writes. Rows visited more than once are merged later.
+    int x   = r;
+    int y   = 0;
+    int err = 0;
+
+    while (x >= y)
+    {
+        add_span(center[Y] + y, center[X] - x, center[X] + x);
+        add_span(center[Y] - y, center[X] - x, center[X] + x);
+        add_span(center[Y] + x, center[X] - y, center[X] + y);
+        add_span(center[Y] - x, center[X] - y, center[X] + y);
+
+        err += 1 + 2 * (++y);
+        if (2 * (err - x) + 1 > 0)
+            err += 1 - 2 * (--x);
+    }
+}
+
+void LevelTerrain::add_span(int const y, int const start_x, int const end_x)
+{
+    if (y < 0 || y >= m_dimensions[Y])
+        return;
+
+    int const start = std::max(start_x, 0);
+    int const end   = std::min(end_x, m_dimensions[X]);
+    if (start < end)
+        m_spans.push_back({ y, start, end });
+}
+
+void LevelTerrain::clear_spans()
+{
+    if (m_spans.empty())
+        return;
+
+    std::sort(m_spans.begin(), m_spans.end(), [](Span const& a, Span const& b)
+    {
+        return a.y != b.y ? a.y < b.y : a.start_x < b.start_x;
+    });
+
+    // Coalesce overlapping spans on the same row so that circles queued in
+    // the same frame never write a pixel twice.
+    auto const clear = [this](Span const& s)
+    {
+        size_t const offset = (static_cast<size_t>(s.y) * m_dimensions[X] + s.start_x) * M_RGBA_SIZE;
+        clear_alpha_span(&m_image_data[offset], s.end_x - s.start_x);
+        m_solidity.clear_span(s.y, s.start_x, s.end_x);
+    };
+
+    Span current = m_spans.front();
+    for (size_t i = 1; i < m_spans.size(); ++i)
+    {
+        Span const& s = m_spans[i];
+        if (s.y == current.y && s.start_x <= current.end_x)
+        {
+            current.end_x = std::max(current.end_x, s.end_x);
+            continue;
+        }
+        clear(current);
+        current = s;
+    }
+    clear(current);
+}
+
+void LevelTerrain::clear_alpha_span(GLubyte* rgba, int const count)
+{
+    static_assert(M_RGBA_SIZE == 4, "SIMD paths assume 32-bit RGBA pixels");
+
+    // Alpha is the high byte of each little-endian pixel, so masking every
+    // 32-bit lane with 0x00ffffff clears it and leaves RGB untouched.
+    int i = 0;
+#if defined(__AVX2__)
+    __m256i const keep_rgb8 = _mm256_set1_epi32(0x00ffffff);
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256i* const p = reinterpret_cast<__m256i*>(&rgba[i * M_RGBA_SIZE]);
+        _mm256_storeu_si256(p, _mm256_and_si256(_mm256_loadu_si256(p), keep_rgb8));
+    }
+#endif
+#if defined(AIRB_HAS_SSE2)
+    __m128i const keep_rgb4 = _mm_set1_epi32(0x00ffffff);
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i* const p = reinterpret_cast<__m128i*>(&rgba[i * M_RGBA_SIZE]);
+        _mm_storeu_si128(p, _mm_and_si128(_mm_loadu_si128(p), keep_rgb4));
+    }
+#endif
+    clear_alpha_span_scalar(&rgba[i * M_RGBA_SIZE], count - i);
+}
+
+void LevelTerrain::clear_alpha_span_scalar(GLubyte* rgba, int const count)
+{
+    for (int i = 0; i < count; ++i)
+        rgba[i * M_RGBA_SIZE + (M_RGBA_SIZE - 1)] = 0;
+}
+
+LevelTerrain::RayResult LevelTerrain::raycast(math::Vector2f const& from, math::Vector2f const& to,
+                                              math::Vector2i& hit) const
+{
+    int x = static_cast<int>(std::floor(from[X]));
+    int y = static_cast<int>(std::floor(from[Y]));
+    if (!is_pixel_inside_terrain_bounds(math::Vector2i({ x, y })))
+        return RAY_OUTSIDE;
+
+    // Rays in open air are cleared by the distance field without a walk
+    math::Vector2f const d = to - from;
+    if (is_disc_empty(from + d * 0.5f, d.magnitude() * 0.5f))
+        return RAY_CLEAR;
+
+    int const end_x = static_cast<int>(std::floor(to[X]));
+    int const end_y = static_cast<int>(std::floor(to[Y]));
+    int const step_x = end_x > x ? 1 : -1;
+    int const step_y = end_y > y ? 1 : -1;
+
+    // Amanatides-Woo: t_max is the ray parameter at which the next pixel
+    // boundary on an axis is crossed and t_delta the distance between two
+    // such boundaries, both in units of the whole segment.
+    float const inf = std::numeric_limits<float>::infinity();
+    float const dx  = d[X];
+    float const dy  = d[Y];
+    float const t_delta_x = dx != 0.0f ? 1.0f / std::abs(dx) : inf;
+    float const t_delta_y = dy != 0.0f ? 1.0f / std::abs(dy) : inf;
+    float t_max_x = dx > 0.0f ? (static_cast<float>(x + 1) - from[X]) * t_delta_x
+                  : dx < 0.0f ? (from[X] - static_cast<float>(x)) * t_delta_x
+                  : inf;
+    float t_max_y = dy > 0.0f ? (static_cast<float>(y + 1) - from[Y]) * t_delta_y
+                  : dy < 0.0f ? (from[Y] - static_cast<float>(y)) * t_delta_y
+                  : inf;
+
+    // The tile word is only fetched when the walk enters a new tile, so
+    // runs through empty tiles cost no lookups.
+    int tile_x = x >> TerrainMask::TILE_SHIFT;
+    int tile_y = y >> TerrainMask::TILE_SHIFT;
+    std::uint64_t bits = m_solidity.get_tile_bits(tile_x, tile_y);
+
+    // Exactly one step per pixel boundary between the end cells. Once an
+    // axis has reached its end cell it takes no more steps, which keeps
+    // rounding in t_max from walking past the end.
+    for (int n = std::abs(end_x - x) + std::abs(end_y - y); ; --n)
+    {
+        int const bit = ((y & TerrainMask::TILE_MASK) << TerrainMask::TILE_SHIFT) | (x & TerrainMask::TILE_MASK);
+        if ((bits >> bit & 1) != 0)
+        {
+            hit = math::Vector2i({ x, y });
+            return RAY_SOLID;
+        }
+        if (n == 0)
+            return RAY_CLEAR;
+
+        if (y == end_y || (x != end_x && t_max_x < t_max_y))
+        {
+            x += step_x;
+            t_max_x += t_delta_x;
+        }
+        else
+        {
+            y += step_y;
+            t_max_y += t_delta_y;
+        }
+
+        if (!is_pixel_inside_terrain_bounds(math::Vector2i({ x, y })))
+            return RAY_OUTSIDE;
+
+        if (x >> TerrainMask::TILE_SHIFT != tile_x || y >> TerrainMask::TILE_SHIFT != tile_y)
+        {
+            tile_x = x >> TerrainMask::TILE_SHIFT;
+            tile_y = y >> TerrainMask::TILE_SHIFT;
+            bits = m_solidity.get_tile_bits(tile_x, tile_y);
+        }
+    }
+}
+
+void LevelTerrain::raycast(int const count, float const* from_x, float const* from_y,
+                           float* to_x, float* to_y, unsigned char* results) const
+{
+    math::Vector2i hit;
+    for (int i = 0; i < count; ++i)
+    {
+        RayResult const r = raycast(math::Vector2f({ from_x[i], from_y[i] }),
+                                    math::Vector2f({ to_x[i], to_y[i] }), hit);
+        if (r == RAY_SOLID)
+        {
+            to_x[i] = static_cast<float>(hit[X]);
+            to_y[i] = static_cast<float>(hit[Y]);
+        }
+        results[i] = r;
+    }
+}
+
+bool LevelTerrain::is_nav_cell_solid(int const x, int const y) const
+{
+    static int const HALF_CELL = NAV_CELL_SIZE / 2;
+
+    auto const sample = [this](int const px, int const py)
+    {
+        return is_pixel_solid(math::Vector2i({ std::min(px, m_dimensions[X] - 1),
+                                               std::min(py, m_dimensions[Y] - 1) }));
+    };
+
+    int const left   = x * NAV_CELL_SIZE;
+    int const bottom = y * NAV_CELL_SIZE;
+
+    if (is_rect_empty(math::Vector2i({ left, bottom }),
+                      math::Vector2i({ left + NAV_CELL_SIZE, bottom + NAV_CELL_SIZE })))
+        return false;
+
+    // Horizontal scan through the middle of the cell
+    for (int i = 0; i < NAV_CELL_SIZE; ++i)
+        if (sample(left + i, bottom + HALF_CELL))
+            return true;
+
+    // Corners, edge midpoints and center
+    for (int j = 0; j <= NAV_CELL_SIZE; j += HALF_CELL)
+        for (int i = 0; i <= NAV_CELL_SIZE; i += HALF_CELL)
+            if (sample(left + i, bottom + j))
+                return true;
+
+    return false;
+}
+
 } // namespace entities
@@ -8,25 +8,58 @@
 
 #include <glew.h>
 
-#include "../graphics/texture.hpp"
+#include "terrain_distance_field.hpp"
+#include "terrain_mask.hpp"
+#include "terrain_occupancy.hpp"
+#include "../graphics/dirty_region.hpp"
+#include "../graphics/image.hpp"
+#include "../graphics/texture_uploader.hpp"
 #include "../math/matrix.hpp"
 
 namespace entities {
 
 class LevelTerrain final
 {
+public:
+    static int const NAV_CELL_SIZE = 50;
+
+    enum RayResult : unsigned char
+    {
+        RAY_CLEAR,   // Reached its end without touching solid terrain
+        RAY_SOLID,   // Stopped at the first solid pixel on its way
+        RAY_OUTSIDE  // Left the terrain before touching anything solid
+    };
+
 private:
     static int const M_RGBA_SIZE = 4;
 
-    graphics::Texture& m_texture;
-    math::Vector2i     m_dimensions;
-    GLubyte*           m_image_data;
+    // Horizontal run of pixels [start_x, end_x) on row y
+    struct Span
+    {
+        int y;
+        int start_x;
+        int end_x;
+    };
+
+    graphics::TextureUploader& m_uploader;
+    math::Vector2i             m_dimensions;
+    GLubyte*                   m_image_data;
+    TerrainMask                m_solidity;
+    TerrainDistanceField       m_clearance;
+    bool                       m_use_clearance;
+    TerrainOccupancy           m_occupancy;
+    graphics::DirtyRegion      m_dirty_region;
+
+    math::Vector2i     m_nav_dimensions;
+    std::vector<bool>  m_nav_blocked;
 
     std::vector<std::pair<math::Vector2i, math::Vector2i>> m_update_areas;
     std::vector<std::pair<math::Vector2i, int>>            m_circles_to_be_destroyed;
+    std::vector<std::pair<math::Vector2i, int>>            m_destroyed_circles;
+    std::vector<Span>                                      m_spans;
 
 public:
-    explicit  LevelTerrain(graphics::Texture& tex);
+     LevelTerrain(graphics::Image& img, graphics::TextureUploader& uploader);
              ~LevelTerrain() = default;
 
     LevelTerrain            (LevelTerrain const&) = delete;
@@ -35,14 +68,60 @@ public:
     void update         ();
     void destroy_circle (math::Vector2i const& center, int const r);
 
+    inline math::Vector2i const& get_dimensions      () const;
+    inline bool                  is_nav_cell_blocked (int const x, int const y) const;
+    inline math::Vector2i const& get_nav_dimensions  () const;
+
+    inline graphics::DirtyRegion const& get_dirty_region() const;
+
+    // Circles cleared by the last update(), in the order they were added
+    inline std::vector<std::pair<math::Vector2i, int>> const& get_destroyed_circles() const;
+
+    // Zero the alpha of count consecutive RGBA pixels and leave RGB alone.
+    // The scalar version is the reference the SIMD paths are tested against.
+    static void clear_alpha_span        (GLubyte* rgba, int const count);
+    static void clear_alpha_span_scalar (GLubyte* rgba, int const count);
+
 private:
-    inline void add_update_area (math::Vector2i const& bl, math::Vector2i const& tr);
-    inline void clear_pixel     (math::Vector2i const& px);
+    void build_nav_grid    ();
+    void update_nav_area   (math::Vector2i const& bl, math::Vector2i const& tr);
+    bool is_nav_cell_solid (int const x, int const y) const;
 
-    inline unsigned get_pixel_alpha_index(math::Vector2i const& px) const;
+    void add_circle_spans (math::Vector2i const& center, int const r);
+    void add_span         (int const y, int const start_x, int const end_x);
+    void clear_spans      ();
+
+    inline void add_update_area (math::Vector2i const& bl, math::Vector2i const& tr);
 
 public:
+    // Pixels outside the terrain count as solid, like the level border
     inline bool is_pixel_solid                 (math::Vector2i const& px) const;
+
+    // True when no pixel within r of center is solid or outside the
+    // terrain. A false answer only means the area has to be sampled.
+    inline bool is_disc_empty                  (math::Vector2f const& center, float const r) const;
+
+    // With the distance field off is_disc_empty always answers false, so
+    // collision checks sample everything and only get slower. For benches.
+    inline void set_use_clearance              (bool const use);
+
+    // Pixel rectangles with inclusive corners, clamped to the terrain
+    inline bool is_rect_empty                  (math::Vector2i const& bl, math::Vector2i const& tr) const;
+    inline bool is_rect_solid                  (math::Vector2i const& bl, math::Vector2i const& tr) const;
+
+    // True when the segment crosses no solid pixel and stays inside the
+    // terrain
+    inline bool is_segment_empty               (math::Vector2f const& a, math::Vector2f const& b) const;
+
+    // Visits every pixel the segment crosses, in order from its start, and
+    // reports the first solid one in hit.
+    RayResult raycast(math::Vector2f const& from, math::Vector2f const& to, math::Vector2i& hit) const;
+
+    // Traces count rays given as parallel arrays of end points, writing a
+    // RayResult per ray. Rays stopped by the terrain have their end moved
+    // to the solid pixel they hit.
+    void raycast(int const count, float const* from_x, float const* from_y,
+                 float* to_x, float* to_y, unsigned char* results) const;
 private:
     inline bool is_pixel_inside_terrain_bounds (math::Vector2i const& px) const;
 };
@@ -3,21 +3,67 @@ namespace entities {
 inline void LevelTerrain::add_update_area(math::Vector2i const& bl, math::Vector2i const& tr)
 {
     m_update_areas.emplace_back(std::make_pair(bl, tr));
+    m_dirty_region.mark(bl, tr);
 }
 
-inline void LevelTerrain::clear_pixel(math::Vector2i const& px)
+inline bool LevelTerrain::is_pixel_solid(math::Vector2i const& px) const
 {
-    m_image_data[get_pixel_alpha_index(px)] = 0;
+    // Collision walks follow collider edges wherever they reach, and the
+    // mask has no tiles to read outside the level
+    return !is_pixel_inside_terrain_bounds(px) || m_solidity.is_solid(px[X], px[Y]);
 }
 
-inline unsigned LevelTerrain::get_pixel_alpha_index(math::Vector2i const& px) const
+inline bool LevelTerrain::is_disc_empty(math::Vector2f const& center, float const r) const
 {
-    return (px[Y] * m_dimensions[X] + px[X]) * M_RGBA_SIZE + (M_RGBA_SIZE - 1);
+    // One pixel of slack for rounding in the sample points of callers
+    return m_use_clearance && r + 1.0f < m_clearance.get_clearance(center);
 }
 
-inline bool LevelTerrain::is_pixel_solid(math::Vector2i const& px) const
+inline void LevelTerrain::set_use_clearance(bool const use)
+{
+    m_use_clearance = use;
+}
+
+inline bool LevelTerrain::is_rect_empty(math::Vector2i const& bl, math::Vector2i const& tr) const
+{
+    return m_occupancy.is_rect_empty(bl, tr);
+}
+
+inline bool LevelTerrain::is_rect_solid(math::Vector2i const& bl, math::Vector2i const& tr) const
+{
+    return m_occupancy.is_rect_solid(bl, tr);
+}
+
+inline bool LevelTerrain::is_segment_empty(math::Vector2f const& a, math::Vector2f const& b) const
+{
+    return m_occupancy.is_segment_empty(a, b);
+}
+
+inline math::Vector2i const& LevelTerrain::get_dimensions() const
+{
+    return m_dimensions;
+}
+
+inline bool LevelTerrain::is_nav_cell_blocked(int const x, int const y) const
+{
+    if (x < 0 || x >= m_nav_dimensions[X] || y < 0 || y >= m_nav_dimensions[Y])
+        return true;
+    return m_nav_blocked[y * m_nav_dimensions[X] + x];
+}
+
+inline math::Vector2i const& LevelTerrain::get_nav_dimensions() const
+{
+    return m_nav_dimensions;
+}
+
+inline graphics::DirtyRegion const& LevelTerrain::get_dirty_region() const
+{
+    return m_dirty_region;
+}
+
+inline std::vector<std::pair<math::Vector2i, int>> const& LevelTerrain::get_destroyed_circles() const
 {
-    return m_image_data[get_pixel_alpha_index(px)] != 0;
+    return m_destroyed_circles;
 }
 
 inline bool LevelTerrain::is_pixel_inside_terrain_bounds(math::Vector2i const& px) const
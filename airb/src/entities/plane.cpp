@@ -12,7 +12,7 @@ Plane::Plane(float const mass,
              std::vector<physics::BoxCollider> const& collider,
              float const thrust, float const yaw,
              utilities::ResourceHolder<graphics::Texture, graphics::Textures>& tex_hld,
-             logic::GameplayState* const g_st,
+             logic::GameWorld* const g_st,
              graphics::Texture& tex,
              math::Vector2i const& src_pos, math::Vector2i const& src_dim,
              math::Vector2i const& dim,
@@ -23,6 +23,9 @@ Plane::Plane(float const mass,
     , m_yaw        (yaw)
     , m_sprite     (tex, src_pos, src_dim, math::Vector2i(pos), dim, math::Vector2f::one() * 0.5f)
 
+    , m_previous_position (pos)
+    , m_previous_rotation (0.0f)
+
     , m_current_weapon  (0)
     , m_previous_weapon (0)
 
@@ -52,6 +55,9 @@ Plane::Plane(float const mass,
 
 void Plane::update(std::chrono::milliseconds const dt, LevelTerrain& terr)
 {
+    m_previous_position = m_rigid_body.get_position();
+    m_previous_rotation = m_rigid_body.get_rotation();
+
     m_rigid_body.add_static_forces();
     m_rigid_body.update(dt, terr);
     auto& weap = m_weapons[m_current_weapon];
@@ -63,6 +69,14 @@ void Plane::update(std::chrono::milliseconds const dt, LevelTerrain& terr)
     weap->set_position(rb_pos);
 }
 
+void Plane::interpolate(float const alpha)
+{
+    math::Vector2f const pos = get_interpolated_position(alpha);
+    m_sprite.set_position(math::Vector2i(pos));
+    m_sprite.set_rotation(math::lerp_angle(m_previous_rotation, m_rigid_body.get_rotation(), alpha));
+    m_weapons[m_current_weapon]->set_position(pos);
+}
+
 void Plane::set_weapon(int const idx)
 {
     assert(idx >= 0);
@@ -9,13 +9,14 @@
 #include "weapon.hpp"
 #include "../graphics/sprite.hpp"
 #include "../graphics/texture.hpp"
+#include "../math/general.hpp"
 #include "../math/matrix.hpp"
 #include "../physics/rigid_body_with_collider.hpp"
 #include "../utilities/resource_holder.hpp"
 
 namespace logic {
 
-class GameplayState;
+class GameWorld;
 
 } // namespace logic
 
@@ -26,12 +27,16 @@ class Plane
 protected:
     static int const NUM_WEAPONS = 3;
 
-    logic::GameplayState* m_game_state;
+    logic::GameWorld* m_game_state;
     physics::RigidBodyWithCollider    m_rigid_body;
     float                 m_thrust;
     float                 m_yaw;
     graphics::Sprite      m_sprite;
 
+    // Rigid body state at the start of the last update, for interpolation
+    math::Vector2f        m_previous_position;
+    float                 m_previous_rotation;
+
     int m_current_weapon;
     int m_previous_weapon;
 
@@ -45,7 +50,7 @@ public:
                    std::vector<physics::BoxCollider> const& collider,
                    float const thrust, float const yaw,
                    utilities::ResourceHolder<graphics::Texture, graphics::Textures>& tex_hld,
-                   logic::GameplayState* const g_st,
+                   logic::GameWorld* const g_st,
                    graphics::Texture& tex,
                    math::Vector2i const& src_pos, math::Vector2i const& src_dim,
                    math::Vector2i const& dim,
@@ -60,8 +65,11 @@ public:
 
     virtual void update(std::chrono::milliseconds const dt, LevelTerrain& terr);
 
+    void interpolate(float const alpha);
+
     inline bool                     is_reloading      () const;
     inline physics::RigidBodyWithCollider&      get_rigid_body    ();
+    inline physics::RigidBodyWithCollider const& get_rigid_body   () const;
     inline graphics::Sprite&        get_weapon_sprite ();
     inline graphics::Sprite&        get_sprite        ();
     inline Weapon&                  get_weapon        ();
@@ -69,7 +77,11 @@ public:
     inline int                      get_ammo          () const;
     inline ConsumableResource<int>& get_health        ();
 
-    inline void set_game_state      (logic::GameplayState* game_state);
+    inline math::Vector2f get_interpolated_position(float const alpha) const;
+
+    inline void set_game_state      (logic::GameWorld* game_state);
+    inline void set_state           (math::Vector2f const& pos, float const rot,
+                                     math::Vector2f const& vel);
     inline void set_weapon_rotation (float const rot);
     inline void take_damage         (int const damage);
     inline void reload_weapon       ();
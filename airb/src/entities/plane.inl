@@ -10,6 +10,11 @@ inline physics::RigidBodyWithCollider& Plane::get_rigid_body()
     return m_rigid_body;
 }
 
+inline physics::RigidBodyWithCollider const& Plane::get_rigid_body() const
+{
+    return m_rigid_body;
+}
+
 inline graphics::Sprite& Plane::get_weapon_sprite()
 {
     return m_weapons[m_current_weapon]->get_sprite();
@@ -40,11 +45,23 @@ inline ConsumableResource<int>& Plane::get_health()
     return m_health;
 }
 
-inline void Plane::set_game_state(logic::GameplayState* game_state)
+inline math::Vector2f Plane::get_interpolated_position(float const alpha) const
+{
+    return math::lerp(m_previous_position, m_rigid_body.get_position(), alpha);
+}
+
+inline void Plane::set_game_state(logic::GameWorld* game_state)
 {
     m_game_state = game_state;
 }
 
+inline void Plane::set_state(math::Vector2f const& pos, float const rot,
+                             math::Vector2f const& vel)
+{
+    m_rigid_body.set_transform(pos, rot);
+    m_rigid_body.set_velocity(vel);
+}
+
 inline void Plane::reload_weapon()
 {
     m_weapons[m_current_weapon]->start_reloading();
@@ -0,0 +1,265 @@
+#include "projectile_system.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+#include "level_terrain.hpp"
+#include "../logic/game_world.hpp"
+#include "../utilities/job_system.hpp"
+
+namespace entities {
+
+int   const ProjectileSystem::EXPLOSION_RADII[] = { 50, 30, 20 };
+float const ProjectileSystem::GRAVITY[]         = { 500.0f, 0.0f, 0.0f };
+float const ProjectileSystem::MAX_SPEED[]       = { 2000.0f,
+                                                    std::numeric_limits<float>::max(),
+                                                    std::numeric_limits<float>::max() };
+
+namespace
+{
+    template<typename T>
+    void swap_remove(std::vector<T>& v, int const i)
+    {
+        v[i] = v.back();
+        v.pop_back();
+    }
+
+    template<typename T>
+    void reserve_all(std::vector<T>& v)
+    {
+        v.reserve(ProjectileSystem::INITIAL_CAPACITY);
+    }
+}
+
+ProjectileSystem::ProjectileSystem(logic::GameWorld& world, utilities::JobSystem& jobs)
+    : m_game_world (world)
+    , m_jobs       (jobs)
+
+    , m_position_x  ()
+    , m_position_y  ()
+    , m_previous_x  ()
+    , m_previous_y  ()
+    , m_velocity_x  ()
+    , m_velocity_y  ()
+    , m_gravity     ()
+    , m_max_speed   ()
+    , m_elapsed_ms  ()
+    , m_lifetime_ms ()
+    , m_type        ()
+    , m_damage      ()
+
+    , m_target_x   ()
+    , m_target_y   ()
+    , m_fate       ()
+    , m_ray_result ()
+{
+    reserve_all(m_position_x);
+    reserve_all(m_position_y);
+    reserve_all(m_previous_x);
+    reserve_all(m_previous_y);
+    reserve_all(m_velocity_x);
+    reserve_all(m_velocity_y);
+    reserve_all(m_gravity);
+    reserve_all(m_max_speed);
+    reserve_all(m_elapsed_ms);
+    reserve_all(m_lifetime_ms);
+    reserve_all(m_type);
+    reserve_all(m_damage);
+    reserve_all(m_target_x);
+    reserve_all(m_target_y);
+    reserve_all(m_fate);
+    reserve_all(m_ray_result);
+}
+
+void ProjectileSystem::spawn(math::Vector2f const& pos, math::Vector2f const& vel,
+                             std::chrono::milliseconds const lifetime, int const type, int const dmg)
+{
+    assert(type >= 0 && type < NUM_TYPES);
+
+    m_position_x  .push_back(pos[X]);
+    m_position_y  .push_back(pos[Y]);
+    m_previous_x  .push_back(pos[X]);
+    m_previous_y  .push_back(pos[Y]);
+    m_velocity_x  .push_back(vel[X]);
+    m_velocity_y  .push_back(vel[Y]);
+    m_gravity     .push_back(GRAVITY[type]);
+    m_max_speed   .push_back(MAX_SPEED[type]);
+    m_elapsed_ms  .push_back(0);
+    m_lifetime_ms .push_back(static_cast<int>(lifetime.count()));
+    m_type        .push_back(type);
+    m_damage      .push_back(dmg);
+}
+
+void ProjectileSystem::update(std::chrono::milliseconds const dt, LevelTerrain& terr)
+{
+    int const n = size();
+    if (n == 0)
+        return;
+
+    m_target_x.resize(n);
+    m_target_y.resize(n);
+    m_fate.assign(n, FATE_ALIVE);
+    m_ray_result.resize(n);
+
+    int   const dt_ms = static_cast<int>(dt.count());
+    float const sec   = static_cast<float>(dt.count()) * 0.001f;
+    LevelTerrain const& cterr = terr;
+
+    // Terrain is only read here; its damage is queued by apply_fates
+    m_jobs.parallel_for(n, JOB_GRAIN, [this, dt_ms, sec, &cterr](int const begin, int const end)
+    {
+        expire(begin, end, dt_ms);
+        integrate(begin, end, sec);
+        trace_terrain(begin, end, cterr);
+    });
+
+    apply_fates(terr);
+    remove_dead();
+}
+
+void ProjectileSystem::clear()
+{
+    m_position_x  .clear();
+    m_position_y  .clear();
+    m_previous_x  .clear();
+    m_previous_y  .clear();
+    m_velocity_x  .clear();
+    m_velocity_y  .clear();
+    m_gravity     .clear();
+    m_max_speed   .clear();
+    m_elapsed_ms  .clear();
+    m_lifetime_ms .clear();
+    m_type        .clear();
+    m_damage      .clear();
+}
+
+void ProjectileSystem::hit(int const i, math::Vector2f const& mtv, bool const show_explosion)
+{
+    m_position_x[i] += mtv[X];
+    m_position_y[i] += mtv[Y];
+    if (show_explosion)
+        m_game_world.add_explosion(get_position(i), m_type[i]);
+    remove(i);
+}
+
+void ProjectileSystem::remove(int const i)
+{
+    swap_remove(m_position_x,  i);
+    swap_remove(m_position_y,  i);
+    swap_remove(m_previous_x,  i);
+    swap_remove(m_previous_y,  i);
+    swap_remove(m_velocity_x,  i);
+    swap_remove(m_velocity_y,  i);
+    swap_remove(m_gravity,     i);
+    swap_remove(m_max_speed,   i);
+    swap_remove(m_elapsed_ms,  i);
+    swap_remove(m_lifetime_ms, i);
+    swap_remove(m_type,        i);
+    swap_remove(m_damage,      i);
+}
+
+void ProjectileSystem::expire(int const begin, int const end, int const dt_ms)
+{
+    for (int i = begin; i < end; ++i)
+        m_elapsed_ms[i] += dt_ms;
+
+    for (int i = begin; i < end; ++i)
+        if (m_elapsed_ms[i] >= m_lifetime_ms[i])
+            m_fate[i] = FATE_EXPIRED;
+}
+
+void ProjectileSystem::integrate(int const begin, int const end, float const sec)
+{
+    float*       px = m_position_x.data();
+    float*       py = m_position_y.data();
+    float*       ox = m_previous_x.data();
+    float*       oy = m_previous_y.data();
+    float*       vx = m_velocity_x.data();
+    float*       vy = m_velocity_y.data();
+    float const* g  = m_gravity.data();
+    float const* ms = m_max_speed.data();
+    float*       tx = m_target_x.data();
+    float*       ty = m_target_y.data();
+
+    // Straight-line branch-free loop; gravity and the speed limit are per
+    // projectile values instead of per-type code paths.
+    for (int i = begin; i < end; ++i)
+    {
+        ox[i] = px[i];
+        oy[i] = py[i];
+
+        float const nvx   = vx[i];
+        float const nvy   = vy[i] - g[i] * sec;
+        float const spd   = std::sqrt(nvx * nvx + nvy * nvy);
+        float const scale = spd > ms[i] ? ms[i] / spd : 1.0f;
+
+        vx[i] = nvx * scale;
+        vy[i] = nvy * scale;
+        tx[i] = px[i] + vx[i] * sec;
+        ty[i] = py[i] + vy[i] * sec;
+    }
+}
+
+void ProjectileSystem::trace_terrain(int const begin, int const end, LevelTerrain const& terr)
+{
+    // Every pixel of the step is visited, so fast projectiles cannot pass
+    // through terrain thinner than their step. Expired projectiles are
+    // traced too and their result ignored; they are few.
+    terr.raycast(end - begin, &m_position_x[begin], &m_position_y[begin],
+                 &m_target_x[begin], &m_target_y[begin], &m_ray_result[begin]);
+
+    for (int i = begin; i < end; ++i)
+    {
+        if (m_fate[i] != FATE_ALIVE)
+            continue;
+
+        if (m_ray_result[i] == LevelTerrain::RAY_SOLID)
+            m_fate[i] = FATE_IMPACT;
+        else if (m_ray_result[i] == LevelTerrain::RAY_OUTSIDE)
+            m_fate[i] = FATE_VANISHED;
+        else
+        {
+            m_position_x[i] = m_target_x[i];
+            m_position_y[i] = m_target_y[i];
+        }
+    }
+}
+
+void ProjectileSystem::apply_fates(LevelTerrain& terr)
+{
+    int const n = size();
+
+    // Expiries first, then impacts, each in index order, so the explosion
+    // and terrain queues come out the same for any number of threads
+    for (int i = 0; i < n; ++i)
+    {
+        if (m_fate[i] != FATE_EXPIRED)
+            continue;
+
+        math::Vector2f const pos = get_position(i);
+        m_game_world.add_explosion(pos, m_type[i]);
+        terr.destroy_circle(math::Vector2i(pos), EXPLOSION_RADII[m_type[i]]);
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (m_fate[i] != FATE_IMPACT)
+            continue;
+
+        math::Vector2i const px({ static_cast<int>(m_target_x[i]), static_cast<int>(m_target_y[i]) });
+        terr.destroy_circle(px, EXPLOSION_RADII[m_type[i]]);
+        m_game_world.add_explosion(math::Vector2f(px), m_type[i]);
+    }
+}
+
+void ProjectileSystem::remove_dead()
+{
+    // Backwards, so every projectile swapped into a hole has already been
+    // looked at.
+    for (int i = size() - 1; i >= 0; --i)
+        if (m_fate[i] != FATE_ALIVE)
+            remove(i);
+}
+
+} // namespace entities
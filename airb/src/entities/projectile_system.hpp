@@ -0,0 +1,115 @@
+#ifndef ENTITIES_PROJECTILE_SYSTEM_HPP
+#define ENTITIES_PROJECTILE_SYSTEM_HPP
+
+#include <chrono>
+#include <vector>
+
+#include "../math/general.hpp"
+#include "../math/matrix.hpp"
+
+namespace logic {
+
+class GameWorld;
+
+} // namespace logic
+
+namespace utilities {
+
+class JobSystem;
+
+} // namespace utilities
+
+namespace entities {
+
+class LevelTerrain;
+
+// All live projectiles of a match, stored as parallel arrays. Live
+// projectiles are packed at the front, so spawning appends and removal
+// swaps the last projectile into the hole; both are O(1) and the arrays
+// grow as needed. Projectiles are stepped in parallel ranges on the job
+// system; what each one ran into is recorded and the explosions and
+// terrain damage are applied afterwards on the calling thread, in index
+// order.
+class ProjectileSystem final
+{
+public:
+    static int const NUM_TYPES = 3;
+    static int const INITIAL_CAPACITY = 1024;
+    static int const JOB_GRAIN = 256;
+
+    // Type 0 is the cannon shell, which falls and is speed limited; the
+    // other types fly straight.
+    static int   const EXPLOSION_RADII [NUM_TYPES];
+    static float const GRAVITY         [NUM_TYPES];
+    static float const MAX_SPEED       [NUM_TYPES];
+
+private:
+    enum Fate : unsigned char
+    {
+        FATE_ALIVE,
+        FATE_EXPIRED,  // Lifetime ran out; explodes where it is
+        FATE_IMPACT,   // Hit terrain; its target holds the solid pixel
+        FATE_VANISHED  // Left the level
+    };
+
+    logic::GameWorld&     m_game_world;
+    utilities::JobSystem& m_jobs;
+
+    std::vector<float> m_position_x;
+    std::vector<float> m_position_y;
+    std::vector<float> m_previous_x;
+    std::vector<float> m_previous_y;
+    std::vector<float> m_velocity_x;
+    std::vector<float> m_velocity_y;
+    std::vector<float> m_gravity;
+    std::vector<float> m_max_speed;
+    std::vector<int>   m_elapsed_ms;
+    std::vector<int>   m_lifetime_ms;
+    std::vector<int>   m_type;
+    std::vector<int>   m_damage;
+
+    // Per-update scratch, kept to avoid reallocating every tick
+    std::vector<float>         m_target_x;
+    std::vector<float>         m_target_y;
+    std::vector<unsigned char> m_fate;
+    std::vector<unsigned char> m_ray_result;
+
+public:
+     ProjectileSystem(logic::GameWorld& world, utilities::JobSystem& jobs);
+    ~ProjectileSystem() = default;
+
+    ProjectileSystem            (ProjectileSystem const&) = delete;
+    ProjectileSystem& operator= (ProjectileSystem const&) = delete;
+
+    void spawn  (math::Vector2f const& pos, math::Vector2f const& vel,
+                 std::chrono::milliseconds const lifetime, int const type, int const dmg);
+    void update (std::chrono::milliseconds const dt, LevelTerrain& terr);
+    void clear  ();
+
+    // Moves the projectile out of whatever it hit and removes it. The last
+    // projectile takes its index, so callers removing while iterating
+    // should walk backwards.
+    void hit    (int const i, math::Vector2f const& mtv, bool const show_explosion);
+    void remove (int const i);
+
+    inline int            size                      ()                                const;
+    inline math::Vector2f get_position              (int const i)                     const;
+    inline math::Vector2f get_interpolated_position (int const i, float const alpha)  const;
+    inline int            get_type                  (int const i)                     const;
+    inline int            get_damage                (int const i)                     const;
+
+private:
+    // Run on the job system and only touch indices in [begin, end)
+    void expire        (int const begin, int const end, int const dt_ms);
+    void integrate     (int const begin, int const end, float const sec);
+    void trace_terrain (int const begin, int const end, LevelTerrain const& terr);
+
+    void apply_fates (LevelTerrain& terr);
+    void remove_dead ();
+};
+
+} // namespace entities
+
+#include "projectile_system.inl"
+
+#endif // ENTITIES_PROJECTILE_SYSTEM_HPP
@@ -0,0 +1,29 @@
+namespace entities {
+
+inline int ProjectileSystem::size() const
+{
+    return static_cast<int>(m_position_x.size());
+}
+
+inline math::Vector2f ProjectileSystem::get_position(int const i) const
+{
+    return math::Vector2f({ m_position_x[i], m_position_y[i] });
+}
+
+inline math::Vector2f ProjectileSystem::get_interpolated_position(int const i, float const alpha) const
+{
+    return math::Vector2f({ math::lerp(m_previous_x[i], m_position_x[i], alpha),
+                            math::lerp(m_previous_y[i], m_position_y[i], alpha) });
+}
+
+inline int ProjectileSystem::get_type(int const i) const
+{
+    return m_type[i];
+}
+
+inline int ProjectileSystem::get_damage(int const i) const
+{
+    return m_damage[i];
+}
+
+} // namespace entities
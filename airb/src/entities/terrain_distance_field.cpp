@@ -0,0 +1,62 @@
+#include "terrain_distance_field.hpp"
+
+namespace entities {
+
+TerrainDistanceField::TerrainDistanceField(TerrainMask const& mask)
+    : m_mask      (mask)
+    , m_num_tiles (mask.get_num_tiles())
+    , m_distances (static_cast<size_t>(m_num_tiles[X]) * static_cast<size_t>(m_num_tiles[Y]),
+                   static_cast<std::uint8_t>(MAX_DISTANCE))
+{
+    transform(0, 0, m_num_tiles[X], m_num_tiles[Y]);
+}
+
+void TerrainDistanceField::refresh(math::Vector2i const& bl, math::Vector2i const& tr)
+{
+    int const x0 = std::max((bl[X] >> TerrainMask::TILE_SHIFT) - REFRESH_MARGIN, 0);
+    int const y0 = std::max((bl[Y] >> TerrainMask::TILE_SHIFT) - REFRESH_MARGIN, 0);
+    int const x1 = std::min((tr[X] >> TerrainMask::TILE_SHIFT) + REFRESH_MARGIN + 1, m_num_tiles[X]);
+    int const y1 = std::min((tr[Y] >> TerrainMask::TILE_SHIFT) + REFRESH_MARGIN + 1, m_num_tiles[Y]);
+
+    transform(x0, y0, x1, y1);
+}
+
+void TerrainDistanceField::transform(int const x0, int const y0, int const x1, int const y1)
+{
+    int const nx = m_num_tiles[X];
+    int const ny = m_num_tiles[Y];
+
+    for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x)
+            m_distances[y * nx + x] = m_mask.is_tile_empty(x, y)
+                                    ? static_cast<std::uint8_t>(MAX_DISTANCE)
+                                    : std::uint8_t(0);
+
+    // Every step to one of the eight neighbours costs one tile. The first
+    // pass pulls distances from the row below and the left, the second
+    // from the row above and the right.
+    auto relax = [this, nx, ny](int const x, int const y, int const dx, int const dy)
+    {
+        int d = m_distances[y * nx + x];
+        if (d == 0)
+            return;
+
+        int const xs[4] = { x + dx, x + dx, x,      x - dx };
+        int const ys[4] = { y,      y + dy, y + dy, y + dy };
+        for (int i = 0; i < 4; ++i)
+            if (xs[i] >= 0 && xs[i] < nx && ys[i] >= 0 && ys[i] < ny)
+                d = std::min(d, get_distance(xs[i], ys[i]) + 1);
+
+        m_distances[y * nx + x] = static_cast<std::uint8_t>(std::min(d, static_cast<int>(MAX_DISTANCE)));
+    };
+
+    for (int y = y0; y < y1; ++y)
+        for (int x = x0; x < x1; ++x)
+            relax(x, y, -1, -1);
+
+    for (int y = y1 - 1; y >= y0; --y)
+        for (int x = x1 - 1; x >= x0; --x)
+            relax(x, y, 1, 1);
+}
+
+} // namespace entities
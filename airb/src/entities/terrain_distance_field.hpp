@@ -0,0 +1,58 @@
+#ifndef ENTITIES_TERRAIN_DISTANCE_FIELD_HPP
+#define ENTITIES_TERRAIN_DISTANCE_FIELD_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "terrain_mask.hpp"
+#include "../math/matrix.hpp"
+
+namespace entities {
+
+// Distance from every tile of a terrain mask to the closest tile holding
+// a solid pixel, counted in tiles along the worse axis (Chebyshev) and
+// capped at MAX_DISTANCE. It gives a cheap lower bound on how far a point
+// is from any solid pixel, so collision code can reject whole shapes
+// without sampling them.
+//
+// Terrain only ever gets destroyed, so a stale distance is still a valid
+// lower bound. refresh() recomputes a window around a changed area so the
+// open space is won back.
+class TerrainDistanceField final
+{
+public:
+    static int const MAX_DISTANCE   = 255;
+    static int const REFRESH_MARGIN = 16; // Tiles around a changed area
+
+private:
+    TerrainMask const&        m_mask;
+    math::Vector2i            m_num_tiles;
+    std::vector<std::uint8_t> m_distances;
+
+public:
+    explicit TerrainDistanceField(TerrainMask const& mask);
+            ~TerrainDistanceField() = default;
+
+    TerrainDistanceField            (TerrainDistanceField const&) = delete;
+    TerrainDistanceField& operator= (TerrainDistanceField const&) = delete;
+
+    // Pixel area whose solidity changed, corners inclusive
+    void refresh(math::Vector2i const& bl, math::Vector2i const& tr);
+
+    // Lower bound on the distance from pos to any solid pixel or to the
+    // edge of the mask; zero when pos is outside of it
+    inline float get_clearance(math::Vector2f const& pos) const;
+
+private:
+    // Two-pass chamfer over tiles [x0, x1) x [y0, y1). Tiles just outside
+    // the window keep their values and seed it.
+    void transform(int const x0, int const y0, int const x1, int const y1);
+
+    inline int get_distance(int const tx, int const ty) const;
+};
+
+} // namespace entities
+
+#include "terrain_distance_field.inl"
+
+#endif // ENTITIES_TERRAIN_DISTANCE_FIELD_HPP
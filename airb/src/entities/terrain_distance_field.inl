@@ -0,0 +1,29 @@
+#include <algorithm>
+
+namespace entities {
+
+inline float TerrainDistanceField::get_clearance(math::Vector2f const& pos) const
+{
+    math::Vector2f const dim(m_mask.get_dimensions());
+
+    // Written so that NaN coordinates fail too instead of indexing the tiles
+    if (!(pos[X] > 0.0f && pos[X] < dim[X] && pos[Y] > 0.0f && pos[Y] < dim[Y]))
+        return 0.0f;
+    float const to_edge = std::min(std::min(pos[X], dim[X] - pos[X]),
+                                   std::min(pos[Y], dim[Y] - pos[Y]));
+
+    // A solid tile d tiles away leaves d - 1 whole tiles between it and
+    // any point of this tile
+    int const d = get_distance(static_cast<int>(pos[X]) >> TerrainMask::TILE_SHIFT,
+                               static_cast<int>(pos[Y]) >> TerrainMask::TILE_SHIFT);
+    float const to_solid = static_cast<float>(std::max(d - 1, 0) * TerrainMask::TILE_SIZE);
+
+    return std::min(to_solid, to_edge);
+}
+
+inline int TerrainDistanceField::get_distance(int const tx, int const ty) const
+{
+    return m_distances[ty * m_num_tiles[X] + tx];
+}
+
+} // namespace entities
@@ -0,0 +1,40 @@
+#include "terrain_mask.hpp"
+
+#include <algorithm>
+
+namespace entities {
+
+TerrainMask::TerrainMask(math::Vector2i const& dim, GLubyte const* rgba_data, int const rgba_size)
+    : m_dimensions    (dim)
+    , m_tiles_per_row ((dim[X] + TILE_MASK) >> TILE_SHIFT)
+    , m_tiles         (static_cast<size_t>(m_tiles_per_row)
+                       * static_cast<size_t>((dim[Y] + TILE_MASK) >> TILE_SHIFT), 0)
+{
+    for (int y = 0; y < m_dimensions[Y]; ++y)
+    {
+        GLubyte const* alpha = &rgba_data[static_cast<size_t>(y) * m_dimensions[X] * rgba_size
+                                          + (rgba_size - 1)];
+        for (int x = 0; x < m_dimensions[X]; ++x, alpha += rgba_size)
+            if (*alpha != 0)
+                get_tile(x, y) |= get_bit(x, y);
+    }
+}
+
+void TerrainMask::clear_span(int const y, int const start_x, int const end_x)
+{
+    // Clears [start_x, end_x), one tile row (8 bits) at a time.
+    int const row_shift = (y & TILE_MASK) << TILE_SHIFT;
+
+    int x = start_x;
+    while (x < end_x)
+    {
+        int const tile_end = std::min((x | TILE_MASK) + 1, end_x);
+        int const count    = tile_end - x;
+        std::uint64_t const bits = ((std::uint64_t(1) << count) - 1)
+                                 << (row_shift | (x & TILE_MASK));
+        get_tile(x, y) &= ~bits;
+        x = tile_end;
+    }
+}
+
+} // namespace entities
@@ -0,0 +1,59 @@
+#ifndef ENTITIES_TERRAIN_MASK_HPP
+#define ENTITIES_TERRAIN_MASK_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include <glew.h>
+
+#include "../math/matrix.hpp"
+
+namespace entities {
+
+// One bit per terrain pixel, packed into 8x8 pixel tiles so that a
+// 64-bit word covers a small square of the level instead of a long row.
+class TerrainMask final
+{
+public:
+    static int const TILE_SHIFT = 3;
+    static int const TILE_SIZE  = 1 << TILE_SHIFT;
+    static int const TILE_MASK  = TILE_SIZE - 1;
+
+private:
+    math::Vector2i             m_dimensions;
+    int                        m_tiles_per_row;
+    std::vector<std::uint64_t> m_tiles;
+
+public:
+     TerrainMask(math::Vector2i const& dim, GLubyte const* rgba_data, int const rgba_size);
+    ~TerrainMask() = default;
+
+    TerrainMask            (TerrainMask const&) = delete;
+    TerrainMask& operator= (TerrainMask const&) = delete;
+
+    void clear_span(int const y, int const start_x, int const end_x);
+
+    // Pixel coordinates are not checked and must be inside the mask
+    inline bool is_solid (int const x, int const y) const;
+    inline void clear    (int const x, int const y);
+
+    // Tile coordinates, i.e. pixel coordinates >> TILE_SHIFT. Bit
+    // (y & TILE_MASK) * TILE_SIZE + (x & TILE_MASK) is pixel (x, y).
+    inline std::uint64_t get_tile_bits (int const tx, int const ty) const;
+    inline bool          is_tile_empty (int const tx, int const ty) const;
+
+    inline math::Vector2i const& get_dimensions () const;
+    inline math::Vector2i        get_num_tiles  () const;
+
+private:
+    inline std::uint64_t& get_tile (int const x, int const y);
+    inline std::uint64_t  get_tile (int const x, int const y) const;
+
+    static inline std::uint64_t get_bit(int const x, int const y);
+};
+
+} // namespace entities
+
+#include "terrain_mask.inl"
+
+#endif // ENTITIES_TERRAIN_MASK_HPP
@@ -0,0 +1,48 @@
+namespace entities {
+
+inline bool TerrainMask::is_solid(int const x, int const y) const
+{
+    return (get_tile(x, y) & get_bit(x, y)) != 0;
+}
+
+inline void TerrainMask::clear(int const x, int const y)
+{
+    get_tile(x, y) &= ~get_bit(x, y);
+}
+
+inline std::uint64_t TerrainMask::get_tile_bits(int const tx, int const ty) const
+{
+    return m_tiles[ty * m_tiles_per_row + tx];
+}
+
+inline bool TerrainMask::is_tile_empty(int const tx, int const ty) const
+{
+    return get_tile_bits(tx, ty) == 0;
+}
+
+inline math::Vector2i const& TerrainMask::get_dimensions() const
+{
+    return m_dimensions;
+}
+
+inline math::Vector2i TerrainMask::get_num_tiles() const
+{
+    return math::Vector2i({ m_tiles_per_row, (m_dimensions[Y] + TILE_MASK) >> TILE_SHIFT });
+}
+
+inline std::uint64_t& TerrainMask::get_tile(int const x, int const y)
+{
+    return m_tiles[(y >> TILE_SHIFT) * m_tiles_per_row + (x >> TILE_SHIFT)];
+}
+
+inline std::uint64_t TerrainMask::get_tile(int const x, int const y) const
+{
+    return m_tiles[(y >> TILE_SHIFT) * m_tiles_per_row + (x >> TILE_SHIFT)];
+}
+
+inline std::uint64_t TerrainMask::get_bit(int const x, int const y)
+{
+    return std::uint64_t(1) << (((y & TILE_MASK) << TILE_SHIFT) | (x & TILE_MASK));
+}
+
+} // namespace entities
@@ -0,0 +1,274 @@
+#include "terrain_occupancy.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace entities {
+
+TerrainOccupancy::TerrainOccupancy(TerrainMask const& mask)
+    : m_mask   (mask)
+    , m_levels ()
+{
+    math::Vector2i n = mask.get_num_tiles();
+    for (;;)
+    {
+        m_levels.emplace_back(n);
+
+        if (n[X] == 1 && n[Y] == 1)
+            break;
+        n = math::Vector2i({ (n[X] + 1) / 2, (n[Y] + 1) / 2 });
+    }
+
+    for (int level = 0; level < static_cast<int>(m_levels.size()); ++level)
+    {
+        math::Vector2i const& num = m_levels[level].num_nodes;
+        update_nodes(level, 0, 0, num[X] - 1, num[Y] - 1);
+    }
+}
+
+void TerrainOccupancy::refresh(math::Vector2i const& bl, math::Vector2i const& tr)
+{
+    math::Vector2i const& num = m_levels[0].num_nodes;
+    int x0 = std::max(bl[X] >> TerrainMask::TILE_SHIFT, 0);
+    int y0 = std::max(bl[Y] >> TerrainMask::TILE_SHIFT, 0);
+    int x1 = std::min(tr[X] >> TerrainMask::TILE_SHIFT, num[X] - 1);
+    int y1 = std::min(tr[Y] >> TerrainMask::TILE_SHIFT, num[Y] - 1);
+
+    for (int level = 0; level < static_cast<int>(m_levels.size()); ++level)
+    {
+        update_nodes(level, x0, y0, x1, y1);
+        x0 >>= 1;
+        y0 >>= 1;
+        x1 >>= 1;
+        y1 >>= 1;
+    }
+}
+
+bool TerrainOccupancy::is_rect_empty(math::Vector2i const& bl, math::Vector2i const& tr) const
+{
+    math::Vector2i const& dim = m_mask.get_dimensions();
+    math::Vector2i const cbl({ std::max(bl[X], 0), std::max(bl[Y], 0) });
+    math::Vector2i const ctr({ std::min(tr[X], dim[X] - 1), std::min(tr[Y], dim[Y] - 1) });
+    if (cbl[X] > ctr[X] || cbl[Y] > ctr[Y])
+        return true;
+
+    return is_rect_uniform(cbl, ctr, false);
+}
+
+bool TerrainOccupancy::is_rect_solid(math::Vector2i const& bl, math::Vector2i const& tr) const
+{
+    math::Vector2i const& dim = m_mask.get_dimensions();
+    math::Vector2i const cbl({ std::max(bl[X], 0), std::max(bl[Y], 0) });
+    math::Vector2i const ctr({ std::min(tr[X], dim[X] - 1), std::min(tr[Y], dim[Y] - 1) });
+    if (cbl[X] > ctr[X] || cbl[Y] > ctr[Y])
+        return false;
+
+    return is_rect_uniform(cbl, ctr, true);
+}
+
+bool TerrainOccupancy::is_segment_empty(math::Vector2f const& a, math::Vector2f const& b) const
+{
+    math::Vector2f const dim(m_mask.get_dimensions());
+    auto const inside = [&dim](math::Vector2f const& p)
+    {
+        return p[X] >= 0.0f && p[X] < dim[X] && p[Y] >= 0.0f && p[Y] < dim[Y];
+    };
+    if (!inside(a) || !inside(b))
+        return false;
+
+    // Pixel boxes are closed, so a segment ending on a pixel edge also
+    // touches the pixel on the other side of it
+    math::Vector2i const& size = m_mask.get_dimensions();
+    int const x0 = std::max(static_cast<int>(std::min(a[X], b[X])) - 1, 0);
+    int const y0 = std::max(static_cast<int>(std::min(a[Y], b[Y])) - 1, 0);
+    int const x1 = std::min(static_cast<int>(std::max(a[X], b[X])) + 1, size[X] - 1);
+    int const y1 = std::min(static_cast<int>(std::max(a[Y], b[Y])) + 1, size[Y] - 1);
+
+    int const level = get_start_level(x0, y0, x1, y1);
+    int const shift = TerrainMask::TILE_SHIFT + level;
+    math::Vector2f const d = b - a;
+    for (int ny = y0 >> shift; ny <= y1 >> shift; ++ny)
+        for (int nx = x0 >> shift; nx <= x1 >> shift; ++nx)
+            if (!is_segment_empty(level, nx, ny, a, d))
+                return false;
+    return true;
+}
+
+void TerrainOccupancy::update_nodes(int const level, int const x0, int const y0, int const x1, int const y1)
+{
+    Level& l = m_levels[level];
+
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+        {
+            int f = 0;
+            if (level == 0)
+            {
+                std::uint64_t const bits = m_mask.get_tile_bits(x, y);
+                f = (bits != 0 ? ANY_SOLID : 0) | (bits == ~std::uint64_t(0) ? ALL_SOLID : 0);
+            }
+            else
+            {
+                // Children past the edge of the level count as empty
+                Level const& c = m_levels[level - 1];
+                f = ALL_SOLID;
+                for (int cy = 2 * y; cy <= 2 * y + 1; ++cy)
+                    for (int cx = 2 * x; cx <= 2 * x + 1; ++cx)
+                    {
+                        if (cx >= c.num_nodes[X] || cy >= c.num_nodes[Y])
+                        {
+                            f &= ~ALL_SOLID;
+                            continue;
+                        }
+                        int const cf = c.flags[cy * c.num_nodes[X] + cx];
+                        f |= cf & ANY_SOLID;
+                        if ((cf & ALL_SOLID) == 0)
+                            f &= ~ALL_SOLID;
+                    }
+            }
+            l.flags[y * l.num_nodes[X] + x] = static_cast<std::uint8_t>(f);
+        }
+}
+
+int TerrainOccupancy::get_start_level(int const x0, int const y0, int const x1, int const y1) const
+{
+    // The lowest level at which the pixels span at most two nodes either
+    // way. Walking down from the root would only narrow it to these.
+    int const top = static_cast<int>(m_levels.size()) - 1;
+    int level = 0;
+    for (; level < top; ++level)
+    {
+        int const shift = TerrainMask::TILE_SHIFT + level;
+        if ((x1 >> shift) - (x0 >> shift) <= 1 && (y1 >> shift) - (y0 >> shift) <= 1)
+            break;
+    }
+    return level;
+}
+
+bool TerrainOccupancy::is_rect_uniform(math::Vector2i const& bl, math::Vector2i const& tr, bool const solid) const
+{
+    int const level = get_start_level(bl[X], bl[Y], tr[X], tr[Y]);
+    int const shift = TerrainMask::TILE_SHIFT + level;
+    for (int ny = bl[Y] >> shift; ny <= tr[Y] >> shift; ++ny)
+        for (int nx = bl[X] >> shift; nx <= tr[X] >> shift; ++nx)
+            if (!is_rect_uniform(level, nx, ny, bl, tr, solid))
+                return false;
+    return true;
+}
+
+bool TerrainOccupancy::is_rect_uniform(int const level, int const nx, int const ny,
+                                       math::Vector2i const& bl, math::Vector2i const& tr,
+                                       bool const solid) const
+{
+    int const size = TerrainMask::TILE_SIZE << level;
+    int const x0   = nx * size;
+    int const y0   = ny * size;
+    int const x1   = x0 + size - 1;
+    int const y1   = y0 + size - 1;
+    if (x1 < bl[X] || x0 > tr[X] || y1 < bl[Y] || y0 > tr[Y])
+        return true;
+
+    std::uint8_t const f = get_flags(level, nx, ny);
+    if ((f & ANY_SOLID) == 0)
+        return !solid;
+    if ((f & ALL_SOLID) != 0)
+        return solid;
+
+    if (level == 0)
+    {
+        int const cx0 = std::max(bl[X], x0) - x0;
+        int const cx1 = std::min(tr[X], x1) - x0;
+        int const cy0 = std::max(bl[Y], y0) - y0;
+        int const cy1 = std::min(tr[Y], y1) - y0;
+
+        std::uint64_t const row = ((std::uint64_t(1) << (cx1 - cx0 + 1)) - 1) << cx0;
+        std::uint64_t mask = 0;
+        for (int r = cy0; r <= cy1; ++r)
+            mask |= row << (r << TerrainMask::TILE_SHIFT);
+
+        std::uint64_t const bits = m_mask.get_tile_bits(nx, ny) & mask;
+        return solid ? bits == mask : bits == 0;
+    }
+
+    math::Vector2i const& num = m_levels[level - 1].num_nodes;
+    for (int cy = 2 * ny; cy <= 2 * ny + 1 && cy < num[Y]; ++cy)
+        for (int cx = 2 * nx; cx <= 2 * nx + 1 && cx < num[X]; ++cx)
+            if (!is_rect_uniform(level - 1, cx, cy, bl, tr, solid))
+                return false;
+    return true;
+}
+
+bool TerrainOccupancy::is_segment_empty(int const level, int const nx, int const ny,
+                                        math::Vector2f const& a, math::Vector2f const& d) const
+{
+    int   const size = TerrainMask::TILE_SIZE << level;
+    float const x0   = static_cast<float>(nx * size);
+    float const y0   = static_cast<float>(ny * size);
+    float const s    = static_cast<float>(size);
+    if (!segment_hits_box(a, d, x0, y0, x0 + s, y0 + s))
+        return true;
+
+    std::uint8_t const f = get_flags(level, nx, ny);
+    if ((f & ANY_SOLID) == 0)
+        return true;
+    if ((f & ALL_SOLID) != 0)
+        return false;
+
+    if (level == 0)
+    {
+        std::uint64_t const bits = m_mask.get_tile_bits(nx, ny);
+        for (int r = 0; r < TerrainMask::TILE_SIZE; ++r)
+        {
+            unsigned const row = static_cast<unsigned>(bits >> (r << TerrainMask::TILE_SHIFT)) & 0xffu;
+            float const py = y0 + static_cast<float>(r);
+            if (row == 0 || !segment_hits_box(a, d, x0, py, x0 + s, py + 1.0f))
+                continue;
+
+            for (int c = 0; c < TerrainMask::TILE_SIZE; ++c)
+            {
+                float const px = x0 + static_cast<float>(c);
+                if ((row >> c & 1u) != 0 && segment_hits_box(a, d, px, py, px + 1.0f, py + 1.0f))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    math::Vector2i const& num = m_levels[level - 1].num_nodes;
+    for (int cy = 2 * ny; cy <= 2 * ny + 1 && cy < num[Y]; ++cy)
+        for (int cx = 2 * nx; cx <= 2 * nx + 1 && cx < num[X]; ++cx)
+            if (!is_segment_empty(level - 1, cx, cy, a, d))
+                return false;
+    return true;
+}
+
+bool TerrainOccupancy::segment_hits_box(math::Vector2f const& a, math::Vector2f const& d,
+                                        float const x0, float const y0, float const x1, float const y1)
+{
+    // Slab test against the closed box; touching counts as a hit
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+    float const lo[2] = { x0, y0 };
+    float const hi[2] = { x1, y1 };
+    for (int i = 0; i < 2; ++i)
+    {
+        if (d[i] == 0.0f)
+        {
+            if (a[i] < lo[i] || a[i] > hi[i])
+                return false;
+            continue;
+        }
+
+        float ta = (lo[i] - a[i]) / d[i];
+        float tb = (hi[i] - a[i]) / d[i];
+        if (ta > tb)
+            std::swap(ta, tb);
+        t0 = std::max(t0, ta);
+        t1 = std::min(t1, tb);
+        if (t0 > t1)
+            return false;
+    }
+    return true;
+}
+
+} // namespace entities
@@ -0,0 +1,83 @@
+#ifndef ENTITIES_TERRAIN_OCCUPANCY_HPP
+#define ENTITIES_TERRAIN_OCCUPANCY_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "terrain_mask.hpp"
+#include "../math/matrix.hpp"
+
+namespace entities {
+
+// Min/max pyramid over the tiles of a terrain mask. Level 0 has a node per
+// 8x8 pixel tile and every level above halves both dimensions, up to a
+// single node for the whole level. A node records whether any and whether
+// all of its pixels are solid, so area and segment queries stop at the
+// first node that is uniform and only look at pixels in mixed tiles.
+// Queries start at the lowest level where they span at most 2x2 nodes
+// rather than at the root.
+class TerrainOccupancy final
+{
+private:
+    enum Flags : std::uint8_t
+    {
+        ANY_SOLID = 1,
+        ALL_SOLID = 2
+    };
+
+    struct Level
+    {
+        math::Vector2i            num_nodes;
+        std::vector<std::uint8_t> flags;
+
+        explicit Level(math::Vector2i const& n)
+            : num_nodes (n)
+            , flags     (static_cast<size_t>(n[X]) * static_cast<size_t>(n[Y]), std::uint8_t(0))
+        { }
+    };
+
+    TerrainMask const& m_mask;
+    std::vector<Level> m_levels;
+
+public:
+    explicit TerrainOccupancy(TerrainMask const& mask);
+            ~TerrainOccupancy() = default;
+
+    TerrainOccupancy            (TerrainOccupancy const&) = delete;
+    TerrainOccupancy& operator= (TerrainOccupancy const&) = delete;
+
+    // Pixel area whose solidity changed, corners inclusive
+    void refresh(math::Vector2i const& bl, math::Vector2i const& tr);
+
+    // Corners inclusive and clamped to the mask
+    bool is_rect_empty (math::Vector2i const& bl, math::Vector2i const& tr) const;
+    bool is_rect_solid (math::Vector2i const& bl, math::Vector2i const& tr) const;
+
+    // True when the segment touches no solid pixel. Segments reaching
+    // outside the mask are never empty.
+    bool is_segment_empty(math::Vector2f const& a, math::Vector2f const& b) const;
+
+private:
+    void update_nodes(int const level, int const x0, int const y0, int const x1, int const y1);
+
+    // Level to start a query over pixels [x0, x1] x [y0, y1] at, inside
+    // the mask
+    int get_start_level(int const x0, int const y0, int const x1, int const y1) const;
+
+    bool is_rect_uniform   (math::Vector2i const& bl, math::Vector2i const& tr, bool const solid) const;
+    bool is_rect_uniform   (int const level, int const nx, int const ny,
+                            math::Vector2i const& bl, math::Vector2i const& tr, bool const solid) const;
+    bool is_segment_empty  (int const level, int const nx, int const ny,
+                            math::Vector2f const& a, math::Vector2f const& d) const;
+
+    inline std::uint8_t get_flags(int const level, int const nx, int const ny) const;
+
+    static bool segment_hits_box(math::Vector2f const& a, math::Vector2f const& d,
+                                 float const x0, float const y0, float const x1, float const y1);
+};
+
+} // namespace entities
+
+#include "terrain_occupancy.inl"
+
+#endif // ENTITIES_TERRAIN_OCCUPANCY_HPP
@@ -0,0 +1,9 @@
+namespace entities {
+
+inline std::uint8_t TerrainOccupancy::get_flags(int const level, int const nx, int const ny) const
+{
+    Level const& l = m_levels[level];
+    return l.flags[ny * l.num_nodes[X] + nx];
+}
+
+} // namespace entities
@@ -1,9 +1,5 @@
 ﻿#include "uncontrollable_plane.hpp"
 
-#include <GLFW/glfw3.h>
-
-#include "../input/keyboard.hpp"
-#include "../input/mouse.hpp"
 #include "../network/utilities/udp_packet.hpp"
 
 namespace entities {
@@ -15,7 +11,7 @@ UncontrollablePlane::UncontrollablePlane(float const mass,
                                          utilities::ResourceHolder<
                                          graphics::Texture, graphics::Textures
                                          >& tex_hld,
-                                         logic::GameplayState* const g_st,
+                                         logic::GameWorld* const g_st,
                                          graphics::Texture& tex,
                                          math::Vector2i const& src_pos, math::Vector2i const& src_dim,
                                          math::Vector2i const& dim,
@@ -100,7 +96,7 @@ void UncontrollablePlane::handle_input(math::Vector2f const& m_world_pos,
         m_rigid_body.damp_angular_velocity(ANGULAR_DAMP, dt);
 }
 
-void UncontrollablePlane::process_packet(network::UdpPacket packet)
+void UncontrollablePlane::process_packet(network::UdpPacket const& packet)
 {
     if (packet.header_contains(network::UDP_H_INPUT))
     {
@@ -127,62 +123,6 @@ void UncontrollablePlane::process_packet(network::UdpPacket packet)
             m_keypressed_switch_3 = packet.action_contains(network::UDP_IN_PRESS);
         if (packet.action_contains(network::UDP_IN_SWITCH_WPN_Q))
             m_keypressed_switch_q = packet.action_contains(network::UDP_IN_PRESS);
-        return;
-    }
-    if (packet.header_contains(network::UDP_H_POS))
-    {
-        char buffer[network::UDP_MAX_DATABLOCK_SIZE] = { '\0' };
-        auto data = packet.get_data_block();
-        float x, y, rot, velx, vely;
-
-        // x
-        auto byte = 0;
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        x = static_cast<float>(atof(buffer));
-
-        // y
-        byte++;
-        auto e = 0; while (buffer[e] != '\0') buffer[e++] = '\0';
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        y = static_cast<float>(atof(buffer));
-
-        // rot
-        byte++;
-        e = 0; while (buffer[e] != '\0') buffer[e++] = '\0';
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        rot = static_cast<float>(atof(buffer));
-
-        // vel x
-        byte++;
-        e = 0; while (buffer[e] != '\0') buffer[e++] = '\0';
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        velx = static_cast<float>(atof(buffer));
-
-        // vel y
-        byte++;
-        e = 0; while (buffer[e] != '\0') buffer[e++] = '\0';
-        for (auto i = 0; data[byte] != '\0'; i++, byte++)
-            buffer[i] = data[byte];
-        vely = static_cast<float>(atof(buffer));
-
-        //// weapon num
-        //byte++;
-        //auto weapon = static_cast<int>(data[byte]) % 2;
-
-        //// weapon ammo
-        //byte++;
-        //auto ammo = static_cast<int>(data[byte]);
-
-        m_rigid_body.set_position(math::Vector2f({ x, y }));
-        m_rigid_body.set_rotation(rot);
-        m_rigid_body.set_velocity(math::Vector2f({ velx, vely }));
-
-        //current_weapon = weapon;
-        //m_weapons[current_weapon]->set_rounds(ammo);
     }
 }
 
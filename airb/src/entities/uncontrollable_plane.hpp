@@ -41,7 +41,7 @@ public:
                         std::vector<physics::BoxCollider> const& collider,
                         float const thrust, float const yaw,
                         utilities::ResourceHolder<graphics::Texture, graphics::Textures>& tex_hld,
-                        logic::GameplayState* const g_st,
+                        logic::GameWorld* const g_st,
                         graphics::Texture& tex,
                         math::Vector2i const& src_pos, math::Vector2i const& src_dim,
                         math::Vector2i const& dim,
@@ -54,7 +54,7 @@ public:
 
     void handle_input(math::Vector2f const& m_world_pos,
                       std::chrono::milliseconds const dt);
-    void process_packet(network::UdpPacket packet);
+    void process_packet(network::UdpPacket const& packet);
 
     void reset_frame();
 
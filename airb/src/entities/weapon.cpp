@@ -1,7 +1,8 @@
 #include "weapon.hpp"
 
 #include "plane.hpp"
-#include "../logic/gameplay_state.hpp"
+#include "../logic/game_world.hpp"
+#include "../math/general.hpp"
 
 namespace entities {
 
@@ -13,7 +14,7 @@ namespace
                                                      graphics::TURRET_DIMENSIONS });
 }
 
-Weapon::Weapon(Plane& p, graphics::Texture& tex, logic::GameplayState* game_state,
+Weapon::Weapon(Plane& p, graphics::Texture& tex, logic::GameWorld* game_state,
                std::string const& name, bool const automatic,
                std::chrono::milliseconds const fire_rate,
                std::chrono::milliseconds const reload_t,
@@ -71,15 +72,22 @@ void Weapon::shoot()
 
     GLfloat angle = m_sprite.get_rotation();
 
+    float sin_a;
+    float cos_a;
+    math::sin_cos(angle, sin_a, cos_a);
+
     math::Vector2f barrel_pos({
-        m_origin[X] * cosf(angle) - m_origin[Y] * sinf(angle),
-        m_origin[X] * sinf(angle) + m_origin[Y] * cosf(angle),
+        m_origin[X] * cos_a - m_origin[Y] * sin_a,
+        m_origin[X] * sin_a + m_origin[Y] * cos_a,
     });
 
     if (m_rounds > 0 && !m_reloading && m_time_from_last_shot >= m_fire_rate)
     {
         float const rot = get_rotation();
-        math::Vector2f const dir({ cosf(rot), sinf(rot) });
+        float sin_r;
+        float cos_r;
+        math::sin_cos(rot, sin_r, cos_r);
+        math::Vector2f const dir({ cos_r, sin_r });
         m_game_state->add_projectile(
             get_turret_position() + barrel_pos, dir,
             m_projectile_lifetime, m_bullet_speed,
@@ -11,7 +11,7 @@
 
 namespace logic {
 
-class GameplayState;
+class GameWorld;
 
 } // namespace logic
 
@@ -31,8 +31,8 @@ private:
     float             m_bullet_speed;
     int               m_bullet_type;
 
-    graphics::Sprite      m_sprite;
-    logic::GameplayState* m_game_state;
+    graphics::Sprite  m_sprite;
+    logic::GameWorld* m_game_state;
 
     math::Vector2f m_origin;
 
@@ -44,7 +44,7 @@ private:
     std::chrono::milliseconds m_projectile_lifetime;
 
 public:
-     Weapon(Plane& p, graphics::Texture& tex, logic::GameplayState* game_state,
+     Weapon(Plane& p, graphics::Texture& tex, logic::GameWorld* game_state,
             std::string const& name, bool const automatic,
             std::chrono::milliseconds const fire_rate,
             std::chrono::milliseconds const reload_t,
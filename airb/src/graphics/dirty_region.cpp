@@ -0,0 +1,98 @@
+#include "dirty_region.hpp"
+
+#include <cassert>
+
+namespace graphics {
+
+DirtyRegion::DirtyRegion(math::Vector2i const& dim, int const bytes_per_pixel)
+    : m_dimensions           (dim)
+    , m_tile_dimensions      (math::Vector2i({ (dim[X] + TILE_SIZE - 1) >> TILE_SHIFT,
+                                               (dim[Y] + TILE_SIZE - 1) >> TILE_SHIFT }))
+    , m_bytes_per_pixel      (bytes_per_pixel)
+    , m_dirty_tiles          (static_cast<size_t>(m_tile_dimensions[X] * m_tile_dimensions[Y]), false)
+    , m_areas                ()
+
+    , m_pending_bytes        (0)
+    , m_requested_bytes      (0)
+    , m_last_uploaded_bytes  (0)
+    , m_last_requested_bytes (0)
+{
+    m_areas.reserve(64);
+}
+
+void DirtyRegion::mark(math::Vector2i const& bl, math::Vector2i const& tr)
+{
+    assert(bl[X] >= 0 && bl[Y] >= 0);
+    assert(tr[X] < m_dimensions[X] && tr[Y] < m_dimensions[Y]);
+
+    if (tr[X] < bl[X] || tr[Y] < bl[Y])
+        return;
+
+    m_requested_bytes += static_cast<size_t>((tr[X] - bl[X] + 1) * (tr[Y] - bl[Y] + 1))
+                       * m_bytes_per_pixel;
+
+    for (int y = bl[Y] >> TILE_SHIFT; y <= tr[Y] >> TILE_SHIFT; ++y)
+        for (int x = bl[X] >> TILE_SHIFT; x <= tr[X] >> TILE_SHIFT; ++x)
+        {
+            if (is_tile_dirty(x, y))
+                continue;
+            set_tile_dirty(x, y, true);
+            m_pending_bytes += static_cast<size_t>(get_tile_area(x, y)) * m_bytes_per_pixel;
+        }
+}
+
+void DirtyRegion::flush(TextureUploader& uploader, GLubyte const* image_data)
+{
+    coalesce();
+    uploader.upload(m_areas, image_data, m_dimensions[X]);
+
+    m_last_uploaded_bytes  = m_pending_bytes;
+    m_last_requested_bytes = m_requested_bytes;
+    m_pending_bytes        = 0;
+    m_requested_bytes      = 0;
+}
+
+void DirtyRegion::coalesce()
+{
+    // Greedy cover: grow each rectangle right as far as the row of dirty
+    // tiles goes, then up while the whole row above is dirty too. Tiles
+    // are cleared as they are taken so every tile ends up in exactly one
+    // rectangle.
+    m_areas.clear();
+    if (is_empty())
+        return;
+
+    for (int y = 0; y < m_tile_dimensions[Y]; ++y)
+        for (int x = 0; x < m_tile_dimensions[X]; ++x)
+        {
+            if (!is_tile_dirty(x, y))
+                continue;
+
+            int end_x = x + 1;
+            while (end_x < m_tile_dimensions[X] && is_tile_dirty(end_x, y))
+                ++end_x;
+
+            int end_y = y + 1;
+            for (; end_y < m_tile_dimensions[Y]; ++end_y)
+            {
+                int i = x;
+                while (i < end_x && is_tile_dirty(i, end_y))
+                    ++i;
+                if (i != end_x)
+                    break;
+            }
+
+            for (int j = y; j < end_y; ++j)
+                for (int i = x; i < end_x; ++i)
+                    set_tile_dirty(i, j, false);
+
+            math::Vector2i const pos({ x << TILE_SHIFT, y << TILE_SHIFT });
+            math::Vector2i const dim({ std::min(end_x << TILE_SHIFT, m_dimensions[X]) - pos[X],
+                                       std::min(end_y << TILE_SHIFT, m_dimensions[Y]) - pos[Y] });
+            m_areas.emplace_back(pos, dim);
+
+            x = end_x - 1;
+        }
+}
+
+} // namespace graphics
@@ -0,0 +1,70 @@
+#ifndef GRAPHICS_DIRTY_REGION_HPP
+#define GRAPHICS_DIRTY_REGION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "texture_uploader.hpp"
+
+namespace graphics {
+
+// Tracks which parts of an image have changed since the last upload on a
+// grid of 64x64 tiles. All changes of a frame are merged into as few
+// rectangles as possible before they are handed to a TextureUploader, so
+// overlapping changes upload each row only once.
+class DirtyRegion final
+{
+public:
+    static int const TILE_SHIFT = 6;
+    static int const TILE_SIZE  = 1 << TILE_SHIFT;
+
+private:
+    math::Vector2i           m_dimensions;
+    math::Vector2i           m_tile_dimensions;
+    int                      m_bytes_per_pixel;
+    std::vector<bool>        m_dirty_tiles;
+    std::vector<TextureArea> m_areas;
+
+    std::size_t m_pending_bytes;
+    std::size_t m_requested_bytes;
+    std::size_t m_last_uploaded_bytes;
+    std::size_t m_last_requested_bytes;
+
+public:
+     DirtyRegion(math::Vector2i const& dim, int const bytes_per_pixel);
+    ~DirtyRegion() = default;
+
+    DirtyRegion            (DirtyRegion const&) = delete;
+    DirtyRegion& operator= (DirtyRegion const&) = delete;
+
+    // Marks the pixels from bl to tr, both inclusive.
+    void mark  (math::Vector2i const& bl, math::Vector2i const& tr);
+    void flush (TextureUploader& uploader, GLubyte const* image_data);
+
+    inline bool is_empty () const;
+
+    // Bytes the next flush will upload.
+    inline std::size_t get_pending_upload_bytes   () const;
+    // Bytes the marked areas would have taken if uploaded one by one.
+    inline std::size_t get_requested_upload_bytes () const;
+
+    // The same two figures for the last flush, which resets the above.
+    inline std::size_t get_last_uploaded_bytes    () const;
+    inline std::size_t get_last_requested_bytes   () const;
+
+    inline std::vector<TextureArea> const& get_last_areas() const;
+
+private:
+    void coalesce();
+
+    inline bool is_tile_dirty  (int const x, int const y) const;
+    inline void set_tile_dirty (int const x, int const y, bool const dirty);
+    inline int  get_tile_area  (int const x, int const y) const;
+};
+
+} // namespace graphics
+
+#include "dirty_region.inl"
+
+#endif // GRAPHICS_DIRTY_REGION_HPP
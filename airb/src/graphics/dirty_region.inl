@@ -0,0 +1,51 @@
+namespace graphics {
+
+inline bool DirtyRegion::is_empty() const
+{
+    return m_pending_bytes == 0;
+}
+
+inline std::size_t DirtyRegion::get_pending_upload_bytes() const
+{
+    return m_pending_bytes;
+}
+
+inline std::size_t DirtyRegion::get_requested_upload_bytes() const
+{
+    return m_requested_bytes;
+}
+
+inline std::size_t DirtyRegion::get_last_uploaded_bytes() const
+{
+    return m_last_uploaded_bytes;
+}
+
+inline std::size_t DirtyRegion::get_last_requested_bytes() const
+{
+    return m_last_requested_bytes;
+}
+
+inline std::vector<TextureArea> const& DirtyRegion::get_last_areas() const
+{
+    return m_areas;
+}
+
+inline bool DirtyRegion::is_tile_dirty(int const x, int const y) const
+{
+    return m_dirty_tiles[y * m_tile_dimensions[X] + x];
+}
+
+inline void DirtyRegion::set_tile_dirty(int const x, int const y, bool const dirty)
+{
+    m_dirty_tiles[y * m_tile_dimensions[X] + x] = dirty;
+}
+
+inline int DirtyRegion::get_tile_area(int const x, int const y) const
+{
+    // Tiles on the right and top edges may be cut short by the image.
+    int const w = std::min(m_dimensions[X] - (x << TILE_SHIFT), 1 << TILE_SHIFT);
+    int const h = std::min(m_dimensions[Y] - (y << TILE_SHIFT), 1 << TILE_SHIFT);
+    return w * h;
+}
+
+} // namespace graphics
@@ -0,0 +1,38 @@
+#include "gl_texture_uploader.hpp"
+
+#include "render_tools.hpp"
+#include "texture.hpp"
+
+namespace graphics {
+
+GlTextureUploader::GlTextureUploader(Texture& tex)
+    : TextureUploader ()
+    , m_texture       (tex)
+{ }
+
+void GlTextureUploader::upload(std::vector<TextureArea> const& areas,
+                               GLubyte const* image_data, int const row_length)
+{
+    if (areas.empty())
+        return;
+
+    static int const RGBA_SIZE = 4;
+
+    m_texture.bind();
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, row_length);
+
+    for (auto const& a : areas)
+    {
+        glTexSubImage2D(
+            GL_TEXTURE_2D, 0,
+            a.first[X], a.first[Y], a.second[X], a.second[Y],
+            GL_RGBA, GL_UNSIGNED_BYTE,
+            &image_data[(static_cast<size_t>(a.first[Y]) * row_length + a.first[X]) * RGBA_SIZE]
+        );
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    RenderTools::unbind_texture();
+}
+
+} // namespace graphics
@@ -0,0 +1,25 @@
+#ifndef GRAPHICS_GL_TEXTURE_UPLOADER_HPP
+#define GRAPHICS_GL_TEXTURE_UPLOADER_HPP
+
+#include "texture_uploader.hpp"
+
+namespace graphics {
+
+class Texture;
+
+class GlTextureUploader final : public TextureUploader
+{
+private:
+    Texture& m_texture;
+
+public:
+    explicit  GlTextureUploader(Texture& tex);
+             ~GlTextureUploader() = default;
+
+    void upload(std::vector<TextureArea> const& areas,
+                GLubyte const* image_data, int const row_length) override;
+};
+
+} // namespace graphics
+
+#endif // GRAPHICS_GL_TEXTURE_UPLOADER_HPP
@@ -1,6 +1,8 @@
 #include "texture.hpp"
 
+#ifndef AIRB_HEADLESS
 #include "render_tools.hpp"
+#endif
 #include "../utilities/debug.hpp"
 
 namespace graphics {
@@ -11,6 +13,10 @@ Texture::Texture(std::string const& path, bool const mipmap)
     , m_image      (path)
     , m_dimensions (m_image.get_dimensions())
 {
+#ifdef AIRB_HEADLESS
+    // The dedicated server only needs the image data.
+    (void) mipmap;
+#else
     glGenTextures(1, &m_texture);
 
     bind();
@@ -29,13 +35,16 @@ Texture::Texture(std::string const& path, bool const mipmap)
         glGenerateMipmap(GL_TEXTURE_2D);
 
     RenderTools::unbind_texture();
+#endif
 
     utilities::Debug::log("Texture of " + m_path + " created.");
 }
 
 Texture::~Texture()
 {
+#ifndef AIRB_HEADLESS
     glDeleteTextures(1, &m_texture);
+#endif
 
     utilities::Debug::log("Texture of " + m_path + " destroyed.");
 }
@@ -2,7 +2,9 @@ namespace graphics {
 
 inline void Texture::bind() const
 {
+#ifndef AIRB_HEADLESS
     glBindTexture(GL_TEXTURE_2D, m_texture);
+#endif
 }
 
 inline graphics::Image& Texture::get_image()
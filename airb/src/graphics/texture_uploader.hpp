@@ -0,0 +1,47 @@
+#ifndef GRAPHICS_TEXTURE_UPLOADER_HPP
+#define GRAPHICS_TEXTURE_UPLOADER_HPP
+
+#include <utility>
+#include <vector>
+
+#include <glew.h>
+
+#include "../math/matrix.hpp"
+
+namespace graphics {
+
+// Position and dimensions of a rectangle of texels.
+using TextureArea = std::pair<math::Vector2i, math::Vector2i>;
+
+// Copies changed areas of a CPU-side image to wherever the image is
+// displayed. Kept separate from GL so that dirty-area tracking can run
+// without a context.
+class TextureUploader
+{
+public:
+             TextureUploader () = default;
+    virtual ~TextureUploader () = default;
+
+    TextureUploader            (TextureUploader const&) = delete;
+    TextureUploader& operator= (TextureUploader const&) = delete;
+
+    // image_data points to the first texel of the image, row_length is the
+    // image width in texels.
+    virtual void upload(std::vector<TextureArea> const& areas,
+                        GLubyte const* image_data, int const row_length) = 0;
+};
+
+// Discards uploads, for running without a GL context.
+class NullTextureUploader final : public TextureUploader
+{
+public:
+     NullTextureUploader() = default;
+    ~NullTextureUploader() = default;
+
+    void upload(std::vector<TextureArea> const&, GLubyte const*, int const) override
+    { }
+};
+
+} // namespace graphics
+
+#endif // GRAPHICS_TEXTURE_UPLOADER_HPP
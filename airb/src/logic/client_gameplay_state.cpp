@@ -1,5 +1,8 @@
 #include "client_gameplay_state.hpp"
 
+#include <cstdio>
+#include <cstring>
+
 #include "game.hpp"
 
 namespace logic {
@@ -31,6 +34,11 @@ ClientGameplayState::ClientGameplayState(Game& g,
     , m_host_quit(false)
     , m_waiting_for_players(true)
     , m_public_id(public_id)
+    , m_has_snapshot(false)
+    , m_latest_snapshot(0)
+    , m_snapshot_history()
+    , m_input_sequence(0)
+    , m_input_ticks()
     , m_socket(std::move(socket))
 {
     for (auto p : players)
@@ -41,22 +49,24 @@ ClientGameplayState::ClientGameplayState(Game& g,
     open_socket();
 
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    m_socket->send(network::UdpPacket(network::UDP_H_CONNECT | network::UDP_H_DATABLOCK, m_socket->get_client_id()));
+    m_socket->send(network::UdpPacket(network::UDP_H_CONNECT | network::UDP_H_OK));
     while (m_waiting_for_players)
     {
         process_udp_queue();
 
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
     }
+
+    // An empty input gives the server a tick to count its acks from before
+    // the first key is pressed
+    send_input(network::UDP_H_NULL, network::UDP_H_NULL);
 }
 
 ClientGameplayState::~ClientGameplayState()
 {
     m_socket->send(network::UdpPacket(
         network::UDP_H_CONNECT |
-        network::UDP_H_ERROR   |
-        network::UDP_H_DATABLOCK,
-        m_socket->get_client_id())
+        network::UDP_H_ERROR)
     );
     close_socket();
 }
@@ -108,7 +118,7 @@ void ClientGameplayState::update_player(std::chrono::milliseconds const dt)
 
     for (auto p : m_players)
     {
-        p->update(dt, m_terrain);
+        p->handle_input(dt);
     }
 }
 
@@ -177,7 +187,39 @@ void ClientGameplayState::drop_player(std::shared_ptr<network::Player> player)
                            m_players.end());
 }
 
-void ClientGameplayState::process_packet(network::UdpPacket packet)
+void ClientGameplayState::apply_snapshot(network::Snapshot const& snapshot)
+{
+    for (auto i = 0; i < snapshot.get_num_planes(); ++i)
+    {
+        auto const state = snapshot.get_plane(i);
+        if (state.public_id == m_public_id)
+        {
+            // The server applies an input on the tick it arrives and steers
+            // with it from the step after, which the local plane took on the
+            // tick the input was sent. Its count is raised after each step,
+            // so a state that has seen n ticks matches the step n - 2 ticks
+            // later than that.
+            network::InputAck ack;
+            if (!snapshot.get_input_ack(ack) ||
+                !m_player.reconcile(m_input_ticks[ack.sequence] + ack.ticks - 2,
+                                    state.position, state.rotation, state.velocity,
+                                    m_terrain))
+                m_player.set_state(state.position, state.rotation, state.velocity);
+            continue;
+        }
+        for (auto player : m_players)
+        {
+            if (player->get_public_id() != state.public_id)
+                continue;
+
+            player->get_plane().set_state(state.position, state.rotation, state.velocity);
+            player->set_cursor_position(state.cursor_position[X], state.cursor_position[Y]);
+            break;
+        }
+    }
+}
+
+void ClientGameplayState::process_packet(network::UdpPacket const& packet)
 {
     if (packet.header_contains(network::UDP_H_CONNECT) &&
         packet.header_contains(network::UDP_H_ERROR) &&
@@ -204,42 +246,6 @@ void ClientGameplayState::process_packet(network::UdpPacket packet)
         m_waiting_for_players = false;
         return;
     }
-    // Cursor sync
-    if (packet.header_contains(network::UDP_H_INPUT) &&
-        packet.header_contains(network::UDP_H_POS) &&
-        packet.header_contains(network::UDP_H_DATABLOCK))
-    {
-        if (m_players.size() == 0)
-            return;
-
-        char buffer[network::UDP_MAX_DATABLOCK_SIZE] = { '\0' };
-        auto data = packet.get_data_block();
-
-        auto id = data[0];
-
-        // cursor x
-        auto byte = 1;
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        auto x = static_cast<float>(atof(buffer));
-
-        // cursor y
-        byte++;
-        for (auto e = 0; buffer[e] != '\0'; e++) buffer[e] = '\0';
-        for (auto i = 0; data[byte] != '\0'; i++, byte++)
-            buffer[i] = data[byte];
-        auto y = static_cast<float>(atof(buffer));
-
-        for (auto player : m_players)
-        {
-            if (player->get_public_id() != id)
-                continue;
-
-            player->set_cursor_position(x, y);
-            break;
-        }
-        return;
-    }
     if (packet.header_contains(network::UDP_H_INPUT))
     {
         for (auto player : m_players)
@@ -252,30 +258,37 @@ void ClientGameplayState::process_packet(network::UdpPacket packet)
         }
         return;
     }
-    if (packet.header_contains(network::UDP_H_POS))
+    if (packet.header_contains(network::UDP_H_POS) &&
+        packet.header_contains(network::UDP_H_BINARY))
     {
-        if (packet.position_is(m_public_id))
-        {
-            m_player.process_packet(packet);
+        // Snapshots that reference a baseline we no longer hold are dropped
+        // without an ack; the server falls back to our last ack or a full
+        // snapshot.
+        network::Snapshot snapshot;
+        if (!snapshot.from_packet(packet, m_snapshot_history))
             return;
-        }
-        for (auto player : m_players)
-        {
-            if (!packet.position_is(player->get_public_id()))
-                continue;
 
-            player->process_packet(packet);
-            break;
-        }
+        m_snapshot_history.store(snapshot);
+        m_socket->send(network::Snapshot::make_ack(snapshot.get_sequence(), m_public_id));
+
+        if (m_has_snapshot && !network::sequence_newer(snapshot.get_sequence(), m_latest_snapshot))
+            return;
+
+        m_has_snapshot    = true;
+        m_latest_snapshot = snapshot.get_sequence();
+        apply_snapshot(snapshot);
         return;
     }
 }
 
 void ClientGameplayState::process_udp_queue()
 {
-    while (m_socket->has_packets())
+    network::UdpPacket batch[PACKET_BATCH_SIZE];
+    int n;
+    while ((n = m_socket->get_packets(batch, PACKET_BATCH_SIZE)) > 0)
     {
-        process_packet(m_socket->get_packet());
+        for (int i = 0; i < n; ++i)
+            process_packet(batch[i]);
     }
 }
 
@@ -308,10 +321,7 @@ void ClientGameplayState::update_pressed_keys()
 
     if (move   != network::UDP_H_NULL ||
         action != network::UDP_H_NULL)
-        m_socket->send(network::UdpPacket(network::UDP_H_INPUT  | network::UDP_H_DATABLOCK,
-                                         network::UDP_IN_PRESS | move,
-                                         network::UDP_IN_PRESS | action,
-                                         m_socket->get_client_id()));
+        send_input(network::UDP_IN_PRESS | move, network::UDP_IN_PRESS | action);
 }
 
 void ClientGameplayState::update_released_keys()
@@ -332,10 +342,15 @@ void ClientGameplayState::update_released_keys()
 
     if (move != network::UDP_H_NULL ||
         action != network::UDP_H_NULL)
-        m_socket->send(network::UdpPacket(network::UDP_H_INPUT | network::UDP_H_DATABLOCK,
-                                         move,
-                                         action,
-                                         m_socket->get_client_id()));
+        send_input(move, action);
+}
+
+// The sequence rides in the pos byte and comes back in the snapshot acks
+void ClientGameplayState::send_input(network::U8 const move, network::U8 const action)
+{
+    m_socket->send(network::UdpPacket(network::UDP_H_INPUT, move, action, m_input_sequence));
+    m_input_ticks[m_input_sequence] = m_player.get_tick();
+    ++m_input_sequence;
 }
 
 void ClientGameplayState::start_cursor_sync_routine()
@@ -343,7 +358,7 @@ void ClientGameplayState::start_cursor_sync_routine()
     m_cursor_sync_running = true;
     while (m_cursor_sync_running)
     {
-        while (m_socket->get_client_id()[0] == '\0')
+        while (m_socket->get_token() == network::NO_SESSION)
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(network::PING_FREQUENCY_MS / 4));
             if (!m_cursor_sync_running)
@@ -351,8 +366,7 @@ void ClientGameplayState::start_cursor_sync_routine()
         }
 
         char buffer[network::UDP_MAX_DATABLOCK_SIZE];
-        sprintf_s(buffer, "%s|%f|%f",
-                  m_socket->get_client_id(),
+        snprintf(buffer, sizeof buffer, "%f|%f",
                   m_mouse_world_position[X],
                   m_mouse_world_position[Y]);
         m_socket->send(network::UdpPacket(
@@ -3,17 +3,20 @@
 
 #include <chrono>
 #include <memory>
+#include <thread>
 
 #include "gameplay_state.hpp"
 #include "../network/player.hpp"
-#include "../network/socket/client_socket_win.hpp"
-#include "../utilities/async_queue.hpp"
+#include "../network/socket/client_socket.hpp"
+#include "../network/utilities/snapshot.hpp"
 
 namespace logic {
 
 class ClientGameplayState final : public GameplayState
 {
 private:
+    static int const PACKET_BATCH_SIZE = 32;
+
     std::thread           m_keepalive_thread;
     std::thread           m_listener_thread;
     std::thread           m_cursor_sync_thread;
@@ -21,10 +24,16 @@ private:
     bool                  m_host_quit;
     unsigned char         m_public_id;
     bool                  m_waiting_for_players;
+    bool                  m_has_snapshot;
+    unsigned short        m_latest_snapshot;
 
-    std::unique_ptr<network::ClientSocket> m_socket;
+    network::SnapshotBuffer m_snapshot_history;
 
-    utilities::AsyncQueue<network::UdpPacket> m_udp_queue;
+    // The local plane's tick each input went out on, by input sequence
+    network::U8           m_input_sequence;
+    long                  m_input_ticks[256];
+
+    std::unique_ptr<network::ClientSocket> m_socket;
 
 public:
      ClientGameplayState(Game& g,
@@ -48,13 +57,15 @@ private:
 
     void update_pressed_keys ();
     void update_released_keys();
+    void send_input          (network::U8 const move, network::U8 const action);
 
     void open_socket ();
     void close_socket();
 
     void add_player       (network::Connection conn);
     void drop_player      (std::shared_ptr<network::Player> player);
-    void process_packet   (network::UdpPacket packet);
+    void apply_snapshot   (network::Snapshot const& snapshot);
+    void process_packet   (network::UdpPacket const& packet);
     void process_udp_queue();
 
     void start_cursor_sync_routine();
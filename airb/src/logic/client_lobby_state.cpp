@@ -99,9 +99,7 @@ ClientLobbyState::~ClientLobbyState()
     if (m_socket != nullptr)
     {
         m_socket->send(network::UdpPacket(network::UDP_H_CONNECT |
-                                          network::UDP_H_ERROR |
-                                          network::UDP_H_DATABLOCK,
-                                          m_socket->get_client_id()));
+                                          network::UDP_H_ERROR));
         close_socket();
     }
 
@@ -299,11 +297,10 @@ void ClientLobbyState::drop_player(std::shared_ptr<network::Connection> player)
                                m_connections.end());
 }
 
-void ClientLobbyState::process_packet(network::UdpPacket packet)
+void ClientLobbyState::process_packet(network::UdpPacket const& packet)
 {
     if (packet.header_contains(network::UDP_H_CONNECT) &&
         packet.header_contains(network::UDP_H_OK) &&
-        packet.header_contains(network::UDP_H_DATABLOCK) &&
         packet.header_contains(network::UDP_H_POS))
     {
         // Host accept connection
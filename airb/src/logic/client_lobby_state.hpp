@@ -2,15 +2,15 @@
 #define LOGIC_CLIENT_LOBBY_STATE_HPP
 
 #include <memory>
+#include <thread>
 
 #include "state.hpp"
 #include "../graphics/sprite.hpp"
 #include "../graphics/texture.hpp"
-#include "../network/socket/client_socket_win.hpp"
+#include "../network/socket/client_socket.hpp"
 #include "../network/connection.hpp"
 #include "../ui/button.hpp"
 #include "../ui/input_field.hpp"
-#include "../utilities/async_queue.hpp"
 
 namespace network {
 
@@ -50,7 +50,6 @@ private:
     std::unique_ptr<network::ClientSocket> m_socket;
 
     std::vector<std::shared_ptr<network::Connection>> m_connections;
-    utilities::AsyncQueue<std::pair<network::UdpPacket, sockaddr_in>> m_udp_queue;
 
     audio::Music& m_music;
 
@@ -77,7 +76,7 @@ private:
                            unsigned char const pos,
                            std::string const name);
     void drop_player      (std::shared_ptr<network::Connection> player);
-    void process_packet   (network::UdpPacket packet);
+    void process_packet   (network::UdpPacket const& packet);
     void process_udp_queue();
 };
 
@@ -0,0 +1,322 @@
+#include "dedicated_server.hpp"
+
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+#include "../network/utilities/udp_packet.hpp"
+#include "../physics/collision.hpp"
+#include "../utilities/debug.hpp"
+#include "../utilities/spawn_point.hpp"
+
+namespace logic {
+
+namespace
+{
+    math::Vector2i const PLANE_TEXTURE_POSITION({ graphics::PLANE_OFFSET_X,
+                                                  graphics::PLANE_OFFSET_Y });
+    math::Vector2i const PLANE_TEXTURE_DIMENSIONS({ graphics::PLANE_DIMENSIONS,
+                                                    graphics::PLANE_DIMENSIONS });
+
+    // Same world size the rendered states give planes (a tenth of the
+    // 1920 px target width); colliders depend on it.
+    math::Vector2i const PLANE_DIMENSIONS(math::Vector2i::one() * 192);
+
+    math::Vector2f const AI_SPAWN_POSITION(math::Vector2f::one() * 900.0f);
+
+    // The colliders below are laid out around this point
+    math::Vector2f const COLLIDER_ORIGIN(math::Vector2f::one() * 900.0f);
+
+    std::vector<physics::BoxCollider> make_plane_colliders()
+    {
+        return std::vector<physics::BoxCollider>
+        {
+            physics::BoxCollider(std::vector<math::Vector2f>
+            {
+                math::Vector2f({ 879.0f, 991.0f }),
+                math::Vector2f({ 905.0f, 991.0f }),
+                math::Vector2f({ 905.0f, 812.0f }),
+                math::Vector2f({ 879.0f, 812.0f })
+            }),
+            physics::BoxCollider(std::vector<math::Vector2f>
+            {
+                math::Vector2f({ 819.0f, 916.0f }),
+                math::Vector2f({ 916.0f, 916.0f }),
+                math::Vector2f({ 916.0f, 879.0f }),
+                math::Vector2f({ 819.0f, 879.0f })
+            })
+        };
+    }
+}
+
+DedicatedServer::DedicatedServer(graphics::Textures const lvl_id, std::string const& lvl_tex_path,
+                                 std::uint64_t const seed, int const num_workers)
+    : GameWorld (seed)
+
+    , m_level_id (lvl_id)
+
+    , m_texture_holder ()
+
+    , m_level_image      (lvl_tex_path)
+    , m_terrain_uploader ()
+    , m_terrain          (m_level_image, m_terrain_uploader)
+    , m_plane_grid       (m_terrain.get_dimensions())
+
+    , m_ai          (nullptr)
+    , m_pilots      ()
+    , m_jobs        (num_workers)
+    , m_projectiles (*this, m_jobs)
+
+    , m_recorder (nullptr)
+
+    , m_running (false)
+    , m_tick    (0)
+{
+    // Planes keep sprites of the gameplay elements, so the image is still
+    // loaded even though nothing is drawn.
+    m_texture_holder.load(
+        graphics::Textures::GAMEPLAY_ELEMENTS,
+        std::make_unique<graphics::Texture>("res/textures/gameplay_elements.tga")
+    );
+
+    m_ai = std::make_unique<entities::AiPlane>(
+        1.0f, 50000.0f, 1.75f,
+        make_plane_colliders(),
+        1000.0f, 40.0f,
+        m_texture_holder,
+        this,
+        m_texture_holder.get(graphics::Textures::GAMEPLAY_ELEMENTS),
+        PLANE_TEXTURE_POSITION, PLANE_TEXTURE_DIMENSIONS,
+        PLANE_DIMENSIONS,
+        AI_SPAWN_POSITION,
+        m_terrain
+    );
+
+    utilities::Debug::log("Dedicated server created for " + lvl_tex_path
+                          + " with seed " + std::to_string(seed) + ".");
+}
+
+void DedicatedServer::run()
+{
+    auto next_tick = std::chrono::steady_clock::now();
+
+    m_running = true;
+    while (m_running)
+    {
+        tick(TICK_DURATION);
+
+        next_tick += TICK_DURATION;
+        auto const now = std::chrono::steady_clock::now();
+        if (next_tick > now)
+            std::this_thread::sleep_until(next_tick);
+        else
+            next_tick = now; // Fell behind, do not try to catch up in a burst
+    }
+}
+
+void DedicatedServer::stop()
+{
+    m_running = false;
+}
+
+void DedicatedServer::tick(std::chrono::milliseconds const dt)
+{
+    update_planes(dt);
+    update_ai(dt);
+    update_pilots(dt);
+    update_projectiles(dt);
+
+    m_terrain.update();
+    ++m_tick;
+
+    if (m_recorder)
+        m_recorder->record_tick(*this);
+}
+
+void DedicatedServer::start_recording(std::string const& path)
+{
+    if (m_tick != 0 || !m_pilots.empty())
+        throw std::logic_error("Recording has to start before the match does.");
+
+    m_recorder = std::make_unique<ReplayRecorder>(path, m_level_id, get_seed());
+    utilities::Debug::log("Recording the match to " + path + ".");
+}
+
+int DedicatedServer::add_pilot()
+{
+    auto const& spawn = utilities::SPAWN_POINTS[m_level_id][m_pilots.size() % utilities::NUM_SPAWN_POINTS];
+
+    Pilot p;
+    p.plane           = make_plane(spawn.position);
+    p.cursor_position = spawn.position;
+    m_pilots.push_back(std::move(p));
+
+    if (m_recorder)
+        m_recorder->record_pilot();
+
+    return static_cast<int>(m_pilots.size()) - 1;
+}
+
+void DedicatedServer::set_cursor_position(int const pilot, math::Vector2f const& pos)
+{
+    m_pilots[pilot].cursor_position = pos;
+
+    if (m_recorder)
+        m_recorder->record_cursor(pilot, pos);
+}
+
+void DedicatedServer::process_input(int const pilot, std::uint8_t const move, std::uint8_t const action)
+{
+    // Same path ServerGameplayState takes for a client's input packet
+    m_pilots[pilot].plane->process_packet(network::UdpPacket(network::UDP_H_INPUT, move, action,
+                                                             network::U8(0)));
+
+    if (m_recorder)
+        m_recorder->record_input(pilot, move, action);
+}
+
+entities::UncontrollablePlane& DedicatedServer::get_plane(int const pilot)
+{
+    return *m_pilots[pilot].plane;
+}
+
+math::Vector2f const& DedicatedServer::get_cursor_position(int const pilot) const
+{
+    return m_pilots[pilot].cursor_position;
+}
+
+entities::Plane& DedicatedServer::get_indexed_plane(int const i)
+{
+    return i == 0 ? static_cast<entities::Plane&>(*m_ai) : *m_pilots[i - 1].plane;
+}
+
+void DedicatedServer::add_explosion(math::Vector2f const& pos, int const type)
+{
+    // Explosions are purely visual; terrain damage is applied by the
+    // projectile itself.
+    (void) pos;
+    (void) type;
+}
+
+void DedicatedServer::add_projectile(math::Vector2f const& pos, math::Vector2f const& dir,
+                                     std::chrono::milliseconds const proj_lifetime,
+                                     float const spd, int const bullet_type, int const dmg)
+{
+    m_projectiles.spawn(pos, dir * spd, proj_lifetime, bullet_type, dmg);
+}
+
+std::unique_ptr<entities::UncontrollablePlane> DedicatedServer::make_plane(math::Vector2f const& pos)
+{
+    // Built where its colliders are and then moved, so they come along; a
+    // client predicting the plane starts out the same way
+    auto plane = std::make_unique<entities::UncontrollablePlane>(
+        1.0f, 50000.0f, 1.75f,
+        make_plane_colliders(),
+        1000.0f, 40.0f,
+        m_texture_holder,
+        this,
+        m_texture_holder.get(graphics::Textures::GAMEPLAY_ELEMENTS),
+        PLANE_TEXTURE_POSITION, PLANE_TEXTURE_DIMENSIONS,
+        PLANE_DIMENSIONS,
+        COLLIDER_ORIGIN
+    );
+    plane->set_state(pos, plane->get_rotation(), math::Vector2f::zero());
+    return plane;
+}
+
+void DedicatedServer::update_planes(std::chrono::milliseconds const dt)
+{
+    // A plane step only reads the terrain and writes the plane itself, so
+    // every plane gets its own job; index 0 is the AI
+    m_jobs.parallel_for(get_num_planes(), 1, [this, dt](int const begin, int const end)
+    {
+        for (int i = begin; i < end; ++i)
+            get_indexed_plane(i).update(dt, m_terrain);
+    });
+}
+
+void DedicatedServer::update_ai(std::chrono::milliseconds const dt)
+{
+    // Chase the closest pilot; with nobody connected aim far outside the
+    // level so the AI keeps patrolling without firing.
+    math::Vector2f const& ai_pos = m_ai->get_rigid_body().get_position();
+    math::Vector2f target(math::Vector2f::one() * -std::numeric_limits<float>::max());
+    float closest = std::numeric_limits<float>::max();
+    for (auto const& p : m_pilots)
+    {
+        math::Vector2f const pos = p.plane->get_position();
+        float const dist = (pos - ai_pos).magnitude();
+        if (dist < closest)
+        {
+            closest = dist;
+            target  = pos;
+        }
+    }
+    m_ai->update_behavior(target, dt);
+}
+
+void DedicatedServer::update_pilots(std::chrono::milliseconds const dt)
+{
+    for (auto& p : m_pilots)
+    {
+        p.plane->handle_input(p.cursor_position, dt);
+        p.plane->reset_frame();
+    }
+
+    for (size_t i = 0; i < m_pilots.size(); ++i)
+        for (size_t k = i + 1; k < m_pilots.size(); ++k)
+        {
+            auto& a = m_pilots[i].plane->get_rigid_body();
+            auto& b = m_pilots[k].plane->get_rigid_body();
+            for (int ja = 0; ja < 2; ++ja)
+                for (int jb = 0; jb < 2; ++jb)
+                {
+                    physics::Collision coll = a.get_collider()[ja].check_collision(b.get_collider()[jb]);
+                    if (coll.get_mtv()[X] == 0 && coll.get_mtv()[Y] == 0)
+                        continue;
+
+                    math::Vector2f const normal = coll.get_mtv().normalized();
+                    math::Vector2f const point  = coll.get_collider() == 1
+                                                ? a.find_point_of_impact(normal)
+                                                : b.find_point_of_impact(normal);
+                    a.resolve_collision(normal, point, b);
+                    a.correct_positions(coll.get_mtv(), dt, b, m_terrain);
+                }
+        }
+}
+
+void DedicatedServer::update_projectiles(std::chrono::milliseconds const dt)
+{
+    // Planes have moved for this tick; only projectiles sharing a grid
+    // cell with a plane reach the narrow phase below.
+    m_plane_grid.clear();
+    for (size_t i = 0; i < m_pilots.size(); ++i)
+        m_plane_grid.insert(static_cast<int>(i), m_pilots[i].plane->get_rigid_body());
+
+    m_projectiles.update(dt, m_terrain);
+
+    // Backwards, since a hit swaps the last projectile into its slot
+    for (int p = m_projectiles.size() - 1; p >= 0; --p)
+    {
+        math::Vector2f const pos = m_projectiles.get_position(p);
+        for (int const i : m_plane_grid.query(pos))
+        {
+            auto& plane = *m_pilots[i].plane;
+            bool hit = false;
+            for (int j = 0; j < 2 && !hit; ++j)
+            {
+                math::Vector2f const coll = plane.get_rigid_body().get_collider()[j].check_collision(pos);
+                if (coll[X] == 0 && coll[Y] == 0)
+                    continue;
+
+                plane.take_damage(m_projectiles.get_damage(p));
+                m_projectiles.hit(p, coll, plane.get_health().value > 0);
+                hit = true;
+            }
+            if (hit)
+                break;
+        }
+    }
+}
+
+} // namespace logic
@@ -0,0 +1,109 @@
+#ifndef LOGIC_DEDICATED_SERVER_HPP
+#define LOGIC_DEDICATED_SERVER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "game_world.hpp"
+#include "replay.hpp"
+#include "../entities/ai_plane.hpp"
+#include "../entities/level_terrain.hpp"
+#include "../entities/projectile_system.hpp"
+#include "../entities/uncontrollable_plane.hpp"
+#include "../graphics/image.hpp"
+#include "../graphics/texture.hpp"
+#include "../graphics/texture_uploader.hpp"
+#include "../math/matrix.hpp"
+#include "../physics/spatial_grid.hpp"
+#include "../utilities/job_system.hpp"
+#include "../utilities/resource_holder.hpp"
+
+namespace logic {
+
+// Authoritative match simulation without a window, renderer or audio.
+// Runs planes, projectiles, terrain destruction and the AI at a fixed
+// tick; built into the airb_server target.
+class DedicatedServer final : public GameWorld
+{
+private:
+    struct Pilot
+    {
+        std::unique_ptr<entities::UncontrollablePlane> plane;
+        math::Vector2f                                 cursor_position;
+    };
+
+    graphics::Textures const m_level_id;
+
+    utilities::ResourceHolder<graphics::Texture, graphics::Textures> m_texture_holder;
+
+    graphics::Image               m_level_image;
+    graphics::NullTextureUploader m_terrain_uploader;
+    entities::LevelTerrain        m_terrain;
+    physics::SpatialGrid          m_plane_grid;
+
+    std::unique_ptr<entities::AiPlane> m_ai;
+    std::vector<Pilot>                 m_pilots;
+    utilities::JobSystem               m_jobs;
+    entities::ProjectileSystem         m_projectiles;
+
+    std::unique_ptr<ReplayRecorder> m_recorder;
+
+    bool          m_running;
+    unsigned long m_tick;
+
+public:
+    // num_workers is handed to the job system; a server sharing its
+    // thread with other matches uses none and steps everything inline
+     DedicatedServer(graphics::Textures const lvl_id, std::string const& lvl_tex_path,
+                     std::uint64_t const seed,
+                     int const num_workers = utilities::JobSystem::default_num_workers());
+    ~DedicatedServer() = default;
+
+    DedicatedServer            (DedicatedServer const&) = delete;
+    DedicatedServer& operator= (DedicatedServer const&) = delete;
+
+    void run  ();
+    void stop ();
+    void tick (std::chrono::milliseconds const dt);
+
+    // Records the match from here on; only possible before the first
+    // pilot joins and the first tick runs
+    void start_recording (std::string const& path);
+
+    int  add_pilot           ();
+    void set_cursor_position (int const pilot, math::Vector2f const& pos);
+    // Move and action bytes of a client input packet (UDP_IN_*)
+    void process_input       (int const pilot, std::uint8_t const move, std::uint8_t const action);
+
+    entities::UncontrollablePlane& get_plane(int const pilot);
+    math::Vector2f const&          get_cursor_position(int const pilot) const;
+    // Index 0 is the AI, pilots follow in the order they joined
+    entities::Plane&               get_indexed_plane(int const i);
+
+    void add_explosion  (math::Vector2f const& pos, int const type) override;
+    void add_projectile (math::Vector2f const& pos, math::Vector2f const& dir,
+                         std::chrono::milliseconds const proj_lifetime,
+                         float const spd, int const bullet_type, int const dmg) override;
+
+    inline unsigned long                 get_tick       () const;
+    inline int                           get_num_pilots () const;
+    inline int                           get_num_planes () const;
+    inline entities::LevelTerrain const& get_terrain    () const;
+
+private:
+    std::unique_ptr<entities::UncontrollablePlane> make_plane(math::Vector2f const& pos);
+
+    void update_planes      (std::chrono::milliseconds const dt);
+    void update_ai          (std::chrono::milliseconds const dt);
+    void update_pilots      (std::chrono::milliseconds const dt);
+    void update_projectiles (std::chrono::milliseconds const dt);
+};
+
+} // namespace logic
+
+#include "dedicated_server.inl"
+
+#endif // LOGIC_DEDICATED_SERVER_HPP
@@ -0,0 +1,23 @@
+namespace logic {
+
+inline unsigned long DedicatedServer::get_tick() const
+{
+    return m_tick;
+}
+
+inline int DedicatedServer::get_num_pilots() const
+{
+    return static_cast<int>(m_pilots.size());
+}
+
+inline int DedicatedServer::get_num_planes() const
+{
+    return 1 + get_num_pilots();
+}
+
+inline entities::LevelTerrain const& DedicatedServer::get_terrain() const
+{
+    return m_terrain;
+}
+
+} // namespace logic
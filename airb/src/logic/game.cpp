@@ -1,5 +1,6 @@
 #include "game.hpp"
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <thread>
@@ -7,6 +8,7 @@
 #include <GLFW/glfw3.h>
 
 #include "aftermatch_state.hpp"
+#include "game_world.hpp"
 #include "gameplay_state.hpp"
 #include "client_gameplay_state.hpp"
 #include "server_gameplay_state.hpp"
@@ -24,6 +26,10 @@ namespace
 {
     auto const FRAME_RATE = 300;
     auto const FRAME_TIME = std::chrono::nanoseconds(1000000000L / FRAME_RATE);
+
+    // Longest stretch of real time simulated in one frame; anything beyond
+    // it (a hitch, a breakpoint) is dropped instead of caught up on.
+    auto const MAX_FRAME_DURATION = std::chrono::nanoseconds(std::chrono::milliseconds(250));
 }
 
 Game::Game()
@@ -49,6 +55,7 @@ Game::Game()
 
     , m_current_time  ()
     , m_previous_time ()
+    , m_accumulator   (0)
 {
 
     m_texture_holder.load(
@@ -121,34 +128,43 @@ Game::Game()
 
 void Game::run()
 {
-    m_previous_time = std::chrono::high_resolution_clock::now();
+    reset_time();
     m_running = true;
 
     while (m_running && m_window.is_open())
     {
-        auto const start_t = std::chrono::high_resolution_clock::now();
+        auto const start_t = std::chrono::steady_clock::now();
         auto const end_t   = start_t + FRAME_TIME;
 
-        // Reset input
-        m_window.keyboard.reset_frame();
-        m_window.mouse.reset_frame();
-
         // Poll events
         glfwPollEvents();
 
-        // Update game state
-        m_current_time = std::chrono::high_resolution_clock::now();
-        auto const dt  = std::chrono::duration_cast<std::chrono::milliseconds>(
-            m_current_time - m_previous_time
-        );
-        m_states.top()->update(dt);
+        // Update game state in fixed steps, the remainder carries over to
+        // the next frame
+        m_current_time = std::chrono::steady_clock::now();
+        m_accumulator += std::min<std::chrono::nanoseconds>(m_current_time - m_previous_time,
+                                                            MAX_FRAME_DURATION);
         m_previous_time = m_current_time;
 
+        while (m_running && m_accumulator >= TICK_DURATION)
+        {
+            m_accumulator -= TICK_DURATION;
+            m_states.top()->update(TICK_DURATION);
+
+            // Reset input; presses are seen by the first step only, and kept
+            // for the next frame if no step ran in this one
+            m_window.keyboard.reset_frame();
+            m_window.mouse.reset_frame();
+        }
+
         // Update audio
         m_audio_manager.update();
 
-        // Render game state
+        // Render game state between the last two steps
+        float const alpha = static_cast<float>(m_accumulator.count())
+                          / static_cast<float>(std::chrono::nanoseconds(TICK_DURATION).count());
         graphics::RenderTools::clear_screen();
+        m_states.top()->interpolate(alpha);
         m_states.top()->render();
         m_window.swap_buffers();
 
@@ -242,8 +258,9 @@ void Game::reset_graphics()
 
 void Game::reset_time()
 {
-    m_previous_time = std::chrono::high_resolution_clock::now();
+    m_previous_time = std::chrono::steady_clock::now();
     m_current_time  = m_previous_time;
+    m_accumulator   = std::chrono::nanoseconds::zero();
 }
 
 void Game::update_fps()
@@ -21,8 +21,8 @@
 #include "../ui/font_renderer.hpp"
 #include "../math/matrix.hpp"
 #include "../network/connection.hpp"
-#include "../network/socket/client_socket_win.hpp"
-#include "../network/socket/server_socket_win.hpp"
+#include "../network/socket/client_socket.hpp"
+#include "../network/socket/server_socket.hpp"
 #include "../utilities/font_holder.hpp"
 #include "../utilities/resource_holder.hpp"
 
@@ -56,6 +56,7 @@ private:
 
     std::chrono::time_point<std::chrono::steady_clock> m_current_time;
     std::chrono::time_point<std::chrono::steady_clock> m_previous_time;
+    std::chrono::nanoseconds                           m_accumulator;
 
 public:
      Game();
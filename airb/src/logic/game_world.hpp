@@ -0,0 +1,50 @@
+#ifndef LOGIC_GAME_WORLD_HPP
+#define LOGIC_GAME_WORLD_HPP
+
+#include <chrono>
+#include <cstdint>
+
+#include "../math/matrix.hpp"
+#include "../utilities/random.hpp"
+
+namespace logic {
+
+// Length of one simulation step. The rendered states and the dedicated
+// server both advance the world in steps of exactly this size, so physics
+// results do not depend on the frame rate. Entities take whole
+// milliseconds, 8 ms is the closest to 120 Hz.
+std::chrono::milliseconds const TICK_DURATION(8);
+
+// The part of a match that entities call back into. Implemented both by
+// the rendered gameplay states and by the headless dedicated server, so
+// entity code does not depend on graphics, audio or input.
+//
+// Every random choice of the simulation is drawn from the match generator
+// here, so a match replayed from its seed and inputs takes the same course.
+class GameWorld
+{
+private:
+    utilities::Random m_random;
+    std::uint64_t     m_seed;
+
+public:
+    explicit GameWorld(std::uint64_t const seed);
+    virtual ~GameWorld() = default;
+
+    GameWorld            (GameWorld const&) = delete;
+    GameWorld& operator= (GameWorld const&) = delete;
+
+    virtual void add_explosion  (math::Vector2f const& pos, int const type) = 0;
+    virtual void add_projectile (math::Vector2f const& pos, math::Vector2f const& dir,
+                                 std::chrono::milliseconds const proj_lifetime,
+                                 float const spd, int const bullet_type, int const dmg) = 0;
+
+    inline utilities::Random& get_random ();
+    inline std::uint64_t      get_seed   () const;
+};
+
+} // namespace logic
+
+#include "game_world.inl"
+
+#endif // LOGIC_GAME_WORLD_HPP
@@ -0,0 +1,18 @@
+namespace logic {
+
+inline GameWorld::GameWorld(std::uint64_t const seed)
+    : m_random (seed)
+    , m_seed   (seed)
+{ }
+
+inline utilities::Random& GameWorld::get_random()
+{
+    return m_random;
+}
+
+inline std::uint64_t GameWorld::get_seed() const
+{
+    return m_seed;
+}
+
+} // namespace logic
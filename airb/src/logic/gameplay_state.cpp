@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <string>
 
 #include <GLFW/glfw3.h>
 
@@ -11,6 +12,7 @@
 #include "../ui/font.hpp"
 #include "../math/general.hpp"
 #include "../physics/collision.hpp"
+#include "../utilities/debug.hpp"
 
 namespace logic {
 
@@ -25,6 +27,10 @@ namespace
                                                   graphics::PLANE_OFFSET_Y });
     math::Vector2i const PLANE_TEXTURE_DIMENSIONS({ graphics::PLANE_DIMENSIONS,
                                                     graphics::PLANE_DIMENSIONS });
+    math::Vector2i const PROJECTILE_TEXTURE_POSITION({ graphics::PROJECTILE_OFFSET_X,
+                                                       graphics::PROJECTILE_OFFSET_Y });
+    math::Vector2i const PROJECTILE_TEXTURE_DIMENSIONS({ graphics::PROJECTILE_DIMENSIONS,
+                                                         graphics::PROJECTILE_DIMENSIONS });
     math::Vector2i const EXPLOSION_TEXTURE_POSITION({ graphics::EXPLOSION_OFFSET_X,
                                                       graphics::EXPLOSION_OFFSET_Y });
     math::Vector2i const EXPLOSION_TEXTURE_DIMENSIONS({ graphics::EXPLOSION_DIMENSIONS,
@@ -32,7 +38,8 @@ namespace
 }
 
 GameplayState::GameplayState(Game& g, graphics::Textures const lvl_id)
-    : State (g)
+    : State     (g)
+    , GameWorld (utilities::Random::make_seed())
 
     , m_level_id (lvl_id)
 
@@ -78,7 +85,9 @@ GameplayState::GameplayState(Game& g, graphics::Textures const lvl_id)
                                    math::Vector2i::one() * Game::TARGET_DIMENSIONS[X] / 10,
                                    math::Vector2f::one() * 900.0f, //spawn_point
                                    m_terrain)
-    , m_terrain                   (m_level_texture)
+    , m_terrain_uploader          (m_level_texture)
+    , m_terrain                   (m_level_texture.get_image(), m_terrain_uploader)
+    , m_plane_grid                (m_terrain.get_dimensions())
 
     , m_terrain_dimensions (math::Vector2i({ m_level_texture.get_dimensions()[X],
                                              m_level_texture.get_dimensions()[Y] / 2 }))
@@ -96,9 +105,17 @@ GameplayState::GameplayState(Game& g, graphics::Textures const lvl_id)
                             * m_crosshair_texture.get_dimensions()[X]
                             * Game::TARGET_DIMENSIONS[X] / m_window.get_dimensions()[X],
                             math::Vector2f::one() * 0.5f)
+    , m_projectile_sprite  (m_gameplay_elements_texture,
+                            PROJECTILE_TEXTURE_POSITION, PROJECTILE_TEXTURE_DIMENSIONS,
+                            math::Vector2i::zero(), PROJECTILE_TEXTURE_DIMENSIONS / 4,
+                            math::Vector2f({ 0.5f, 0.5f }))
 
     , m_camera_position      (math::Vector2f::zero())
     , m_mouse_world_position (math::Vector2f::zero())
+    , m_interpolation_alpha  (1.0f)
+
+    , m_jobs        ()
+    , m_projectiles (*this, m_jobs)
 
     , m_hud_font           (nullptr)
     , m_kill_notifications (nullptr)
@@ -129,6 +146,8 @@ GameplayState::GameplayState(Game& g, graphics::Textures const lvl_id)
     )
     #undef THEME
 {
+    utilities::Debug::log("Match seed " + std::to_string(get_seed()) + ".");
+
     m_font_holder.load(
         ui::Fonts::BASIC_SANS, HUD_FONT_SIZE,
         std::make_unique<ui::Font>(
@@ -140,8 +159,7 @@ GameplayState::GameplayState(Game& g, graphics::Textures const lvl_id)
 
     m_hud_font = &m_font_holder.get(ui::Fonts::BASIC_SANS, HUD_FONT_SIZE);
 
-    init_explosion_pool  ();
-    init_projectile_pool ();
+    init_explosion_pool();
 
     m_font_holder.load(
         ui::Fonts::BASIC_SANS, SCOREBOARD_TITLE_FONT_SIZE,
@@ -227,26 +245,7 @@ void GameplayState::add_projectile(math::Vector2f const& pos, math::Vector2f con
                                    std::chrono::milliseconds const proj_lifetime,
                                    float const spd, int const bullet_type, int const dmg)
 {
-    size_t i = bullet_type < 1 ? 512 : 0;
-    size_t size = m_projectiles.size();
-    while (i < size && m_projectiles[i]->is_active())
-        ++i;
-
-    auto& proj = m_projectiles[i];
-
-    proj->activate();
-    proj->reset_elapsed_time();
-    proj->set_lifetime(proj_lifetime);
-    proj->set_type(bullet_type);
-    proj->set_damage(dmg);
-    proj->set_source_position(
-       math::Vector2i({
-           graphics::PROJECTILE_OFFSET_X,
-           graphics::PROJECTILE_OFFSET_Y + bullet_type * graphics::PROJECTILE_DIMENSIONS
-        })
-    );
-    proj->set_position(pos);
-    proj->set_velocity(dir * spd);
+    m_projectiles.spawn(pos, dir * spd, proj_lifetime, bullet_type, dmg);
 
     auto& snd = m_fire_sounds[bullet_type];
     auto hndl = snd->play();
@@ -276,7 +275,11 @@ void GameplayState::update(std::chrono::milliseconds const dt)
     else
         m_show_scoreboard = false;
 
-    update_ai(dt, m_terrain);
+    // The local pilot steers before the physics step, the AI and remote
+    // pilots react to where it left them
+    m_player.handle_input(m_keyboard, m_mouse, m_mouse_world_position, dt);
+    update_planes(dt);
+    update_ai(dt);
     update_player(dt);
 
     for (unsigned i = 0; i < m_players.size(); ++i)
@@ -315,33 +318,42 @@ void GameplayState::update(std::chrono::milliseconds const dt)
         if (e->is_active())
             e->update(dt);
 
-    for (auto& p : m_projectiles)
-        if (p->is_active())
+    m_plane_grid.clear();
+    for (unsigned i = 0; i < m_players.size(); ++i)
+        m_plane_grid.insert(i, m_players[i]->get_rigid_body());
+
+    m_projectiles.update(dt, m_terrain);
+
+    // Backwards, since a hit swaps the last projectile into its slot
+    for (int p = m_projectiles.size() - 1; p >= 0; --p)
+    {
+        math::Vector2f const pos = m_projectiles.get_position(p);
+        bool hit = false;
+        for (int const i : m_plane_grid.query(pos))
         {
-            p->update(dt, m_terrain);
-            for (unsigned i = 0; i < m_players.size(); ++i)
+            for (int j = 0; j < 2 && !hit; ++j)
             {
-                for (int j = 0; j < 2; ++j)
+                math::Vector2f coll = m_players[i]->get_rigid_body().get_collider()[j].check_collision(pos);
+                if (coll[X] != 0 || coll[Y] != 0)
                 {
-                    math::Vector2f coll = p->check_collision(m_players[i]->get_rigid_body().get_collider()[j]);
-                    if (coll[X] != 0 || coll[Y] != 0)
+                    m_players[i]->get_plane().take_damage(m_projectiles.get_damage(p));
+                    bool show_explosion = 1;
+                    if (m_players[i]->get_plane().get_health().value <= 0)
                     {
-                        m_players[i]->get_plane().take_damage(p->get_damage());
-                        bool show_explosion = 1;
-                        if (m_players[i]->get_plane().get_health().value <= 0)
-                        {
-                            add_explosion(m_players[i]->get_plane().get_position(), 3);
-                            show_explosion = 0;
-                        }
-                        p->resolve_collision(coll, show_explosion);
-                        break;
+                        add_explosion(m_players[i]->get_plane().get_position(), 3);
+                        show_explosion = 0;
                     }
+                    m_projectiles.hit(p, coll, show_explosion);
+                    hit = true;
                 }
             }
+            if (hit)
+                break;
         }
+    }
 
     update_terrain();
-    update_transform();
+    update_transform(m_player.get_rigid_body().get_position());
     update_crosshair(dt);
 }
 
@@ -356,9 +368,20 @@ void GameplayState::render()
         if (s->is_active())
             m_batch_renderer.submit(*s);
 
-    for (auto& p : m_projectiles)
-        if (p->is_active())
-            m_batch_renderer.submit(p->get_sprite());
+    // One sprite is reused for every projectile; submit copies it
+    for (int i = 0; i < m_projectiles.size(); ++i)
+    {
+        m_projectile_sprite.set_source_position(
+            math::Vector2i({
+                graphics::PROJECTILE_OFFSET_X,
+                graphics::PROJECTILE_OFFSET_Y + m_projectiles.get_type(i) * graphics::PROJECTILE_DIMENSIONS
+            })
+        );
+        m_projectile_sprite.set_position(
+            math::Vector2i(m_projectiles.get_interpolated_position(i, m_interpolation_alpha))
+        );
+        m_batch_renderer.submit(m_projectile_sprite);
+    }
     m_batch_renderer.submit(m_player.get_weapon_sprite());
     m_batch_renderer.submit(m_ai.get_weapon_sprite());
     m_batch_renderer.submit(m_crosshair_sprite);
@@ -379,19 +402,29 @@ void GameplayState::render()
         m_scoreboard->render(m_font_renderer);
 }
 
-void GameplayState::update_ai(std::chrono::milliseconds const dt, entities::LevelTerrain& terr)
+void GameplayState::interpolate(float const alpha)
 {
-    math::Vector2f cursor_pos = m_window.mouse.get_cursor_position();
-    m_ai.handle_input(cursor_pos, m_keyboard, m_mouse, m_mouse_world_position, dt);
-    m_ai.update(dt, terr);
+    m_player.interpolate(alpha);
+    m_ai.interpolate(alpha);
+    for (auto& p : m_players)
+        p->get_plane().interpolate(alpha);
+    m_interpolation_alpha = alpha;
+
+    // Follow the drawn plane rather than the simulated one so it does not
+    // jitter against the camera
+    update_transform(m_player.get_interpolated_position(alpha));
+    m_crosshair_sprite.set_position(math::Vector2i(m_mouse_world_position));
+}
+
+void GameplayState::update_ai(std::chrono::milliseconds const dt)
+{
+    if (m_mouse.was_button_pressed(GLFW_MOUSE_BUTTON_2))
+        m_ai.set_goal(m_mouse_world_position);
     m_ai.update_behavior(m_player.get_rigid_body().get_position(), dt);
 }
 
 void GameplayState::update_player(std::chrono::milliseconds const dt)
 {
-    m_player.handle_input(m_keyboard, m_mouse, m_mouse_world_position, dt);
-    m_player.update(dt, m_terrain);
-
     auto& health = m_player.get_health();
     int curr_health = static_cast<int>(
         static_cast<float>(health.value) / static_cast<float>(health.max_value) * 100.0f
@@ -432,20 +465,37 @@ void GameplayState::update_player(std::chrono::milliseconds const dt)
     }
 }
 
+void GameplayState::update_planes(std::chrono::milliseconds const dt)
+{
+    // A plane step only reads the terrain and writes the plane itself, so
+    // every plane gets its own job. Shooting and plane-plane collisions
+    // stay on this thread.
+    int const num_planes = 2 + static_cast<int>(m_players.size());
+    m_jobs.parallel_for(num_planes, 1, [this, dt](int const begin, int const end)
+    {
+        for (int i = begin; i < end; ++i)
+        {
+            entities::Plane& plane = i == 0 ? static_cast<entities::Plane&>(m_player)
+                                   : i == 1 ? static_cast<entities::Plane&>(m_ai)
+                                   :          m_players[i - 2]->get_plane();
+            plane.update(dt, m_terrain);
+        }
+    });
+}
+
 void GameplayState::update_terrain()
 {
     m_terrain.update();
 }
 
-void GameplayState::update_transform()
+void GameplayState::update_transform(math::Vector2f const& focus)
 {
     math::Vector2f const tgt_dimf(Game::TARGET_DIMENSIONS);
     math::Vector2f const tgt_dimf_half(tgt_dimf / 2.0f);
     math::Vector2f const terrain_dimf(m_terrain_dimensions);
-    math::Vector2f const plr_pos = m_player.get_rigid_body().get_position();
     m_camera_position = math::Vector2f({
-        math::clamp(plr_pos[X] - tgt_dimf_half[X], 0.0f, terrain_dimf[X] - tgt_dimf[X]),
-        math::clamp(plr_pos[Y] - tgt_dimf_half[Y], 0.0f, terrain_dimf[Y] - tgt_dimf[Y])
+        math::clamp(focus[X] - tgt_dimf_half[X], 0.0f, terrain_dimf[X] - tgt_dimf[X]),
+        math::clamp(focus[Y] - tgt_dimf_half[Y], 0.0f, terrain_dimf[Y] - tgt_dimf[Y])
     });
     graphics::RenderTools::set_transform(m_batch_renderer.get_shader(), m_camera_position);
 
@@ -494,17 +544,4 @@ void GameplayState::init_explosion_pool()
         );
 }
 
-void GameplayState::init_projectile_pool()
-{
-    for (int i = 0; i < 512; ++i)
-        m_projectiles.push_back(std::make_unique<entities::BasicProjectile>(
-            m_texture_holder.get(graphics::Textures::GAMEPLAY_ELEMENTS), this)
-        );
-
-    for (int i = 0; i < 512; ++i)
-        m_projectiles.push_back(std::make_unique<entities::TrajectoryProjectile>(
-            m_texture_holder.get(graphics::Textures::GAMEPLAY_ELEMENTS), this)
-        );
-}
-
 } // namespace logic
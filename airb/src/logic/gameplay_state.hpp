@@ -4,22 +4,25 @@
 #include <chrono>
 #include <memory>
 
+#include "game_world.hpp"
 #include "state.hpp"
 #include "../audio/sound.hpp"
 #include "../entities/ai_plane.hpp"
 #include "../entities/controllable_plane.hpp"
 #include "../entities/level_terrain.hpp"
-#include "../entities/basic_projectile.hpp"
-#include "../entities/trajectory_projectile.hpp"
+#include "../entities/projectile_system.hpp"
 #include "../graphics/explosion.hpp"
+#include "../graphics/gl_texture_uploader.hpp"
 #include "../graphics/sprite.hpp"
 #include "../graphics/texture.hpp"
 #include "../ui/font.hpp"
 #include "../ui/kill_notification.hpp"
 #include "../ui/scoreboard.hpp"
 #include "../math/matrix.hpp"
+#include "../physics/spatial_grid.hpp"
 #include "../network/player.hpp"
 #include "../network/utilities/udp_packet.hpp"
+#include "../utilities/job_system.hpp"
 
 namespace graphics {
 
@@ -29,7 +32,7 @@ class Texture;
 
 namespace logic {
 
-class GameplayState : public State
+class GameplayState : public State, public GameWorld
 {
 protected:
     graphics::Textures const m_level_id;
@@ -39,18 +42,23 @@ protected:
     graphics::Texture&          m_crosshair_texture;
     entities::AiPlane           m_ai;
     entities::ControllablePlane m_player;
+    graphics::GlTextureUploader m_terrain_uploader;
     entities::LevelTerrain      m_terrain;
+    physics::SpatialGrid        m_plane_grid;
 
     math::Vector2i              m_terrain_dimensions;
     graphics::Sprite            m_terrain_sprite;
     graphics::Sprite            m_background_sprite;
     graphics::Sprite            m_crosshair_sprite;
+    graphics::Sprite            m_projectile_sprite;
 
     math::Vector2f m_camera_position;
     math::Vector2f m_mouse_world_position;
+    float          m_interpolation_alpha;
 
-    std::vector<std::unique_ptr<entities::Projectile>> m_projectiles;
-    std::vector<std::unique_ptr<graphics::Explosion>>  m_explosions;
+    utilities::JobSystem                              m_jobs;
+    entities::ProjectileSystem                        m_projectiles;
+    std::vector<std::unique_ptr<graphics::Explosion>> m_explosions;
 
     ui::Font* m_hud_font;
 
@@ -82,10 +90,10 @@ public:
     GameplayState            (GameplayState const&) = delete;
     GameplayState& operator= (GameplayState const&) = delete;
 
-    void add_explosion  (math::Vector2f const& pos, int const type);
+    void add_explosion  (math::Vector2f const& pos, int const type) override;
     void add_projectile (math::Vector2f const& pos, math::Vector2f const& dir,
                          std::chrono::milliseconds const proj_lifetime,
-                         float const spd, int const bullet_type, int const dmg);
+                         float const spd, int const bullet_type, int const dmg) override;
 
     void on_enter () override;
     void on_exit  () override;
@@ -93,17 +101,19 @@ public:
     void update(std::chrono::milliseconds const dt) override;
     void render() override;
 
+    void interpolate(float const alpha) override;
+
 protected:
-    virtual void update_ai(std::chrono::milliseconds const dt, entities::LevelTerrain& terr);
+    virtual void update_ai(std::chrono::milliseconds const dt);
     virtual void update_player(std::chrono::milliseconds const dt);
 
 private:
+    void update_planes    (std::chrono::milliseconds const dt);
     void update_terrain   ();
-    void update_transform ();
+    void update_transform (math::Vector2f const& focus);
     void update_crosshair (std::chrono::milliseconds const dt);
 
-    void init_explosion_pool  ();
-    void init_projectile_pool ();
+    void init_explosion_pool();
 };
 
 } // namespace logic
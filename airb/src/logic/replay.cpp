@@ -0,0 +1,253 @@
+#include "replay.hpp"
+
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "dedicated_server.hpp"
+
+namespace logic {
+
+namespace
+{
+    char          const MAGIC[8] = { 'A', 'I', 'R', 'B', 'R', 'E', 'P', 'L' };
+    std::uint16_t const VERSION  = 1;
+
+    // One keyframe a second keeps seeking and divergence reports coarse
+    // but costs well under a byte a tick
+    unsigned long const KEYFRAME_INTERVAL = static_cast<unsigned long>(1000 / TICK_DURATION.count());
+
+    struct PlaneState
+    {
+        float        values[6];
+        std::int32_t health;
+    };
+
+    PlaneState get_plane_state(entities::Plane& plane)
+    {
+        auto const& body = plane.get_rigid_body();
+        PlaneState s;
+        s.values[0] = body.get_position()[X];
+        s.values[1] = body.get_position()[Y];
+        s.values[2] = body.get_velocity()[X];
+        s.values[3] = body.get_velocity()[Y];
+        s.values[4] = body.get_rotation();
+        s.values[5] = body.get_angular_velocity();
+        s.health    = plane.get_health().value;
+        return s;
+    }
+
+    // Bitwise, so a replay only matches when the simulation is exact
+    bool is_same_state(PlaneState const& a, PlaneState const& b)
+    {
+        return std::memcmp(a.values, b.values, sizeof(a.values)) == 0 && a.health == b.health;
+    }
+}
+
+ReplayRecorder::ReplayRecorder(std::string const& path, graphics::Textures const lvl_id,
+                               std::uint64_t const seed)
+    : m_writer  (path)
+    , m_cursors ()
+{
+    m_writer.write(MAGIC, sizeof(MAGIC));
+    m_writer.write_u16(VERSION);
+    m_writer.write_u8(static_cast<std::uint8_t>(lvl_id));
+    m_writer.write_u64(seed);
+    m_writer.write_u16(static_cast<std::uint16_t>(TICK_DURATION.count()));
+}
+
+ReplayRecorder::~ReplayRecorder()
+{
+    m_writer.write_u8(REC_END);
+}
+
+void ReplayRecorder::record_pilot()
+{
+    // Not a number, so the first cursor position is always recorded
+    float const nan = std::numeric_limits<float>::quiet_NaN();
+    m_cursors.emplace_back(math::Vector2f({ nan, nan }));
+
+    m_writer.write_u8(REC_PILOT);
+}
+
+void ReplayRecorder::record_input(int const pilot, std::uint8_t const move, std::uint8_t const action)
+{
+    m_writer.write_u8(REC_INPUT);
+    m_writer.write_u8(static_cast<std::uint8_t>(pilot));
+    m_writer.write_u8(move);
+    m_writer.write_u8(action);
+}
+
+void ReplayRecorder::record_cursor(int const pilot, math::Vector2f const& pos)
+{
+    math::Vector2f& last = m_cursors[pilot];
+    if (last[X] == pos[X] && last[Y] == pos[Y])
+        return;
+    last = pos;
+
+    m_writer.write_u8(REC_CURSOR);
+    m_writer.write_u8(static_cast<std::uint8_t>(pilot));
+    m_writer.write_f32(pos[X]);
+    m_writer.write_f32(pos[Y]);
+}
+
+void ReplayRecorder::record_tick(DedicatedServer& server)
+{
+    m_writer.write_u8(REC_TICK);
+
+    for (auto const& c : server.get_terrain().get_destroyed_circles())
+    {
+        m_writer.write_u8(REC_DESTROY);
+        m_writer.write_i32(c.first[X]);
+        m_writer.write_i32(c.first[Y]);
+        m_writer.write_u16(static_cast<std::uint16_t>(c.second));
+    }
+
+    if (server.get_tick() % KEYFRAME_INTERVAL != 0)
+        return;
+
+    int const num_planes = server.get_num_planes();
+    m_writer.write_u8(REC_KEYFRAME);
+    m_writer.write_u8(static_cast<std::uint8_t>(num_planes));
+    for (int i = 0; i < num_planes; ++i)
+    {
+        PlaneState const s = get_plane_state(server.get_indexed_plane(i));
+        for (float const v : s.values)
+            m_writer.write_f32(v);
+        m_writer.write_i32(s.health);
+    }
+}
+
+ReplayPlayer::ReplayPlayer(std::string const& path)
+    : m_reader   (path)
+    , m_level_id (graphics::Textures::CAVE)
+    , m_seed     (0)
+{
+    char          magic[sizeof(MAGIC)];
+    std::uint16_t version  = 0;
+    std::uint8_t  level    = 0;
+    std::uint16_t tick_dur = 0;
+    if (!m_reader.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0
+        || !m_reader.read_u16(version) || !m_reader.read_u8(level)
+        || !m_reader.read_u64(m_seed) || !m_reader.read_u16(tick_dur))
+        throw std::runtime_error(path + " is not a replay.");
+
+    if (version != VERSION || tick_dur != TICK_DURATION.count())
+        throw std::runtime_error(path + " was recorded by an incompatible version.");
+
+    m_level_id = static_cast<graphics::Textures>(level);
+}
+
+ReplayPlayer::Result ReplayPlayer::play(DedicatedServer& server)
+{
+    Result r = { 0, 0, 0, -1, false };
+
+    auto const mismatch = [&r, &server]()
+    {
+        ++r.mismatches;
+        if (r.first_mismatch_tick < 0)
+            r.first_mismatch_tick = static_cast<long>(server.get_tick());
+    };
+
+    // Circles of the last step not yet matched against the recording
+    size_t destroyed = 0;
+    auto const check_destroyed = [&server, &destroyed, &mismatch]()
+    {
+        if (destroyed != server.get_terrain().get_destroyed_circles().size())
+            mismatch();
+    };
+
+    for (;;)
+    {
+        std::uint8_t tag;
+        if (!m_reader.read_u8(tag))
+            return r;
+
+        switch (tag)
+        {
+        case REC_PILOT:
+            server.add_pilot();
+            break;
+
+        case REC_INPUT:
+        {
+            std::uint8_t pilot, move, action;
+            if (!m_reader.read_u8(pilot) || !m_reader.read_u8(move) || !m_reader.read_u8(action)
+                || pilot >= server.get_num_pilots())
+                return r;
+            server.process_input(pilot, move, action);
+            break;
+        }
+
+        case REC_CURSOR:
+        {
+            std::uint8_t pilot;
+            float x, y;
+            if (!m_reader.read_u8(pilot) || !m_reader.read_f32(x) || !m_reader.read_f32(y)
+                || pilot >= server.get_num_pilots())
+                return r;
+            server.set_cursor_position(pilot, math::Vector2f({ x, y }));
+            break;
+        }
+
+        case REC_TICK:
+            if (r.ticks > 0)
+                check_destroyed();
+            server.tick(TICK_DURATION);
+            destroyed = 0;
+            ++r.ticks;
+            break;
+
+        case REC_DESTROY:
+        {
+            std::int32_t x, y;
+            std::uint16_t rad;
+            if (!m_reader.read_i32(x) || !m_reader.read_i32(y) || !m_reader.read_u16(rad))
+                return r;
+
+            auto const& circles = server.get_terrain().get_destroyed_circles();
+            if (destroyed >= circles.size() || circles[destroyed].first[X] != x
+                || circles[destroyed].first[Y] != y || circles[destroyed].second != rad)
+                mismatch();
+            ++destroyed;
+            break;
+        }
+
+        case REC_KEYFRAME:
+        {
+            std::uint8_t num_planes;
+            if (!m_reader.read_u8(num_planes))
+                return r;
+
+            bool same = num_planes == server.get_num_planes();
+            for (int i = 0; i < num_planes; ++i)
+            {
+                PlaneState s;
+                for (float& v : s.values)
+                    if (!m_reader.read_f32(v))
+                        return r;
+                if (!m_reader.read_i32(s.health))
+                    return r;
+
+                if (same && !is_same_state(s, get_plane_state(server.get_indexed_plane(i))))
+                    same = false;
+            }
+            if (!same)
+                mismatch();
+            ++r.keyframes;
+            break;
+        }
+
+        case REC_END:
+            if (r.ticks > 0)
+                check_destroyed();
+            r.complete = true;
+            return r;
+
+        default:
+            return r;
+        }
+    }
+}
+
+} // namespace logic
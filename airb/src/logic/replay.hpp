@@ -0,0 +1,99 @@
+#ifndef LOGIC_REPLAY_HPP
+#define LOGIC_REPLAY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../graphics/texture.hpp"
+#include "../math/matrix.hpp"
+#include "../utilities/binary_stream.hpp"
+
+namespace logic {
+
+class DedicatedServer;
+
+// A replay is a header followed by records of a tag byte and its fields:
+//
+//   REC_PILOT                                     a pilot joined
+//   REC_INPUT    u8 pilot, u8 move, u8 action     UDP_IN_* bytes of a client
+//   REC_CURSOR   u8 pilot, f32 x, f32 y           only when the cursor moved
+//   REC_TICK                                      the simulation stepped
+//   REC_DESTROY  i32 x, i32 y, u16 r              terrain cleared by that step
+//   REC_KEYFRAME u8 n, n * (f32 x, y, vx, vy, rotation, angular velocity,
+//                           i32 health)           state of every plane
+//   REC_END
+//
+// Records before a REC_TICK are applied before that step; destruction and
+// keyframes after it are its results, which a player checks its own
+// simulation against.
+enum ReplayRecord : std::uint8_t
+{
+    REC_PILOT,
+    REC_INPUT,
+    REC_CURSOR,
+    REC_TICK,
+    REC_DESTROY,
+    REC_KEYFRAME,
+    REC_END
+};
+
+class ReplayRecorder final
+{
+private:
+    utilities::BinaryWriter     m_writer;
+    std::vector<math::Vector2f> m_cursors;
+
+public:
+     ReplayRecorder(std::string const& path, graphics::Textures const lvl_id,
+                    std::uint64_t const seed);
+    ~ReplayRecorder();
+
+    ReplayRecorder            (ReplayRecorder const&) = delete;
+    ReplayRecorder& operator= (ReplayRecorder const&) = delete;
+
+    void record_pilot  ();
+    void record_input  (int const pilot, std::uint8_t const move, std::uint8_t const action);
+    void record_cursor (int const pilot, math::Vector2f const& pos);
+
+    // Called by the server after each step
+    void record_tick   (DedicatedServer& server);
+};
+
+// Re-simulates a recorded match on a DedicatedServer as fast as it will go
+class ReplayPlayer final
+{
+public:
+    struct Result
+    {
+        unsigned long ticks;
+        unsigned long keyframes;
+        unsigned long mismatches;
+        long          first_mismatch_tick; // -1 when the replay matched
+        bool          complete;            // false when the file was cut short
+    };
+
+private:
+    utilities::BinaryReader m_reader;
+    graphics::Textures      m_level_id;
+    std::uint64_t           m_seed;
+
+public:
+    explicit ReplayPlayer(std::string const& path);
+            ~ReplayPlayer() = default;
+
+    ReplayPlayer            (ReplayPlayer const&) = delete;
+    ReplayPlayer& operator= (ReplayPlayer const&) = delete;
+
+    // The server must be new and built for get_level_id() and get_seed()
+    Result play(DedicatedServer& server);
+
+    inline graphics::Textures get_level_id () const;
+    inline std::uint64_t      get_seed     () const;
+};
+
+} // namespace logic
+
+#include "replay.inl"
+
+#endif // LOGIC_REPLAY_HPP
@@ -0,0 +1,13 @@
+namespace logic {
+
+inline graphics::Textures ReplayPlayer::get_level_id() const
+{
+    return m_level_id;
+}
+
+inline std::uint64_t ReplayPlayer::get_seed() const
+{
+    return m_seed;
+}
+
+} // namespace logic
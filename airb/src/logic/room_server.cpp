@@ -0,0 +1,567 @@
+#include "room_server.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#include "../network/utilities/functions.hpp"
+#include "../utilities/random.hpp"
+
+namespace logic {
+
+int const RoomServer::MAX_ROOMS;
+int const RoomServer::MAX_SEATS;
+int const RoomServer::MAX_TICKS_BEHIND;
+
+namespace
+{
+    std::chrono::seconds      const REPORT_INTERVAL(10);
+    std::chrono::seconds      const SESSION_CHECK_INTERVAL(1);
+    std::chrono::milliseconds const SYNC_INTERVAL(network::SYNC_FREQUENCY_MS);
+
+    std::uint32_t to_microseconds(std::chrono::steady_clock::duration const d)
+    {
+        auto const us = std::chrono::duration_cast<std::chrono::microseconds>(d).count();
+        return static_cast<std::uint32_t>(std::min<long long>(std::max<long long>(us, 0), 0xffffffffll));
+    }
+
+    // Tells a client its seat and the token to stamp on its packets
+    network::UdpPacket make_welcome(network::Connection const& conn)
+    {
+        network::UdpPacket packet(
+            network::UDP_H_CONNECT | network::UDP_H_OK | network::UDP_H_POS,
+            conn.get_public_id()
+        );
+        packet.set_token(conn.get_token());
+        return packet;
+    }
+}
+
+RoomServer::Event::Event(Type const t, int const p)
+    : type           (t)
+    , pilot          (p)
+    , move           (0)
+    , action         (0)
+    , public_id      (0)
+    , input_sequence (0)
+    , ack            (0)
+    , cursor         (math::Vector2f::zero())
+    , address        ()
+{ }
+
+RoomServer::Session::Session()
+    : room       (-1)
+    , pilot      (-1)
+    , connection ()
+{ }
+
+RoomServer::Session::Session(int const r, int const p, std::shared_ptr<network::Connection> conn)
+    : room       (r)
+    , pilot      (p)
+    , connection (std::move(conn))
+{ }
+
+RoomServer::Room::Room(int const idx, std::unique_ptr<DedicatedServer> srv)
+    : index  (idx)
+    , server (std::move(srv))
+
+    , inbox_mutex ()
+    , inbox       ()
+
+    , events            ()
+    , members           ()
+    , snapshot_history  ()
+    , snapshot_sequence (0)
+    , next_sync         (Clock::now())
+
+    , seats_taken  (0)
+    , seats_active (0)
+
+    , deadline      (Clock::now())
+    , tick_time     ()
+    , lateness      ()
+    , ticks         (0)
+    , dropped_ticks (0)
+    , closing       (false)
+    , retired       (false)
+{ }
+
+RoomServer::RoomServer(graphics::Textures const lvl_id, std::string const& lvl_tex_path,
+                       unsigned short const port, int const num_workers)
+    : m_level_id   (lvl_id)
+    , m_level_path (lvl_tex_path)
+
+    , m_socket            (port)
+    , m_listener_thread   ()
+    , m_conn_check_thread ()
+
+    , m_rooms     ()
+    , m_sessions  (MAX_ROOMS * MAX_SEATS)
+    , m_addresses ()
+
+    , m_schedule_mutex ()
+    , m_schedule_cond  ()
+    , m_schedule       ()
+    , m_workers        ()
+    , m_quit           (false)
+
+    , m_running (false)
+{
+    m_listener_thread   = std::thread([this] { m_socket.start_listener_routine(); });
+    m_conn_check_thread = std::thread([this] { m_socket.start_conn_check_routine(); });
+
+    int const n = std::max(num_workers, 1);
+    m_workers.reserve(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i)
+        m_workers.emplace_back([this] { worker_loop(); });
+
+    std::printf("Room server on port %d with %d worker(s), up to %d rooms of %d.\n",
+                static_cast<int>(port), n, MAX_ROOMS, MAX_SEATS);
+}
+
+RoomServer::~RoomServer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_schedule_mutex);
+        m_quit = true;
+    }
+    m_schedule_cond.notify_all();
+    for (auto& w : m_workers)
+        w.join();
+
+    m_socket.end_listener_routine();
+    m_socket.end_conn_check_routine();
+    m_listener_thread.join();
+    m_conn_check_thread.join();
+}
+
+void RoomServer::run()
+{
+    auto next_check  = Clock::now() + SESSION_CHECK_INTERVAL;
+    auto next_report = Clock::now() + REPORT_INTERVAL;
+
+    std::pair<network::UdpPacket, sockaddr_in> batch[PACKET_BATCH_SIZE];
+
+    m_running = true;
+    while (m_running)
+    {
+        bool idle = true;
+        int n;
+        while ((n = m_socket.get_packets(batch, PACKET_BATCH_SIZE)) > 0)
+        {
+            idle = false;
+            for (int i = 0; i < n; ++i)
+                process_packet(batch[i].first, batch[i].second);
+        }
+
+        auto const now = Clock::now();
+        if (now >= next_check)
+        {
+            drop_lost_sessions();
+            free_retired_rooms();
+            next_check = now + SESSION_CHECK_INTERVAL;
+        }
+        if (now >= next_report)
+        {
+            report();
+            next_report = now + REPORT_INTERVAL;
+        }
+
+        // The socket queue has no blocking wait with a timeout, so an idle
+        // dispatcher polls it like the game states do every frame
+        if (idle)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    report();
+}
+
+void RoomServer::stop()
+{
+    m_running = false;
+}
+
+void RoomServer::process_packet(network::UdpPacket const& packet, sockaddr_in const& address)
+{
+    // A client without a session can only ask for one
+    Session const* s = find_session(packet.get_token());
+    if (s == nullptr)
+    {
+        if (packet.header_contains(network::UDP_H_CONNECT) &&
+           !packet.header_contains(network::UDP_H_ERROR))
+            add_session(address);
+        return;
+    }
+
+    unsigned short ack;
+    if (network::Snapshot::read_ack(packet, ack))
+    {
+        Event e(Event::ACK, s->pilot);
+        e.ack = ack;
+        post(*m_rooms[s->room], e);
+        return;
+    }
+    if (packet.header_contains(network::UDP_H_CONNECT) &&
+        packet.header_contains(network::UDP_H_ERROR))
+    {
+        remove_session(packet.get_token());
+        return;
+    }
+    if (packet.header_contains(network::UDP_H_CONNECT))
+    {
+        // Client has loaded the level; the room is already running
+        s->connection->set_status(network::Connection::Status::IN_GAME);
+        return;
+    }
+    if (packet.header_contains(network::UDP_H_INPUT) &&
+        packet.header_contains(network::UDP_H_POS) &&
+        packet.header_contains(network::UDP_H_DATABLOCK))
+    {
+        math::Vector2f pos;
+        if (!network::parse_cursor(packet.get_data_block(), packet.get_data_size(), pos))
+            return;
+
+        Event e(Event::CURSOR, s->pilot);
+        e.cursor = pos;
+        post(*m_rooms[s->room], e);
+        return;
+    }
+    if (packet.header_contains(network::UDP_H_INPUT))
+    {
+        Event e(Event::INPUT, s->pilot);
+        e.move           = packet.get_move_byte();
+        e.action         = packet.get_action_byte();
+        e.input_sequence = packet.get_pos_byte();
+        post(*m_rooms[s->room], e);
+        return;
+    }
+}
+
+void RoomServer::add_session(sockaddr_in const& address)
+{
+    // A client retrying its connect already has a seat; answer it again
+    auto const known = m_addresses.find(get_address_key(address));
+    if (known != m_addresses.end())
+    {
+        m_socket.send(make_welcome(*find_session(known->second)->connection), address);
+        return;
+    }
+
+    int const r = find_open_room();
+    if (r < 0)
+    {
+        m_socket.send(network::UdpPacket(network::UDP_H_CONNECT | network::UDP_H_ERROR), address);
+        return;
+    }
+
+    Room& room = *m_rooms[r];
+    int const pilot = room.seats_taken++;
+    ++room.seats_active;
+
+    auto const conn = std::make_shared<network::Connection>(address);
+    conn->set_team(pilot % 2 == 0 ? network::UDP_POS_TEAM_1 : network::UDP_POS_TEAM_2);
+    conn->set_player_num(static_cast<network::U8>(network::UDP_POS_PLAYER_1 << pilot));
+    conn->set_status(network::Connection::Status::CONNECTED);
+
+    m_sessions.insert(conn->get_token(), Session(r, pilot, conn));
+    m_addresses[get_address_key(address)] = conn->get_token();
+    m_socket.add_client(conn);
+
+    Event e(Event::JOIN, pilot);
+    e.public_id = conn->get_public_id();
+    e.address   = address;
+    post(room, e);
+
+    m_socket.send(make_welcome(*conn), address);
+}
+
+void RoomServer::remove_session(network::SessionToken const token)
+{
+    Session const* found = find_session(token);
+    if (found == nullptr)
+        return;
+
+    Session const s = *found;
+    m_addresses.erase(get_address_key(s.connection->get_sockaddr()));
+    m_sessions.erase(token);
+    m_socket.drop_client(s.connection);
+
+    Room& room = *m_rooms[s.room];
+    post(room, Event(Event::LEAVE, s.pilot));
+
+    if (--room.seats_active == 0)
+        close_room(room);
+}
+
+void RoomServer::drop_lost_sessions()
+{
+    std::vector<network::SessionToken> lost;
+    m_sessions.for_each([&lost](network::SessionToken const token, Session const& s)
+    {
+        if (s.connection->connection_lost())
+            lost.push_back(token);
+    });
+
+    for (auto const token : lost)
+        remove_session(token);
+}
+
+int RoomServer::find_open_room()
+{
+    // Fill rooms before opening new ones so small matches share a core
+    // rather than each holding a level of their own
+    int free_slot = -1;
+    for (int i = 0; i < MAX_ROOMS; ++i)
+    {
+        if (!m_rooms[i])
+        {
+            if (free_slot < 0)
+                free_slot = i;
+            continue;
+        }
+        if (m_rooms[i]->seats_taken < MAX_SEATS && m_rooms[i]->seats_active > 0)
+            return i;
+    }
+    if (free_slot < 0)
+        return -1;
+
+    // Rooms share no state, so each gets its own seed and steps inline on
+    // whichever worker picks it up
+    std::uint64_t const seed = utilities::Random::make_seed();
+    m_rooms[free_slot] = std::make_unique<Room>(
+        free_slot,
+        std::make_unique<DedicatedServer>(m_level_id, m_level_path, seed, 0)
+    );
+
+    {
+        std::lock_guard<std::mutex> lock(m_schedule_mutex);
+        Room& room = *m_rooms[free_slot];
+        room.deadline = Clock::now();
+        m_schedule.push(Deadline(room.deadline, free_slot));
+    }
+    m_schedule_cond.notify_one();
+
+    network::print_time();
+    std::printf("Room %d opened with seed %llu.\n", free_slot, static_cast<unsigned long long>(seed));
+    return free_slot;
+}
+
+void RoomServer::close_room(Room& room)
+{
+    // The worker that next takes the room off the schedule retires it
+    std::lock_guard<std::mutex> lock(m_schedule_mutex);
+    room.closing = true;
+}
+
+void RoomServer::free_retired_rooms()
+{
+    std::lock_guard<std::mutex> lock(m_schedule_mutex);
+    for (auto& room : m_rooms)
+    {
+        if (!room || !room->retired)
+            continue;
+
+        network::print_time();
+        std::printf("Room %d closed after %lu ticks.\n", room->index, room->ticks);
+        room.reset();
+    }
+}
+
+void RoomServer::post(Room& room, Event const& event)
+{
+    std::lock_guard<std::mutex> lock(room.inbox_mutex);
+    room.inbox.push_back(event);
+}
+
+void RoomServer::worker_loop()
+{
+    std::unique_lock<std::mutex> lock(m_schedule_mutex);
+    while (!m_quit)
+    {
+        if (m_schedule.empty())
+        {
+            m_schedule_cond.wait(lock);
+            continue;
+        }
+
+        Deadline const next = m_schedule.top();
+        if (Clock::now() < next.first)
+        {
+            m_schedule_cond.wait_until(lock, next.first);
+            continue;
+        }
+        m_schedule.pop();
+
+        Room& room = *m_rooms[next.second];
+        if (room.closing)
+        {
+            room.retired = true;
+            continue;
+        }
+
+        lock.unlock();
+        auto const start = Clock::now();
+        tick_room(room, start);
+        auto const end = Clock::now();
+        lock.lock();
+
+        room.tick_time.record(to_microseconds(end - start));
+        room.lateness.record(to_microseconds(start - room.deadline));
+        ++room.ticks;
+
+        room.deadline += TICK_DURATION;
+        if (room.deadline + TICK_DURATION * MAX_TICKS_BEHIND < end)
+        {
+            room.dropped_ticks += static_cast<unsigned long>((end - room.deadline) / TICK_DURATION);
+            room.deadline = end;
+        }
+        m_schedule.push(Deadline(room.deadline, room.index));
+
+        // Another worker may be sleeping towards a later deadline
+        m_schedule_cond.notify_one();
+    }
+}
+
+void RoomServer::tick_room(Room& room, Clock::time_point const now)
+{
+    {
+        std::lock_guard<std::mutex> lock(room.inbox_mutex);
+        room.events.swap(room.inbox);
+    }
+
+    DedicatedServer& server = *room.server;
+    for (auto const& e : room.events)
+    {
+        switch (e.type)
+        {
+        case Event::JOIN:
+            server.add_pilot();
+            room.members.push_back(Member { e.address, e.public_id, -1, true,
+                                            network::InputAck(), false });
+            break;
+        case Event::LEAVE:
+            // The plane stays in the match so pilot indices stay stable
+            room.members[e.pilot].active = false;
+            break;
+        case Event::INPUT:
+        {
+            server.process_input(e.pilot, e.move, e.action);
+            Member& m = room.members[e.pilot];
+            m.input_ack     = network::InputAck { e.input_sequence, 0 };
+            m.has_input_ack = true;
+            break;
+        }
+        case Event::CURSOR:
+            server.set_cursor_position(e.pilot, e.cursor);
+            break;
+        case Event::ACK:
+        {
+            int& last = room.members[e.pilot].snapshot_ack;
+            if (last < 0 || network::sequence_newer(e.ack, static_cast<unsigned short>(last)))
+                last = e.ack;
+            break;
+        }
+        }
+    }
+    room.events.clear();
+
+    server.tick(TICK_DURATION);
+    for (auto& m : room.members)
+        if (m.input_ack.ticks < 0xffff)
+            ++m.input_ack.ticks;
+
+    if (now >= room.next_sync)
+    {
+        send_snapshot(room);
+        room.next_sync = now + SYNC_INTERVAL;
+    }
+}
+
+void RoomServer::send_snapshot(Room& room)
+{
+    network::Snapshot snapshot(room.snapshot_sequence++);
+    for (int i = 0; i < static_cast<int>(room.members.size()); ++i)
+    {
+        Member const& m = room.members[i];
+        if (!m.active)
+            continue;
+
+        auto& plane = room.server->get_plane(i);
+        snapshot.add_plane(network::PlaneState {
+            m.public_id,
+            plane.get_position(),
+            plane.get_rotation(),
+            plane.get_velocity(),
+            room.server->get_cursor_position(i)
+        });
+    }
+    room.snapshot_history.store(snapshot);
+
+    for (auto const& m : room.members)
+    {
+        if (!m.active)
+            continue;
+
+        auto const baseline = m.snapshot_ack < 0 ? nullptr
+                            : room.snapshot_history.find(static_cast<unsigned short>(m.snapshot_ack));
+
+        // The ack is the member's own, so it goes on a copy
+        network::Snapshot sent(snapshot);
+        if (m.has_input_ack)
+            sent.set_input_ack(m.input_ack);
+        m_socket.send(sent.to_packet(baseline), m.address);
+    }
+}
+
+void RoomServer::report()
+{
+    utilities::Histogram all_ticks;
+    utilities::Histogram all_lateness;
+    unsigned long        all_dropped = 0;
+    int                  num_rooms   = 0;
+
+    std::lock_guard<std::mutex> lock(m_schedule_mutex);
+    for (auto& room : m_rooms)
+    {
+        if (!room || room->tick_time.get_count() == 0)
+            continue;
+
+        utilities::Histogram const& t = room->tick_time;
+        utilities::Histogram const& l = room->lateness;
+        std::printf("  room %2d: %6llu ticks, tick us p50 %5u p99 %5u max %6u, "
+                    "late us p99 %6u, %lu dropped\n",
+                    room->index, static_cast<unsigned long long>(t.get_count()),
+                    t.get_percentile(0.5), t.get_percentile(0.99), t.get_max(),
+                    l.get_percentile(0.99), room->dropped_ticks);
+
+        all_ticks.merge(t);
+        all_lateness.merge(l);
+        all_dropped += room->dropped_ticks;
+        ++num_rooms;
+
+        room->tick_time.reset();
+        room->lateness.reset();
+        room->dropped_ticks = 0;
+    }
+
+    network::print_time();
+    std::printf("%d room(s): %llu ticks, tick us mean %.1f p50 %u p99 %u p99.9 %u max %u, "
+                "late us p50 %u p99 %u max %u, %lu dropped\n",
+                num_rooms, static_cast<unsigned long long>(all_ticks.get_count()),
+                all_ticks.get_mean(), all_ticks.get_percentile(0.5), all_ticks.get_percentile(0.99),
+                all_ticks.get_percentile(0.999), all_ticks.get_max(),
+                all_lateness.get_percentile(0.5), all_lateness.get_percentile(0.99),
+                all_lateness.get_max(), all_dropped);
+    std::fflush(stdout);
+}
+
+RoomServer::Session const* RoomServer::find_session(network::SessionToken const token) const
+{
+    return m_sessions.find(token);
+}
+
+std::uint64_t RoomServer::get_address_key(sockaddr_in const& address)
+{
+    return static_cast<std::uint64_t>(address.sin_addr.s_addr) << 16u | address.sin_port;
+}
+
+} // namespace logic
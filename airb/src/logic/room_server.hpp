@@ -0,0 +1,194 @@
+#ifndef LOGIC_ROOM_SERVER_HPP
+#define LOGIC_ROOM_SERVER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "dedicated_server.hpp"
+#include "../graphics/texture.hpp"
+#include "../math/matrix.hpp"
+#include "../network/connection.hpp"
+#include "../network/session_table.hpp"
+#include "../network/socket/server_socket.hpp"
+#include "../network/utilities/config.hpp"
+#include "../network/utilities/snapshot.hpp"
+#include "../network/utilities/udp_packet.hpp"
+#include "../utilities/histogram.hpp"
+
+namespace logic {
+
+// Hosts up to ROOM_MAX_NUM independent matches behind one UDP port.
+//
+// The calling thread owns the socket side: it takes every datagram off the
+// socket queue, finds the room of its sender by session token and posts it
+// to that room as an event. Rooms are stepped by a fixed pool of workers,
+// each room at its own fixed tick: a worker takes the room with the
+// earliest deadline once it is due, drains its events, steps it and
+// schedules its next tick, so one core can carry many small matches. A
+// room is only ever stepped by one worker at a time and only its worker
+// touches its simulation.
+//
+// Tick durations and how late each tick started are kept in a histogram
+// per room and reported periodically.
+class RoomServer final
+{
+public:
+    static int const MAX_ROOMS = network::ROOM_MAX_NUM;
+    static int const MAX_SEATS = network::ROOM_MAX_USERS;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    // Room ticks starting more than this late are dropped instead of
+    // being caught up in a burst
+    static int const MAX_TICKS_BEHIND = 4;
+
+    static int const PACKET_BATCH_SIZE = 64;
+
+    struct Event
+    {
+        enum Type
+        {
+            JOIN,
+            LEAVE,
+            INPUT,
+            CURSOR,
+            ACK
+        };
+
+        Type           type;
+        int            pilot;
+        network::U8    move;
+        network::U8    action;
+        network::U8    public_id;
+        network::U8    input_sequence;
+        unsigned short ack;
+        math::Vector2f cursor;
+        sockaddr_in    address;
+
+        Event(Type const t, int const p);
+    };
+
+    struct Member
+    {
+        sockaddr_in       address;
+        network::U8       public_id;
+        int               snapshot_ack;
+        bool              active;
+        network::InputAck input_ack;
+        bool              has_input_ack;
+    };
+
+    struct Room
+    {
+        int                              index;
+        std::unique_ptr<DedicatedServer> server;
+
+        // Posted by the dispatcher, drained by the worker stepping the room
+        std::mutex         inbox_mutex;
+        std::vector<Event> inbox;
+
+        // Only touched by the worker stepping the room
+        std::vector<Event>      events;
+        std::vector<Member>     members;
+        network::SnapshotBuffer snapshot_history;
+        unsigned short          snapshot_sequence;
+        Clock::time_point       next_sync;
+
+        // Only touched by the dispatcher
+        int seats_taken;
+        int seats_active;
+
+        // Guarded by the schedule mutex
+        Clock::time_point    deadline;
+        utilities::Histogram tick_time;
+        utilities::Histogram lateness;
+        unsigned long        ticks;
+        unsigned long        dropped_ticks;
+        bool                 closing;
+        bool                 retired;
+
+        Room(int const idx, std::unique_ptr<DedicatedServer> srv);
+    };
+
+    struct Session
+    {
+        int                                  room;
+        int                                  pilot;
+        std::shared_ptr<network::Connection> connection;
+
+        Session();
+        Session(int const r, int const p, std::shared_ptr<network::Connection> conn);
+    };
+
+    using Deadline = std::pair<Clock::time_point, int>;
+
+    graphics::Textures const m_level_id;
+    std::string const        m_level_path;
+
+    network::ServerSocket m_socket;
+    std::thread           m_listener_thread;
+    std::thread           m_conn_check_thread;
+
+    // Only touched by the dispatcher. Sessions are keyed by token; a client
+    // retrying its connect has no token yet and is found by address.
+    std::unique_ptr<Room>                                    m_rooms[MAX_ROOMS];
+    network::SessionTable<Session>                           m_sessions;
+    std::unordered_map<std::uint64_t, network::SessionToken> m_addresses;
+
+    std::mutex                                                                    m_schedule_mutex;
+    std::condition_variable                                                       m_schedule_cond;
+    std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> m_schedule;
+    std::vector<std::thread>                                                      m_workers;
+    bool                                                                          m_quit;
+
+    bool m_running;
+
+public:
+     RoomServer(graphics::Textures const lvl_id, std::string const& lvl_tex_path,
+                unsigned short const port, int const num_workers);
+    ~RoomServer();
+
+    RoomServer            (RoomServer const&) = delete;
+    RoomServer& operator= (RoomServer const&) = delete;
+
+    // Dispatches packets until stop() is called
+    void run  ();
+    void stop ();
+
+private:
+    void process_packet     (network::UdpPacket const& packet, sockaddr_in const& address);
+    void add_session        (sockaddr_in const& address);
+    void remove_session     (network::SessionToken const token);
+    void drop_lost_sessions ();
+
+    int  find_open_room     ();
+    void close_room         (Room& room);
+    void free_retired_rooms ();
+    void post               (Room& room, Event const& event);
+
+    void worker_loop   ();
+    void tick_room     (Room& room, Clock::time_point const now);
+    void send_snapshot (Room& room);
+
+    // Prints and resets the histograms of every room
+    void report ();
+
+    Session const* find_session(network::SessionToken const token) const;
+
+    static std::uint64_t get_address_key(sockaddr_in const& address);
+};
+
+} // namespace logic
+
+#endif // LOGIC_ROOM_SERVER_HPP
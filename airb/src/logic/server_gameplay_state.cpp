@@ -1,6 +1,10 @@
 #include "server_gameplay_state.hpp"
 
+#include <cstdio>
+#include <cstring>
+
 #include "game.hpp"
+#include "../network/utilities/functions.hpp"
 
 namespace logic {
 
@@ -9,10 +13,12 @@ ServerGameplayState::ServerGameplayState(Game& g,
                                          std::unique_ptr<network::ServerSocket>& socket,
                                          std::vector<std::shared_ptr<network::Connection>> players)
     : GameplayState(g, lvl_id)
-    , m_pos_sync_running(false)
-    , m_cursor_sync_running(false)
+    , m_next_sync(Clock::now())
+    , m_snapshot_sequence(0)
     , m_public_id(network::UDP_POS_TEAM_1 | network::UDP_POS_PLAYER_1)
     , m_waiting_for_players(true)
+    , m_interest_grid(math::Vector2f(m_terrain_dimensions), network::AOI_CELL_SIZE)
+    , m_sessions(players.size())
     , m_socket(std::move(socket))
 {
     open_socket();
@@ -57,11 +63,22 @@ void ServerGameplayState::on_exit()
 void ServerGameplayState::update(std::chrono::milliseconds const dt)
 {
     process_udp_queue();
+    drop_lost_players();
 
     update_released_keys();
     update_pressed_keys();
 
     GameplayState::update(dt);
+
+    // Snapshots are built here, after the tick, so the planes, the input
+    // acks and their tick counts all come from the same step and nothing
+    // else touches the players' ack and snapshot history
+    auto const now = Clock::now();
+    if (now >= m_next_sync && !m_players.empty())
+    {
+        send_snapshots();
+        m_next_sync = now + std::chrono::milliseconds(network::SYNC_FREQUENCY_MS);
+    }
 }
 
 void ServerGameplayState::render()
@@ -82,9 +99,12 @@ void ServerGameplayState::update_player(std::chrono::milliseconds const dt)
 {
     GameplayState::update_player(dt);
 
+    // Runs after this tick's physics step, so a plane has had one step on
+    // the input it received this tick once its count reaches one
     for (auto p : m_players)
     {
-        p->update(dt, m_terrain);
+        p->handle_input(dt);
+        p->count_input_tick();
     }
 }
 
@@ -99,27 +119,15 @@ void ServerGameplayState::open_socket()
     {
         m_socket->start_conn_check_routine();
     });
-    m_pos_sync_thread = std::thread([&]
-    {
-        start_pos_sync_routine();
-    });
-    m_cursor_sync_thread = std::thread([&]
-    {
-        start_cursor_sync_routine();
-    });
 }
 
 void ServerGameplayState::close_socket()
 {
     m_socket->end_listener_routine();
     m_socket->end_conn_check_routine();
-    end_pos_sync_routine();
-    end_cursor_sync_routine();
     m_socket->close();
     m_listener_thread.join();
     m_conn_check_thread.join();
-    m_pos_sync_thread.join();
-    m_cursor_sync_thread.join();
 }
 
 void ServerGameplayState::add_player(network::Connection conn)
@@ -151,11 +159,13 @@ void ServerGameplayState::add_player(network::Connection conn)
     new_player->set_plane(std::move(plane));
     new_player->set_status(network::Connection::Status::WAITING);
     m_players.push_back(new_player);
+    m_sessions.insert(new_player->get_token(), new_player);
 }
 
 void ServerGameplayState::drop_player(std::shared_ptr<network::Player> player)
 {
     m_socket->drop_client(player);
+    m_sessions.erase(player->get_token());
     m_players.erase(remove(m_players.begin(),
                            m_players.end(),
                            player),
@@ -168,34 +178,38 @@ void ServerGameplayState::drop_player(std::shared_ptr<network::Player> player)
     );
 }
 
-void ServerGameplayState::process_packet(network::UdpPacket packet, sockaddr_in client_address)
+void ServerGameplayState::drop_lost_players()
+{
+    // Backwards, since dropping a player shifts the ones after it
+    for (auto i = m_players.size(); i-- > 0; )
+        if (m_players[i]->connection_lost())
+            drop_player(m_players[i]);
+}
+
+void ServerGameplayState::process_packet(network::UdpPacket const& packet, sockaddr_in client_address)
 {
     (void)client_address;
 
-    if (packet.header_contains(network::UDP_H_CONNECT) &&
-        packet.header_contains(network::UDP_H_ERROR) &&
-        packet.header_contains(network::UDP_H_DATABLOCK))
-    {
-        for (auto player : m_players)
-        {
-            if (strcmp(player->get_id(), packet.get_data_block()) != 0)
-                continue;
+    auto found = m_sessions.find(packet.get_token());
+    if (found == nullptr)
+        return;
+    auto player = *found;
 
-            drop_player(player);
-            return;
-        }
+    unsigned short ack;
+    if (network::Snapshot::read_ack(packet, ack))
+    {
+        player->acknowledge_snapshot(ack);
         return;
     }
     if (packet.header_contains(network::UDP_H_CONNECT) &&
-        packet.header_contains(network::UDP_H_DATABLOCK))
+        packet.header_contains(network::UDP_H_ERROR))
     {
-        for (auto player : m_players)
-        {
-            if (strcmp(player->get_id(), packet.get_data_block()) != 0)
-                continue;
-
-            player->set_status(network::Connection::Status::IN_GAME);
-        }
+        drop_player(player);
+        return;
+    }
+    if (packet.header_contains(network::UDP_H_CONNECT))
+    {
+        player->set_status(network::Connection::Status::IN_GAME);
 
         auto all_ready = true;
         for (auto player : m_players)
@@ -214,77 +228,54 @@ void ServerGameplayState::process_packet(network::UdpPacket packet, sockaddr_in
         packet.header_contains(network::UDP_H_DATABLOCK))
     {
         // Cursor sync
-        if (m_players.size() == 0)
-            return;
-
-        char id[network::NETWORK_ID_LENGTH] = { '\0' };
-        char buffer[network::UDP_MAX_DATABLOCK_SIZE] = { '\0' };
-        auto data = packet.get_data_block();
-
-        // id
-        auto byte = 0;
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            id[i] = data[byte];
-
-        // cursor x
-        byte++;
-        for (auto i = 0; data[byte] != '|'; i++, byte++)
-            buffer[i] = data[byte];
-        auto x = static_cast<float>(atof(buffer));
-
-        // cursor y
-        byte++;
-        for (auto e = 0; buffer[e] != '\0'; e++) buffer[e] = '\0';
-        for (auto i = 0; data[byte] != '\0'; i++, byte++)
-            buffer[i] = data[byte];
-        auto y = static_cast<float>(atof(buffer));
-
-        for (auto player : m_players)
-        {
-            if (strcmp(player->get_id(), id) != 0)
-                continue;
-
-            player->set_cursor_position(x, y);
-            break;
-        }
+        math::Vector2f cursor;
+        if (network::parse_cursor(packet.get_data_block(), packet.get_data_size(), cursor))
+            player->set_cursor_position(cursor[X], cursor[Y]);
         return;
     }
     if (packet.header_contains(network::UDP_H_INPUT))
     {
-        char id[network::NETWORK_ID_LENGTH] = { '\0' };
-        strcpy_s(id, network::NETWORK_ID_LENGTH, packet.get_data_block());
-
-        for (auto player : m_players)
-        {
-            if (strcmp(player->get_id(), id) != 0)
-                continue;
-
-            player->process_packet(packet);
-
-            // Broadcast input to other players
-            m_socket->broadcast(
-                network::UdpPacket(
-                    network::UDP_H_INPUT | network::UDP_H_POS,
-                    packet.get_move_byte(),
-                    packet.get_action_byte(),
-                    player->get_public_id()
-                 ), player->get_public_id()
-            );
-            break;
-        }
+        player->process_packet(packet);
+        player->input_applied(packet.get_pos_byte());
+
+        // Broadcast input to other players. Shoot input goes to everyone
+        // whatever their area of interest, so no client misses a press or
+        // a release and desyncs the shooter's weapon state.
+        m_socket->broadcast(
+            network::UdpPacket(
+                network::UDP_H_INPUT | network::UDP_H_POS,
+                packet.get_move_byte(),
+                packet.get_action_byte(),
+                player->get_public_id()
+             ), player->get_public_id()
+        );
         return;
     }
 }
 
 void ServerGameplayState::process_udp_queue()
 {
-    while (m_socket->has_packets())
+    std::pair<network::UdpPacket, sockaddr_in> batch[PACKET_BATCH_SIZE];
+    int n;
+    while ((n = m_socket->get_packets(batch, PACKET_BATCH_SIZE)) > 0)
     {
-        auto pair = m_socket->get_packet();
-        process_packet(pair.first, pair.second);
+        for (int i = 0; i < n; ++i)
+            process_packet(batch[i].first, batch[i].second);
     }
 }
 
+// Where the camera of a client flying at focus is centred; it stops at the
+// edges of the level like in update_transform
+math::Vector2f ServerGameplayState::get_view_centre(math::Vector2f const& focus) const
+{
+    math::Vector2f const tgt_dimf_half(math::Vector2f(Game::TARGET_DIMENSIONS) / 2.0f);
+    math::Vector2f const terrain_dimf(m_terrain_dimensions);
+    return math::Vector2f({
+        math::clamp(focus[X], tgt_dimf_half[X], terrain_dimf[X] - tgt_dimf_half[X]),
+        math::clamp(focus[Y], tgt_dimf_half[Y], terrain_dimf[Y] - tgt_dimf_half[Y])
+    });
+}
+
 void ServerGameplayState::update_pressed_keys() const
 {
     auto input = network::UDP_H_NULL;
@@ -323,119 +314,78 @@ void ServerGameplayState::update_released_keys() const
                            m_public_id));
 }
 
-void ServerGameplayState::start_pos_sync_routine()
+void ServerGameplayState::send_snapshots()
 {
-    char buffer[network::UDP_MAX_DATABLOCK_SIZE];
-    math::Vector2f pos;
-    math::Vector2f vel;
-    float rot;
-
-    m_pos_sync_running = true;
-    while (m_pos_sync_running)
+    network::PlaneState planes[network::Snapshot::MAX_PLANES];
+    int num_planes = 0;
+    for (auto p : m_players)
     {
-        if (m_players.size() == 0)
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(network::SYNC_FREQUENCY_MS));
+        if (num_planes == network::Snapshot::MAX_PLANES)
             continue;
-        }
-        for (auto p : m_players)
-        {
-            memset(buffer, network::UDP_H_NULL, network::UDP_MAX_DATABLOCK_SIZE);
-            pos = p->get_position();
-            vel = p->get_velocity();
-            rot = p->get_rotation();
-            sprintf_s(buffer, "%f|%f|%f|%f|%f",
-                      pos[X], pos[Y],
-                      rot,
-                      vel[X], vel[Y]/*,
-                      p->get_weapon_num(),
-                      p->get_weapon_ammo()*/);
-            m_socket->broadcast(network::UdpPacket(
-                               network::UDP_H_POS | network::UDP_H_DATABLOCK,
-                               p->get_public_id(),
-                               buffer));
-
-            if (p->connection_lost())
-            {
-                drop_player(p);
-                break;
-            }
-        }
-        // Sync host plane
-        {
-            memset(buffer, network::UDP_H_NULL, network::UDP_MAX_DATABLOCK_SIZE);
-            pos = m_player.get_rigid_body().get_position();
-            vel = m_player.get_rigid_body().get_velocity();
-            rot = m_player.get_rigid_body().get_rotation();
-            sprintf_s(buffer, "%f|%f|%f|%f|%f",
-                      pos[X], pos[Y],
-                      rot,
-                      vel[X], vel[Y]/*,
-                      m_player.current_weapon,
-                      m_player.get_weapon().get_rounds()*/);
-            m_socket->broadcast(network::UdpPacket(
-                               network::UDP_H_POS | network::UDP_H_DATABLOCK,
-                               m_public_id,
-                               buffer));
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(network::SYNC_FREQUENCY_MS));
-    }
-}
 
-void ServerGameplayState::start_cursor_sync_routine()
-{
-    m_cursor_sync_running = true;
-    while (m_cursor_sync_running)
+        planes[num_planes++] = network::PlaneState {
+            p->get_public_id(),
+            p->get_position(),
+            p->get_rotation(),
+            p->get_velocity(),
+            p->get_cursor_position()
+        };
+    }
+    // Host plane
+    if (num_planes < network::Snapshot::MAX_PLANES)
     {
-        while (m_players.empty())
-        {
-            std::this_thread::sleep_for(std::chrono::milliseconds(network::PING_FREQUENCY_MS / 4));
-            if (!m_cursor_sync_running)
-                return;
-        }
-
-        char buffer[network::UDP_MAX_DATABLOCK_SIZE];
-        for (auto p : m_players)
-        {
-            memset(buffer, network::UDP_MAX_DATABLOCK_SIZE, '\0');
-            sprintf_s(buffer, "%c%f|%f",
-                      p->get_public_id(),
-                      p->get_cursor_position()[X],
-                      p->get_cursor_position()[Y]);
-            m_socket->broadcast(
-                network::UdpPacket(
-                    network::UDP_H_INPUT | network::UDP_H_POS | network::UDP_H_DATABLOCK,
-                    buffer
-                ), p->get_public_id()
-            );
-        }
-        {
-            // host cursor
-            memset(buffer, network::UDP_MAX_DATABLOCK_SIZE, '\0');
-            sprintf_s(buffer, "%c%f|%f",
-                      m_public_id,
-                      m_mouse_world_position[X],
-                      m_mouse_world_position[Y]);
-            m_socket->broadcast(
-                network::UdpPacket(
-                    network::UDP_H_INPUT | network::UDP_H_POS | network::UDP_H_DATABLOCK,
-                    buffer
-                )
-            );
-        }
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(network::SYNC_FREQUENCY_MS));
+        auto& rb = m_player.get_rigid_body();
+        planes[num_planes++] = network::PlaneState {
+            m_public_id,
+            rb.get_position(),
+            rb.get_rotation(),
+            rb.get_velocity(),
+            m_mouse_world_position
+        };
     }
-}
 
-void ServerGameplayState::end_pos_sync_routine()
-{
-    m_pos_sync_running = false;
-}
+    m_interest_grid.clear();
+    for (auto i = 0; i < num_planes; ++i)
+        m_interest_grid.insert(i, planes[i].position);
 
-void ServerGameplayState::end_cursor_sync_routine()
-{
-    m_cursor_sync_running = false;
+    // Each client gets the planes in its area of interest every tick and
+    // the rest on a staggered far interval, all in one datagram.
+    auto const sequence = m_snapshot_sequence++;
+    for (auto p : m_players)
+    {
+        bool wanted[network::Snapshot::MAX_PLANES] = { false };
+        for (auto i = 0; i < num_planes; ++i)
+            wanted[i] = (sequence + i) % network::AOI_FAR_SYNC_INTERVAL == 0;
+
+        int near[network::Snapshot::MAX_PLANES];
+        auto const num_near = m_interest_grid.query(
+            get_view_centre(p->get_position()),
+            math::Vector2f({ network::AOI_HALF_WIDTH, network::AOI_HALF_HEIGHT }),
+            near, num_planes
+        );
+        for (auto i = 0; i < num_near; ++i)
+            wanted[near[i]] = true;
+
+        network::Snapshot snapshot(sequence);
+        for (auto i = 0; i < num_planes; ++i)
+            if (wanted[i])
+                snapshot.add_plane(planes[i]);
+
+        network::InputAck input_ack;
+        if (p->get_input_ack(input_ack))
+            snapshot.set_input_ack(input_ack);
+
+        // Delta against what this client was sent in the snapshot it
+        // last acknowledged, since that may lack planes the next one
+        // has; clients that have not acked anything still in the
+        // history get it all.
+        auto& sent = p->get_sent_snapshots();
+        auto const ack = p->get_snapshot_ack();
+        auto const baseline = ack < 0 ? nullptr
+                            : sent.find(static_cast<unsigned short>(ack));
+        m_socket->send(snapshot.to_packet(baseline), p->get_sockaddr());
+        sent.store(snapshot);
+    }
 }
 
 } // namespace logic
@@ -3,11 +3,14 @@
 
 #include <chrono>
 #include <memory>
+#include <thread>
 
 #include "gameplay_state.hpp"
+#include "../network/interest_grid.hpp"
 #include "../network/player.hpp"
-#include "../network/socket/server_socket_win.hpp"
-#include "../utilities/async_queue.hpp"
+#include "../network/session_table.hpp"
+#include "../network/socket/server_socket.hpp"
+#include "../network/utilities/snapshot.hpp"
 
 namespace logic {
 
@@ -31,15 +34,22 @@ namespace
 class ServerGameplayState final : public GameplayState
 {
 private:
+    using Clock = std::chrono::steady_clock;
+
+    static int const PACKET_BATCH_SIZE = 32;
+
     std::thread           m_conn_check_thread;
-    std::thread           m_cursor_sync_thread;
     std::thread           m_listener_thread;
-    std::thread           m_pos_sync_thread;
-    bool                  m_pos_sync_running;
-    bool                  m_cursor_sync_running;
+    Clock::time_point     m_next_sync;
+    unsigned short        m_snapshot_sequence;
     unsigned char         m_public_id;
     bool                  m_waiting_for_players;
 
+    network::InterestGrid   m_interest_grid;
+
+    // Same players as m_players, keyed by the token their packets carry
+    network::SessionTable<std::shared_ptr<network::Player>> m_sessions;
+
     std::unique_ptr<network::ServerSocket> m_socket;
 
 public:
@@ -69,13 +79,13 @@ private:
 
     void add_player       (network::Connection conn);
     void drop_player      (std::shared_ptr<network::Player> player);
-    void process_packet   (network::UdpPacket packet, sockaddr_in client_address);
+    void drop_lost_players();
+    void process_packet   (network::UdpPacket const& packet, sockaddr_in client_address);
     void process_udp_queue();
 
-    void start_pos_sync_routine   ();
-    void start_cursor_sync_routine();
-    void end_pos_sync_routine     ();
-    void end_cursor_sync_routine  ();
+    math::Vector2f get_view_centre(math::Vector2f const& focus) const;
+
+    void send_snapshots();
 };
 
 } // namespace logic
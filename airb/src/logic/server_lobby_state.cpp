@@ -376,8 +376,8 @@ void ServerLobbyState::add_player(sockaddr_in client_address)
 {
     for (auto p : m_connections)
     {
-        if (p->get_sockaddr().sin_addr.S_un.S_addr ==
-            client_address.sin_addr.S_un.S_addr)
+        if (p->get_sockaddr().sin_addr.s_addr ==
+            client_address.sin_addr.s_addr)
         {
             // Deny players from the same address
             //return;
@@ -388,14 +388,13 @@ void ServerLobbyState::add_player(sockaddr_in client_address)
     new_player->set_status(network::Connection::Status::CONNECTED);
     new_player->set_name("Player " + std::to_string(m_connections.size() + 2));
 
-    // Send connected player unique and public ids
-    m_socket->send(
-        network::UdpPacket(
-            network::UDP_H_CONNECT | network::UDP_H_OK | network::UDP_H_DATABLOCK | network::UDP_H_POS,
-            new_player->get_public_id(),
-            new_player->get_id()
-        ), client_address
+    // Send connected player its public id and session token
+    network::UdpPacket welcome(
+        network::UDP_H_CONNECT | network::UDP_H_OK | network::UDP_H_POS,
+        new_player->get_public_id()
     );
+    welcome.set_token(new_player->get_token());
+    m_socket->send(welcome, client_address);
     // Inform other players
     m_socket->broadcast(
         network::UdpPacket(
@@ -405,7 +404,7 @@ void ServerLobbyState::add_player(sockaddr_in client_address)
         )
     );
 
-    printf("-- DEBUG -- Player %s (%c) added\n", new_player->get_id(), new_player->get_public_id());
+    printf("-- DEBUG -- Player %08x (%c) added\n", new_player->get_token(), new_player->get_public_id());
     m_connections.push_back(new_player);
     m_socket->add_client(new_player);
 
@@ -482,15 +481,14 @@ void ServerLobbyState::drop_player(std::shared_ptr<network::Connection> player)
                                           player->get_public_id()));
 }
 
-void ServerLobbyState::process_packet(network::UdpPacket packet, sockaddr_in client_address)
+void ServerLobbyState::process_packet(network::UdpPacket const& packet, sockaddr_in client_address)
 {
     if (packet.header_contains(network::UDP_H_CONNECT) &&
-        packet.header_contains(network::UDP_H_ERROR) &&
-        packet.header_contains(network::UDP_H_DATABLOCK))
+        packet.header_contains(network::UDP_H_ERROR))
     {
         for (auto player : m_connections)
         {
-            if (strcmp(player->get_id(), packet.get_data_block()) != 0)
+            if (player->get_token() != packet.get_token())
                 continue;
 
             drop_player(player);
@@ -516,7 +514,9 @@ void ServerLobbyState::process_packet(network::UdpPacket packet, sockaddr_in cli
             break;
         }
     }
-    if (packet.header_contains(network::UDP_H_CONNECT))
+    // Only clients that have no session yet are asking to join
+    if (packet.header_contains(network::UDP_H_CONNECT) &&
+        packet.get_token() == network::NO_SESSION)
     {
         add_player(client_address);
         return;
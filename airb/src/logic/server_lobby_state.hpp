@@ -2,16 +2,16 @@
 #define LOGIC_SERVER_LOBBY_STATE_HPP
 
 #include <memory>
+#include <thread>
 
 #include "state.hpp"
 #include "../graphics/sprite.hpp"
 #include "../graphics/texture.hpp"
 #include "../network/connection.hpp"
 #include "../network/utilities/udp_packet.hpp"
-#include "../network/socket/server_socket_win.hpp"
+#include "../network/socket/server_socket.hpp"
 #include "../ui/button.hpp"
 #include "../ui/input_field.hpp"
-#include "../utilities/async_queue.hpp"
 
 namespace network {
 
@@ -52,7 +52,6 @@ private:
     std::unique_ptr<network::ServerSocket> m_socket;
 
     std::vector<std::shared_ptr<network::Connection>> m_connections;
-    utilities::AsyncQueue<std::pair<network::UdpPacket, sockaddr_in>> m_udp_queue;
 
     audio::Music& m_music;
 
@@ -78,7 +77,7 @@ private:
     void add_player       (sockaddr_in client_address);
     void assign_team      (std::shared_ptr<network::Connection> player) const;
     void drop_player      (std::shared_ptr<network::Connection> player);
-    void process_packet   (network::UdpPacket packet, sockaddr_in client_address);
+    void process_packet   (network::UdpPacket const& packet, sockaddr_in client_address);
     void process_udp_queue();
 
     unsigned char get_open_position(unsigned char const team) const;
@@ -25,4 +25,7 @@ State::State(Game& g)
     , m_mouse    (m_window.mouse)
 { }
 
+void State::interpolate(float const)
+{ }
+
 } // namespace logic
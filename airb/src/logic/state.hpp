@@ -70,6 +70,10 @@ public:
 
     virtual void update(std::chrono::milliseconds const dt) = 0;
     virtual void render() = 0;
+
+    // Called before render with how far, from 0 to 1, the frame lies
+    // between the last simulation step and the next one.
+    virtual void interpolate(float const alpha);
 };
 
 } // namespace logic
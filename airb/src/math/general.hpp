@@ -1,5 +1,5 @@
 #ifndef MATH_GENERAL_HPP
-#define MATH_GENRAL_HPP
+#define MATH_GENERAL_HPP
 
 namespace math {
 
@@ -8,6 +8,14 @@ extern float const DOUBLE_PI;
 
 template<typename T> inline T clamp  (T const val, T const min, T const max);
 template<typename T> inline T signum (T const n);
+template<typename T> inline T lerp   (T const a, T const b, float const t);
+
+inline float lerp_angle(float const a, float const b, float const t);
+
+// Sine and cosine from plain IEEE arithmetic. sinf and cosf may differ in
+// the last bit between C libraries, which is enough for two simulations of
+// the same match to drift apart; these give the same bits everywhere.
+inline void sin_cos(float const rad, float& s, float& c);
 
 } // namespace math
 
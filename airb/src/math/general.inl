@@ -1,3 +1,5 @@
+#include <cmath>
+
 namespace math {
 
 template<typename T>
@@ -12,4 +14,50 @@ inline T signum(T const n)
     return static_cast<T>((n > static_cast<T>(0)) - (n < static_cast<T>(0)));
 }
 
+template<typename T>
+inline T lerp(T const a, T const b, float const t)
+{
+    return a + (b - a) * t;
+}
+
+// Interpolates along the shorter arc so that crossing the wrap point does
+// not spin the whole way around.
+inline float lerp_angle(float const a, float const b, float const t)
+{
+    float d = fmodf(b - a, DOUBLE_PI);
+    if (d > PI)
+        d -= DOUBLE_PI;
+    else if (d < -PI)
+        d += DOUBLE_PI;
+    return a + d * t;
+}
+
+inline void sin_cos(float const rad, float& s, float& c)
+{
+    // Cody-Waite reduction to [-pi/4, pi/4] with pi/2 split in two parts,
+    // then Taylor polynomials. Done in double, so the error is far below
+    // float precision after rounding.
+    static double const TWO_OVER_PI = 6.36619772367581382433e-01;
+    static double const PI_OVER_2_HI = 1.57079632673412561417e+00;
+    static double const PI_OVER_2_LO = 6.07710050650619224932e-11;
+
+    double const x = static_cast<double>(rad);
+    double const q = std::floor(x * TWO_OVER_PI + 0.5);
+    double const r = (x - q * PI_OVER_2_HI) - q * PI_OVER_2_LO;
+    double const r2 = r * r;
+
+    double const sp = r + r * r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0 + r2 * (-1.0 / 5040.0
+                    + r2 * (1.0 / 362880.0 + r2 * (-1.0 / 39916800.0)))));
+    double const cp = 1.0 + r2 * (-1.0 / 2.0 + r2 * (1.0 / 24.0 + r2 * (-1.0 / 720.0
+                    + r2 * (1.0 / 40320.0 + r2 * (-1.0 / 3628800.0 + r2 * (1.0 / 479001600.0))))));
+
+    switch (static_cast<long long>(q) & 3)
+    {
+    case 0:  s = static_cast<float>( sp); c = static_cast<float>( cp); break;
+    case 1:  s = static_cast<float>( cp); c = static_cast<float>(-sp); break;
+    case 2:  s = static_cast<float>(-sp); c = static_cast<float>(-cp); break;
+    default: s = static_cast<float>(-cp); c = static_cast<float>( sp); break;
+    }
+}
+
 } // namespace math
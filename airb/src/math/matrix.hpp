@@ -343,10 +343,10 @@ inline Matrix4<T> rotate_3d(Vector3<T> const& axis, T const rad)
 
     return ret;
 }
-template<typename T, unsigned M, unsigned N>
+template<typename T, size_t M, size_t N>
 inline bool operator!=(Matrix<T, M, N> const& lhs, Matrix<T, M, N> const& rhs)
 {
-    for (unsigned i = 0; i < M*N; ++i)
+    for (size_t i = 0; i < M*N; ++i)
         if (lhs[i] != rhs[i])
             return true;
     return false;
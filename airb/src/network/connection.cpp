@@ -2,29 +2,26 @@
 
 #pragma warning(disable : 4996)
 
+#include <atomic>
 #include <ctime>
 
+#include "../network/utilities/snapshot.hpp"
 #include "../network/utilities/udp_packet.hpp"
+#include "../utilities/random.hpp"
 
 namespace network {
 
 Connection::Connection(sockaddr_in const si)
-    : m_sockaddr(si)
+    : m_token(issue_token())
+    , m_sockaddr(si)
     , m_last_successful_ping(time(nullptr))
     , m_name("")
     , player_num(0)
     , team(0)
     , consecutive_pings_missed(0)
     , m_status(Status::OFFLINE)
-{
-    // Dummy id implementation
-    memset(m_id, NETWORK_ID_LENGTH, '\0');
-    snprintf(m_id,
-             NETWORK_ID_LENGTH,
-             "%s-%d",
-             inet_ntoa(si.sin_addr),
-             static_cast<int>(time(nullptr)));
-}
+    , m_snapshot_ack(-1)
+{ }
 
 Connection::Connection(U8 const t, U8 const pos)
     : Connection(sockaddr_in())
@@ -35,22 +32,19 @@ Connection::Connection(U8 const t, U8 const pos)
 
 bool Connection::operator==(Connection const& rhs) const
 {
-    return strcmp(m_id, rhs.m_id) == 0;
+    return m_token == rhs.m_token;
 }
 
-bool Connection::connection_lost() const
+// Keeps the newest acknowledged snapshot, acks can arrive out of order.
+void Connection::acknowledge_snapshot(unsigned short const seq)
 {
-    return consecutive_pings_missed > MISSED_PINGS_ALLOWED;
+    if (m_snapshot_ack < 0 || sequence_newer(seq, static_cast<unsigned short>(m_snapshot_ack)))
+        m_snapshot_ack = seq;
 }
 
-std::string Connection::get_id() const
-{
-    return m_id;
-}
-
-char* Connection::get_id()
+bool Connection::connection_lost() const
 {
-    return const_cast<char*>(m_id);
+    return consecutive_pings_missed > MISSED_PINGS_ALLOWED;
 }
 
 U8 Connection::get_public_id() const
@@ -63,6 +57,11 @@ int Connection::get_last_successful_ping() const
     return static_cast<int>(m_last_successful_ping);
 }
 
+int Connection::get_snapshot_ack() const
+{
+    return m_snapshot_ack;
+}
+
 std::string Connection::get_name() const
 {
     return m_name;
@@ -78,6 +77,11 @@ Connection::Status Connection::get_status() const
     return m_status;
 }
 
+SessionToken Connection::get_token() const
+{
+    return m_token;
+}
+
 void Connection::ping_missed()
 {
     consecutive_pings_missed++;
@@ -109,4 +113,25 @@ void Connection::set_team(U8 const t)
     team = t;
 }
 
+// A salted counter run through the MurmurHash3 finaliser. The finaliser is
+// a bijection, so tokens only repeat once the counter wraps, and the salt
+// keeps a restarted server from handing out the same sequence.
+SessionToken Connection::issue_token()
+{
+    static std::uint32_t const        salt = static_cast<std::uint32_t>(utilities::Random::make_seed());
+    static std::atomic<std::uint32_t> counter(0);
+
+    SessionToken token;
+    do
+    {
+        token = salt + counter++;
+        token ^= token >> 16;
+        token *= 0x85ebca6bu;
+        token ^= token >> 13;
+        token *= 0xc2b2ae35u;
+        token ^= token >> 16;
+    } while (token == NO_SESSION);
+    return token;
+}
+
 } // namespace network
@@ -1,9 +1,10 @@
 ﻿#ifndef NETWORK_CONNECTION_HPP
 #define NETWORK_CONNECTION_HPP
 
+#include <string>
 #include <thread>
-#include <WinSock2.h>
 
+#include "socket/platform.hpp"
 #include "utilities/config.hpp"
 
 namespace network {
@@ -22,11 +23,12 @@ public:
     };
 
 protected:
-    char            m_id[NETWORK_ID_LENGTH];
+    SessionToken    m_token;
     sockaddr_in     m_sockaddr;
     time_t          m_last_successful_ping;
     std::string     m_name;
     Status          m_status;
+    int             m_snapshot_ack;
 
 public:
     unsigned char   player_num;
@@ -40,14 +42,15 @@ public:
 
     bool operator==(Connection const& rhs) const;
 
+    void                acknowledge_snapshot    (unsigned short const seq);
     bool                connection_lost         () const;
-    std::string         get_id                  () const;
-    char*               get_id                  ();
     int                 get_last_successful_ping() const;
+    int                 get_snapshot_ack        () const;
     std::string         get_name                () const;
     U8                  get_public_id           () const;
     struct sockaddr_in  get_sockaddr            () const;
     Status              get_status              () const;
+    SessionToken        get_token               () const;
 
     void                ping_missed             ();
     void                ping_received           ();
@@ -55,6 +58,10 @@ public:
     void                set_player_num          (U8 const pos);
     void                set_status              (Status st);
     void                set_team                (U8 const team);
+
+private:
+    // Never NO_SESSION and never the same twice within a process
+    static SessionToken issue_token();
 };
 
 } // namespace network
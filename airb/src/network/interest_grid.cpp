@@ -0,0 +1,77 @@
+#include "interest_grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace network {
+
+InterestGrid::InterestGrid(math::Vector2f const& world_dimensions, float const cell_size)
+    : m_cell_size (cell_size)
+    , m_columns   (std::max(1, static_cast<int>(std::ceil(world_dimensions[X] / cell_size))))
+    , m_rows      (std::max(1, static_cast<int>(std::ceil(world_dimensions[Y] / cell_size))))
+    , m_heads     (m_columns * m_rows, -1)
+    , m_next      ()
+    , m_keys      ()
+    , m_positions ()
+{ }
+
+void InterestGrid::clear()
+{
+    std::fill(m_heads.begin(), m_heads.end(), -1);
+    m_next.clear();
+    m_keys.clear();
+    m_positions.clear();
+}
+
+void InterestGrid::insert(int const key, math::Vector2f const& position)
+{
+    int const cell  = get_row(position[Y]) * m_columns + get_column(position[X]);
+    int const entry = static_cast<int>(m_keys.size());
+
+    m_next.push_back(m_heads[cell]);
+    m_keys.push_back(key);
+    m_positions.push_back(position);
+    m_heads[cell] = entry;
+}
+
+int InterestGrid::query(math::Vector2f const& centre, math::Vector2f const& half_extents,
+                        int* out, int const max) const
+{
+    int const min_col = get_column(centre[X] - half_extents[X]);
+    int const max_col = get_column(centre[X] + half_extents[X]);
+    int const min_row = get_row(centre[Y] - half_extents[Y]);
+    int const max_row = get_row(centre[Y] + half_extents[Y]);
+
+    // Cells only narrow the search; the area's edges cut through them
+    int n = 0;
+    for (int row = min_row; row <= max_row; ++row)
+    {
+        for (int col = min_col; col <= max_col; ++col)
+        {
+            for (int e = m_heads[row * m_columns + col]; e >= 0; e = m_next[e])
+            {
+                math::Vector2f const& p = m_positions[e];
+                if (std::abs(p[X] - centre[X]) > half_extents[X] ||
+                    std::abs(p[Y] - centre[Y]) > half_extents[Y])
+                    continue;
+
+                if (n == max)
+                    return n;
+                out[n++] = m_keys[e];
+            }
+        }
+    }
+    return n;
+}
+
+int InterestGrid::get_column(float const x) const
+{
+    return std::min(std::max(static_cast<int>(std::floor(x / m_cell_size)), 0), m_columns - 1);
+}
+
+int InterestGrid::get_row(float const y) const
+{
+    return std::min(std::max(static_cast<int>(std::floor(y / m_cell_size)), 0), m_rows - 1);
+}
+
+} // namespace network
@@ -0,0 +1,49 @@
+#ifndef NETWORK_INTEREST_GRID_HPP
+#define NETWORK_INTEREST_GRID_HPP
+
+#include <vector>
+
+#include "../math/matrix.hpp"
+
+namespace network {
+
+// Uniform grid over the world that buckets entity positions by cell, so the
+// entities inside a client's area of interest are found from the few cells
+// the area overlaps instead of by testing every entity in the room.
+//
+// The grid is rebuilt from scratch every sync: entries are chained through
+// index arrays and clearing only resets the cell heads, so once the entity
+// count has settled neither inserts nor queries allocate.
+class InterestGrid final
+{
+private:
+    float                       m_cell_size;
+    int                         m_columns;
+    int                         m_rows;
+    std::vector<int>            m_heads;
+    std::vector<int>            m_next;
+    std::vector<int>            m_keys;
+    std::vector<math::Vector2f> m_positions;
+
+public:
+    InterestGrid(math::Vector2f const& world_dimensions, float const cell_size);
+    ~InterestGrid() = default;
+
+    void clear();
+
+    // Positions outside the world land in the edge cells
+    void insert(int const key, math::Vector2f const& position);
+
+    // Writes the keys of the entities within half_extents of centre to out,
+    // at most max of them, and returns how many were written
+    int  query (math::Vector2f const& centre, math::Vector2f const& half_extents,
+                int* out, int const max) const;
+
+private:
+    int get_column(float const x) const;
+    int get_row   (float const y) const;
+};
+
+} // namespace network
+
+#endif // NETWORK_INTEREST_GRID_HPP
@@ -11,18 +11,27 @@ namespace network {
 Player::Player(sockaddr_in const si)
     : Connection(si)
     , m_plane(nullptr)
+    , m_sent_snapshots()
+    , m_input_ack()
+    , m_has_input_ack(false)
 { }
 
 Player::Player(Connection parent)
     : Connection(parent)
     , m_plane(nullptr)
+    , m_sent_snapshots()
+    , m_input_ack()
+    , m_has_input_ack(false)
 { }
 
 Player::Player(U8 const t, U8 const pos)
     : Connection(t, pos)
+    , m_sent_snapshots()
+    , m_input_ack()
+    , m_has_input_ack(false)
 { }
 
-void Player::process_packet(UdpPacket packet) const
+void Player::process_packet(UdpPacket const& packet) const
 {
     if (packet.header_contains(UDP_H_INPUT) ||
         packet.header_contains(UDP_H_POS))
@@ -48,13 +57,26 @@ entities::UncontrollablePlane& Player::get_plane() const
 {
     return *m_plane;
 }
-void Player::update(std::chrono::milliseconds dt, entities::LevelTerrain& terr) const
+// The plane itself is stepped with all the others by the gameplay state
+void Player::handle_input(std::chrono::milliseconds dt) const
 {
-    m_plane->update(dt, terr);
     m_plane->handle_input(m_cursor_pos, dt);
     m_plane->reset_frame();
 }
 
+void Player::input_applied(U8 const sequence)
+{
+    m_input_ack.sequence = sequence;
+    m_input_ack.ticks    = 0;
+    m_has_input_ack      = true;
+}
+
+void Player::count_input_tick()
+{
+    if (m_input_ack.ticks < 0xffff)
+        ++m_input_ack.ticks;
+}
+
 math::Vector2f Player::get_cursor_position() const
 {
     return m_cursor_pos;
@@ -100,4 +122,16 @@ physics::RigidBodyWithCollider& Player::get_rigid_body() const
     return m_plane->get_rigid_body();
 }
 
+SnapshotBuffer& Player::get_sent_snapshots()
+{
+    return m_sent_snapshots;
+}
+
+bool Player::get_input_ack(InputAck& ack) const
+{
+    if (m_has_input_ack)
+        ack = m_input_ack;
+    return m_has_input_ack;
+}
+
 }
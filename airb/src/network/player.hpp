@@ -2,10 +2,11 @@
 #define NETWORK_PLAYER_HPP
 
 #include <thread>
-#include <WinSock2.h>
 
 #include "connection.hpp"
+#include "socket/platform.hpp"
 #include "utilities/config.hpp"
+#include "utilities/snapshot.hpp"
 #include "../entities/uncontrollable_plane.hpp"
 
 namespace network {
@@ -16,18 +17,28 @@ private:
     math::Vector2f  m_cursor_pos;
     std::unique_ptr<entities::UncontrollablePlane> m_plane;
 
+    // Snapshots as they were sent to this player; each one only holds the
+    // planes that were in its area of interest or due for a far update
+    SnapshotBuffer  m_sent_snapshots;
+
+    // Latest input applied to this player's plane and the ticks since
+    InputAck        m_input_ack;
+    bool            m_has_input_ack;
+
 public:
     explicit Player(sockaddr_in const si);
     explicit Player(Connection parent);
              Player(U8 const team, U8 const pos);
             ~Player() = default;
 
-    void process_packet     (UdpPacket packet) const;
+    void process_packet     (UdpPacket const& packet) const;
     void set_cursor_position(float x, float y);
     void set_plane          (std::unique_ptr<entities::UncontrollablePlane> plane);
     void set_weapon_ammo    (char ammo);
     void set_weapon_num     (char num);
-    void update             (std::chrono::milliseconds dt, entities::LevelTerrain& terr) const;
+    void handle_input       (std::chrono::milliseconds dt) const;
+    void input_applied      (U8 const sequence);
+    void count_input_tick   ();
 
     entities::UncontrollablePlane& get_plane() const;
     math::Vector2f      get_cursor_position     () const;
@@ -39,6 +50,8 @@ public:
     char                get_weapon_num          () const;
     graphics::Sprite&   get_weapon_sprite       () const;
     physics::RigidBodyWithCollider& get_rigid_body() const;
+    SnapshotBuffer&     get_sent_snapshots      ();
+    bool                get_input_ack           (InputAck& ack) const;
 };
 
 } // namespace network
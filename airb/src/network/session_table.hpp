@@ -0,0 +1,65 @@
+#ifndef NETWORK_SESSION_TABLE_HPP
+#define NETWORK_SESSION_TABLE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "utilities/config.hpp"
+
+namespace network {
+
+// Flat hash map from session tokens to whatever a server keeps per
+// session, so a packet is matched to its sender with one or two slot
+// reads instead of a string compare against every connection.
+//
+// Tokens are already well mixed, so their low bits pick the home slot
+// directly. Collisions probe linearly and removal shifts the rest of the
+// probe run back, so no tombstones build up. The slot array doubles once
+// it is half full; sizing it for the expected number of sessions up front
+// keeps it from ever reallocating. NO_SESSION marks an empty slot and can
+// not be stored.
+template<class T>
+class SessionTable final
+{
+private:
+    struct Slot
+    {
+        SessionToken token;
+        T            value;
+
+        Slot() : token(NO_SESSION), value() { }
+    };
+
+    std::vector<Slot> m_slots;
+    std::size_t       m_size;
+
+public:
+    explicit SessionTable(std::size_t const capacity = 16);
+            ~SessionTable() = default;
+
+    // Returns false if the token is already in the table
+    bool     insert (SessionToken const token, T const& value);
+    bool     erase  (SessionToken const token);
+    void     clear  ();
+
+    T*       find   (SessionToken const token);
+    T const* find   (SessionToken const token) const;
+
+    // Calls func(token, value) for every session, in no particular order;
+    // func must not insert or erase
+    template<class Func>
+    void for_each(Func const& func) const;
+
+    std::size_t get_size() const;
+
+private:
+    std::size_t find_slot (SessionToken const token) const;
+    std::size_t get_home  (SessionToken const token) const;
+    void        grow      ();
+};
+
+} // namespace network
+
+#include "session_table.tpp"
+
+#endif // NETWORK_SESSION_TABLE_HPP
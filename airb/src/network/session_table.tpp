@@ -0,0 +1,147 @@
+#include <utility>
+
+namespace network {
+
+template<class T>
+SessionTable<T>::SessionTable(std::size_t const capacity)
+    : m_slots ()
+    , m_size  (0)
+{
+    std::size_t n = 4;
+    while (n < capacity * 2)
+        n <<= 1;
+    m_slots.resize(n);
+}
+
+template<class T>
+bool SessionTable<T>::insert(SessionToken const token, T const& value)
+{
+    if (token == NO_SESSION || find_slot(token) != m_slots.size())
+        return false;
+
+    if ((m_size + 1) * 2 > m_slots.size())
+        grow();
+
+    std::size_t const mask = m_slots.size() - 1;
+    std::size_t i = get_home(token);
+    while (m_slots[i].token != NO_SESSION)
+        i = (i + 1) & mask;
+
+    m_slots[i].token = token;
+    m_slots[i].value = value;
+    ++m_size;
+    return true;
+}
+
+template<class T>
+bool SessionTable<T>::erase(SessionToken const token)
+{
+    std::size_t i = find_slot(token);
+    if (i == m_slots.size())
+        return false;
+
+    // Pull back every later entry of the probe run that would no longer be
+    // reachable from its home slot across the hole
+    std::size_t const mask = m_slots.size() - 1;
+    for (std::size_t j = (i + 1) & mask; m_slots[j].token != NO_SESSION; j = (j + 1) & mask)
+    {
+        std::size_t const home = get_home(m_slots[j].token);
+        bool const reachable = i <= j ? (i < home && home <= j)
+                                      : (i < home || home <= j);
+        if (reachable)
+            continue;
+
+        m_slots[i] = std::move(m_slots[j]);
+        i = j;
+    }
+
+    m_slots[i].token = NO_SESSION;
+    m_slots[i].value = T();
+    --m_size;
+    return true;
+}
+
+template<class T>
+void SessionTable<T>::clear()
+{
+    for (auto& s : m_slots)
+    {
+        s.token = NO_SESSION;
+        s.value = T();
+    }
+    m_size = 0;
+}
+
+template<class T>
+T* SessionTable<T>::find(SessionToken const token)
+{
+    std::size_t const i = find_slot(token);
+    return i == m_slots.size() ? nullptr : &m_slots[i].value;
+}
+
+template<class T>
+T const* SessionTable<T>::find(SessionToken const token) const
+{
+    std::size_t const i = find_slot(token);
+    return i == m_slots.size() ? nullptr : &m_slots[i].value;
+}
+
+template<class T>
+template<class Func>
+void SessionTable<T>::for_each(Func const& func) const
+{
+    for (auto const& s : m_slots)
+    {
+        if (s.token != NO_SESSION)
+            func(s.token, s.value);
+    }
+}
+
+template<class T>
+std::size_t SessionTable<T>::get_size() const
+{
+    return m_size;
+}
+
+// Returns the slot count if the token is not in the table
+template<class T>
+std::size_t SessionTable<T>::find_slot(SessionToken const token) const
+{
+    if (token == NO_SESSION)
+        return m_slots.size();
+
+    std::size_t const mask = m_slots.size() - 1;
+    for (std::size_t i = get_home(token); m_slots[i].token != NO_SESSION; i = (i + 1) & mask)
+    {
+        if (m_slots[i].token == token)
+            return i;
+    }
+    return m_slots.size();
+}
+
+template<class T>
+std::size_t SessionTable<T>::get_home(SessionToken const token) const
+{
+    return static_cast<std::size_t>(token) & (m_slots.size() - 1);
+}
+
+template<class T>
+void SessionTable<T>::grow()
+{
+    std::vector<Slot> old(m_slots.size() * 2);
+    old.swap(m_slots);
+
+    std::size_t const mask = m_slots.size() - 1;
+    for (auto& s : old)
+    {
+        if (s.token == NO_SESSION)
+            continue;
+
+        std::size_t i = get_home(s.token);
+        while (m_slots[i].token != NO_SESSION)
+            i = (i + 1) & mask;
+        m_slots[i] = std::move(s);
+    }
+}
+
+} // namespace network
@@ -0,0 +1,10 @@
+#ifndef NETWORK_CLIENT_SOCKET_HPP
+#define NETWORK_CLIENT_SOCKET_HPP
+
+#ifdef _WIN32
+#include "client_socket_win.hpp"
+#else
+#include "client_socket_posix.hpp"
+#endif
+
+#endif // NETWORK_CLIENT_SOCKET_HPP
@@ -0,0 +1,293 @@
+#include "client_socket_posix.hpp"
+
+#ifndef _WIN32
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
+
+#include "../utilities/config.hpp"
+#include "../utilities/functions.hpp"
+
+namespace network {
+
+ClientSocket::ClientSocket(std::string server_address, unsigned short server_port)
+    : m_listener_running(false)
+    , m_keepalive_running(false)
+    , m_socket(-1)
+    , m_epoll(-1)
+    , m_wakeup(-1)
+    , m_server_addr(server_address)
+    , m_token(NO_SESSION)
+    , m_queue(QUEUE_CAPACITY)
+{
+    memset(reinterpret_cast<char *>(&m_server_sockaddr), 0, sizeof m_server_sockaddr);
+    m_server_sockaddr.sin_family = AF_INET;
+    m_server_sockaddr.sin_port = htons(server_port);
+    m_server_sockaddr.sin_addr.s_addr = inet_addr(m_server_addr.c_str());
+
+    // The epoll set and its eventfd outlive open()/close() cycles, so a
+    // wakeup posted by end_listener_routine() is never lost to a close().
+    m_epoll  = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll == -1 || m_wakeup == -1)
+    {
+        printf("epoll setup failed with error : %s\n", strerror(errno));
+        throw std::runtime_error("Socket epoll setup failed.");
+    }
+
+    struct epoll_event ev;
+    ev.events  = EPOLLIN;
+    ev.data.fd = m_wakeup;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &ev);
+
+    open();
+}
+
+ClientSocket::~ClientSocket()
+{
+    close();
+    ::close(m_epoll);
+    ::close(m_wakeup);
+}
+
+void ClientSocket::open()
+{
+    close();
+
+    // Create socket
+    m_socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, IPPROTO_UDP);
+    if (m_socket == -1)
+    {
+        print_time();
+        printf("socket() failed with error : %s\n", strerror(errno));
+        throw std::runtime_error("Socket creation failed.");
+    }
+
+    int reuse = 1;
+    setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof reuse);
+
+    struct sockaddr_in listener;
+    memset(&listener, 0, sizeof listener);
+    listener.sin_family = AF_INET;
+    listener.sin_port = htons(8887);
+    listener.sin_addr.s_addr = INADDR_ANY;
+    if (bind(m_socket, reinterpret_cast<struct sockaddr *>(&listener), sizeof listener) == -1)
+    {
+        printf("Bind failed with error : %s\n", strerror(errno));
+        close();
+        throw std::runtime_error("Socket bind() failed.");
+    }
+
+    // Closing the previous socket already took it out of the epoll set.
+    struct epoll_event ev;
+    ev.events  = EPOLLIN;
+    ev.data.fd = m_socket;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_socket, &ev);
+}
+
+void ClientSocket::close()
+{
+    if (m_socket == -1)
+        return;
+
+    shutdown(m_socket, SHUT_RDWR);
+    ::close(m_socket);
+    m_socket = -1;
+}
+
+void ClientSocket::init_connect()
+{
+    print_time();
+    printf("Attempting to connect...\n");
+    send(UdpPacket(UDP_H_CONNECT));
+}
+
+void ClientSocket::receive_batch()
+{
+    char           buffers[RECV_BATCH_SIZE][UDP_MAX_PACKET_SIZE];
+    struct iovec   iov[RECV_BATCH_SIZE];
+    struct mmsghdr msgs[RECV_BATCH_SIZE];
+
+    for (;;)
+    {
+        memset(msgs, 0, sizeof msgs);
+        for (int i = 0; i < RECV_BATCH_SIZE; ++i)
+        {
+            iov[i].iov_base           = buffers[i];
+            iov[i].iov_len            = UDP_MAX_PACKET_SIZE;
+            msgs[i].msg_hdr.msg_iov    = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int const count = recvmmsg(m_socket, msgs, RECV_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (count <= 0)
+            return;
+
+        for (int i = 0; i < count; ++i)
+        {
+            UdpPacketView const view(buffers[i], static_cast<int>(msgs[i].msg_len));
+            if (view.is_valid())
+                process_packet(view);
+        }
+
+        if (count < RECV_BATCH_SIZE)
+            return;
+    }
+}
+
+void ClientSocket::start_listener_routine()
+{
+    struct epoll_event events[2];
+
+    m_listener_running = true;
+    while (m_listener_running)
+    {
+        int const count = epoll_wait(m_epoll, events, 2, -1);
+        if (count == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        for (int i = 0; i < count && m_listener_running; ++i)
+        {
+            if (events[i].data.fd == m_wakeup)
+                drain_wakeup();
+            else
+                receive_batch();
+        }
+    }
+}
+
+void ClientSocket::start_keepalive_routine()
+{
+    m_keepalive_running = true;
+    while (m_keepalive_running)
+    {
+        while (m_token == NO_SESSION)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(PING_FREQUENCY_MS/4));
+            // Debug window closed
+            if (!m_keepalive_running)
+                return;
+        }
+
+        send(UdpPacket(UDP_H_KEEPALIVE));
+        std::this_thread::sleep_for(std::chrono::milliseconds(PING_FREQUENCY_MS));
+    }
+}
+
+void ClientSocket::end_listener_routine()
+{
+    m_listener_running = false;
+
+    uint64_t const one = 1;
+    (void) write(m_wakeup, &one, sizeof one);
+}
+
+void ClientSocket::drain_wakeup()
+{
+    // Reset the counter so a listener restarted after a reopen blocks again.
+    uint64_t count;
+    (void) read(m_wakeup, &count, sizeof count);
+}
+
+void ClientSocket::end_keepalive_routine()
+{
+    m_keepalive_running = false;
+}
+
+void ClientSocket::send(UdpPacket const& packet)
+{
+    UdpPacket stamped(packet);
+    stamped.set_token(m_token);
+    if (sendto(m_socket,
+               stamped.to_char_array(),
+               stamped.get_size(),
+               0,
+               reinterpret_cast<struct sockaddr *>(&m_server_sockaddr),
+               sizeof m_server_sockaddr) == -1)
+    {
+        print_time();
+        printf("sendto() failed with error : %s\n", strerror(errno));
+    }
+    if (!packet.header_contains(UDP_H_KEEPALIVE) && !packet.header_contains(UDP_H_INPUT))
+    {
+        print_time();
+        printf("Packet sent to server.\n");
+        stamped.print();
+    }
+}
+
+void ClientSocket::set_token(SessionToken const token)
+{
+    m_token = token;
+}
+
+bool ClientSocket::has_packets() const
+{
+    return !m_queue.empty();
+}
+
+SessionToken ClientSocket::get_token() const
+{
+    return m_token;
+}
+
+UdpPacket ClientSocket::get_packet()
+{
+    UdpPacket packet;
+    m_queue.try_dequeue(packet);
+    return packet;
+}
+
+int ClientSocket::get_packets(UdpPacket* out, int const max)
+{
+    return static_cast<int>(m_queue.try_dequeue_bulk(out, static_cast<std::size_t>(max)));
+}
+
+std::string ClientSocket::get_server_addr() const
+{
+    return m_server_addr;
+}
+
+void ClientSocket::process_packet(UdpPacketView const& view)
+{
+    UdpPacket packet(view);
+    if (!packet.header_contains(UDP_H_INPUT) && !packet.header_contains(UDP_H_POS))
+    {
+        print_time();
+        printf("Received packet from server\n");
+        packet.print();
+    }
+    if (packet.header_contains(UDP_H_CONNECT) &&
+        packet.header_contains(UDP_H_OK) &&
+        packet.get_token() != NO_SESSION)
+    {
+        // First connect, server returns our session token
+        m_token = packet.get_token();
+        print_time();
+        printf("Connected. My session is %08x\n", packet.get_token());
+    }
+    if (packet.header_contains(UDP_H_CONNECT) &&
+        packet.header_contains(UDP_H_ERROR))
+    {
+        print_time();
+        printf("Server refused connection...\n");
+    }
+    // A full queue drops the datagram like a full socket buffer would
+    m_queue.try_enqueue(std::move(packet));
+}
+
+} // namespace network
+
+#endif // _WIN32
@@ -0,0 +1,69 @@
+#ifndef NETWORK_CLIENT_SOCKET_POSIX_HPP
+#define NETWORK_CLIENT_SOCKET_POSIX_HPP
+
+#ifndef _WIN32
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "platform.hpp"
+#include "../utilities/udp_packet.hpp"
+#include "../../utilities/ring_buffer.hpp"
+
+namespace network {
+
+// POSIX counterpart of the Winsock client socket, driven by epoll and
+// recvmmsg the same way as the server side.
+class ClientSocket
+{
+private:
+    static int const RECV_BATCH_SIZE = 16;
+    static int const QUEUE_CAPACITY  = 256;
+
+    bool        m_listener_running;
+    bool        m_keepalive_running;
+    int         m_socket;
+    int         m_epoll;
+    int         m_wakeup;
+    std::string m_server_addr;
+    sockaddr_in m_server_sockaddr;
+
+    // Issued by the server on connect and stamped on every packet sent
+    std::atomic<SessionToken> m_token;
+
+    utilities::RingBuffer<UdpPacket> m_queue;
+
+public:
+     ClientSocket(std::string server_address, unsigned short server_port);
+    ~ClientSocket();
+
+    void open                   ();
+    void close                  ();
+    void init_connect           ();
+    void send                   (UdpPacket const& packet);
+    void set_token              (SessionToken const token);
+
+    void start_listener_routine ();
+    void start_keepalive_routine();
+    void end_listener_routine   ();
+    void end_keepalive_routine  ();
+
+    bool        has_packets     () const;
+    SessionToken get_token      () const;
+    UdpPacket   get_packet      ();
+    int         get_packets     (UdpPacket* out, int const max);
+    std::string get_server_addr () const;
+
+private:
+    void process_packet(UdpPacketView const& packet);
+    void receive_batch ();
+    void drain_wakeup  ();
+
+};
+
+} // namespace network
+
+#endif // _WIN32
+
+#endif // NETWORK_CLIENT_SOCKET_POSIX_HPP
@@ -1,7 +1,10 @@
 ﻿#include "client_socket_win.hpp"
 
+#ifdef _WIN32
+
 #include <cstdio>
 #include <thread>
+#include <utility>
 
 #include "../player.hpp"
 #include "../utilities/functions.hpp"
@@ -11,9 +14,9 @@ namespace network {
 ClientSocket::ClientSocket(std::string server_address, unsigned short server_port)
     : m_listener_running(false)
     , m_keepalive_running(false)
-    , m_id { '\0' }
     , m_server_addr(server_address)
-    , m_queue()
+    , m_token(NO_SESSION)
+    , m_queue(QUEUE_CAPACITY)
 {
     memset(reinterpret_cast<char *>(&m_server_sockaddr), 0, sizeof m_server_sockaddr);
     m_server_sockaddr.sin_family = AF_INET;
@@ -85,8 +88,6 @@ void ClientSocket::start_listener_routine()
     m_listener_running = true;
     while (m_listener_running)
     {
-        memset(buffer, UDP_H_NULL, UDP_MAX_PACKET_SIZE);
-
         recv_data = recvfrom(m_socket,
                              buffer,
                              sizeof buffer,
@@ -101,7 +102,9 @@ void ClientSocket::start_listener_routine()
             continue;
         }
 
-        process_packet(UdpPacket(buffer));
+        UdpPacketView const view(buffer, recv_data);
+        if (view.is_valid())
+            process_packet(view);
     }
 }
 
@@ -110,7 +113,7 @@ void ClientSocket::start_keepalive_routine()
     m_keepalive_running = true;
     while (m_keepalive_running)
     {
-        while(m_id[0] == '\0')
+        while (m_token == NO_SESSION)
         {
             std::this_thread::sleep_for(std::chrono::milliseconds(PING_FREQUENCY_MS/4));
             // Debug window closed
@@ -118,7 +121,7 @@ void ClientSocket::start_keepalive_routine()
                 return;
         }
 
-        send(UdpPacket(UDP_H_KEEPALIVE | UDP_H_DATABLOCK, m_id));
+        send(UdpPacket(UDP_H_KEEPALIVE));
         std::this_thread::sleep_for(std::chrono::milliseconds(PING_FREQUENCY_MS));
     }
 }
@@ -133,13 +136,15 @@ void ClientSocket::end_keepalive_routine()
     m_keepalive_running = false;
 }
 
-void ClientSocket::send(UdpPacket packet)
+void ClientSocket::send(UdpPacket const& packet)
 {
+    UdpPacket stamped(packet);
+    stamped.set_token(m_token);
     int slen = sizeof m_server_sockaddr;
 
     if (sendto(m_socket,
-               packet.to_char_array(),
-               packet.get_size(),
+               stamped.to_char_array(),
+               stamped.get_size(),
                0,
                reinterpret_cast<struct sockaddr *>(&m_server_sockaddr),
                slen) == SOCKET_ERROR)
@@ -151,15 +156,13 @@ void ClientSocket::send(UdpPacket packet)
     {
         print_time();
         printf("Packet sent to server.\n");
-        packet.print();
+        stamped.print();
     }
 }
 
-void ClientSocket::set_client_id(char const* id)
+void ClientSocket::set_token(SessionToken const token)
 {
-    auto i = 0;
-    while (id[i] != '\0')
-        m_id[i] = id[i++];
+    m_token = token;
 }
 
 
@@ -168,14 +171,21 @@ bool ClientSocket::has_packets() const
     return !m_queue.empty();
 }
 
-char* ClientSocket::get_client_id() const
+SessionToken ClientSocket::get_token() const
 {
-    return const_cast<char*>(&m_id[0]);
+    return m_token;
 }
 
 UdpPacket ClientSocket::get_packet()
 {
-    return m_queue.dequeue();
+    UdpPacket packet;
+    m_queue.try_dequeue(packet);
+    return packet;
+}
+
+int ClientSocket::get_packets(UdpPacket* out, int const max)
+{
+    return static_cast<int>(m_queue.try_dequeue_bulk(out, static_cast<std::size_t>(max)));
 }
 
 std::string ClientSocket::get_server_addr() const
@@ -183,8 +193,9 @@ std::string ClientSocket::get_server_addr() const
     return m_server_addr;
 }
 
-void ClientSocket::process_packet(UdpPacket const packet)
+void ClientSocket::process_packet(UdpPacketView const& view)
 {
+    UdpPacket packet(view);
     if (!packet.header_contains(UDP_H_INPUT) && !packet.header_contains(UDP_H_POS))
     {
         print_time();
@@ -193,12 +204,12 @@ void ClientSocket::process_packet(UdpPacket const packet)
     }
     if (packet.header_contains(UDP_H_CONNECT) &&
         packet.header_contains(UDP_H_OK) &&
-        packet.header_contains(UDP_H_DATABLOCK))
+        packet.get_token() != NO_SESSION)
     {
-        // First connect, server returns unique id
-        strcpy_s(m_id, packet.get_data_block());
+        // First connect, server returns our session token
+        m_token = packet.get_token();
         print_time();
-        printf("Connected. My id is %s\n", m_id);
+        printf("Connected. My session is %08x\n", packet.get_token());
     }
     if (packet.header_contains(UDP_H_CONNECT) &&
         packet.header_contains(UDP_H_ERROR))
@@ -207,7 +218,10 @@ void ClientSocket::process_packet(UdpPacket const packet)
         printf("Server refused connection...\n");
         //close();
     }
-    m_queue.enqueue(packet);
+    // A full queue drops the datagram like a full socket buffer would
+    m_queue.try_enqueue(std::move(packet));
 }
 
 } // namespace network
+
+#endif // _WIN32
@@ -1,27 +1,35 @@
 ﻿#ifndef NETWORK_CLIENT_SOCKET_WIN_HPP
 #define NETWORK_CLIENT_SOCKET_WIN_HPP
 
+#ifdef _WIN32
+
+#include <atomic>
 #include <memory>
+#include <string>
 #include <winsock2.h>
 
 #pragma comment(lib,"ws2_32.lib")
 
 #include "../utilities/udp_packet.hpp"
-#include "../../utilities/async_queue.hpp"
+#include "../../utilities/ring_buffer.hpp"
 
 namespace network {
 
 class ClientSocket
 {
 private:
+    static int const QUEUE_CAPACITY = 256;
+
     bool        m_listener_running;
     bool        m_keepalive_running;
-    char        m_id[NETWORK_ID_LENGTH];
     SOCKET      m_socket;
     std::string m_server_addr;
     sockaddr_in m_server_sockaddr;
 
-    utilities::AsyncQueue<UdpPacket> m_queue;
+    // Issued by the server on connect and stamped on every packet sent
+    std::atomic<SessionToken> m_token;
+
+    utilities::RingBuffer<UdpPacket> m_queue;
 
 public:
      ClientSocket(std::string server_address, unsigned short server_port);
@@ -30,8 +38,8 @@ public:
     void open                   ();
     void close                  () const;
     void init_connect           ();
-    void send                   (UdpPacket packet);
-    void set_client_id          (char const* id);
+    void send                   (UdpPacket const& packet);
+    void set_token              (SessionToken const token);
 
     void start_listener_routine ();
     void start_keepalive_routine();
@@ -39,15 +47,18 @@ public:
     void end_keepalive_routine  ();
 
     bool        has_packets     () const;
-    char*       get_client_id   () const;
+    SessionToken get_token      () const;
     UdpPacket   get_packet      ();
+    int         get_packets     (UdpPacket* out, int const max);
     std::string get_server_addr () const;
 
 private:
-    void process_packet(UdpPacket const packet);
+    void process_packet(UdpPacketView const& packet);
 
 };
 
 } // namespace network
 
+#endif // _WIN32
+
 #endif // NETWORK_CLIENT_SOCKET_WIN_HPP
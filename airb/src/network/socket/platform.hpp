@@ -0,0 +1,15 @@
+#ifndef NETWORK_SOCKET_PLATFORM_HPP
+#define NETWORK_SOCKET_PLATFORM_HPP
+
+// Brings in sockaddr_in and the address helpers for whichever socket
+// backend is being built, so shared network code stays platform neutral.
+
+#ifdef _WIN32
+#include <winsock2.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#endif
+
+#endif // NETWORK_SOCKET_PLATFORM_HPP
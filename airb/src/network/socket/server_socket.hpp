@@ -0,0 +1,10 @@
+#ifndef NETWORK_SERVER_SOCKET_HPP
+#define NETWORK_SERVER_SOCKET_HPP
+
+#ifdef _WIN32
+#include "server_socket_win.hpp"
+#else
+#include "server_socket_posix.hpp"
+#endif
+
+#endif // NETWORK_SERVER_SOCKET_HPP
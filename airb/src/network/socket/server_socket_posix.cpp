@@ -0,0 +1,420 @@
+#include "server_socket_posix.hpp"
+
+#ifndef _WIN32
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <netdb.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <thread>
+#include <unistd.h>
+
+#include "../utilities/config.hpp"
+#include "../utilities/functions.hpp"
+
+namespace network {
+
+ServerSocket::ServerSocket(unsigned short port)
+    : m_listener_running(false)
+    , m_conn_check_running(false)
+    , m_socket(-1)
+    , m_epoll(-1)
+    , m_wakeup(-1)
+    , m_port(port)
+    , m_connections()
+    , m_sessions(SESSION_CAPACITY)
+    , m_sessions_mutex()
+    , m_queue(QUEUE_CAPACITY)
+{
+    memset(&m_sockaddr, 0, sizeof m_sockaddr);
+    m_sockaddr.sin_family = AF_INET;
+    m_sockaddr.sin_port = htons(m_port);
+    m_sockaddr.sin_addr.s_addr = INADDR_ANY;
+
+    // The epoll set and its eventfd outlive open()/close() cycles, so a
+    // wakeup posted by end_listener_routine() is never lost to a close().
+    m_epoll  = epoll_create1(EPOLL_CLOEXEC);
+    m_wakeup = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_epoll == -1 || m_wakeup == -1)
+    {
+        printf("epoll setup failed with error : %s\n", strerror(errno));
+        throw std::runtime_error("Socket epoll setup failed.");
+    }
+
+    struct epoll_event ev;
+    ev.events  = EPOLLIN;
+    ev.data.fd = m_wakeup;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_wakeup, &ev);
+
+    open();
+}
+
+ServerSocket::~ServerSocket()
+{
+    close();
+    ::close(m_epoll);
+    ::close(m_wakeup);
+}
+
+void ServerSocket::open()
+{
+    // The lobby hands its socket over to the gameplay state, which opens it
+    // again; drop the old socket first so the port can be rebound.
+    close();
+
+    // Create a socket
+    print_time();
+    m_socket = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (m_socket == -1)
+    {
+        printf("Could not create socket : %s\n", strerror(errno));
+        throw std::runtime_error("Socket creation failed.");
+    }
+    printf("Socket created.\n");
+
+    int reuse = 1;
+    setsockopt(m_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof reuse);
+
+    // Input from every client lands on this one socket between wakeups.
+    int recv_buffer = RECV_BUFFER_SIZE;
+    setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF, &recv_buffer, sizeof recv_buffer);
+
+    // Bind
+    print_time();
+    if (bind(m_socket, reinterpret_cast<struct sockaddr *>(&m_sockaddr), sizeof m_sockaddr) == -1)
+    {
+        printf("Bind failed with error : %s\n", strerror(errno));
+        close();
+        throw std::runtime_error("Socket bind() failed.");
+    }
+    printf("Socket bind successful.\n");
+
+    // Closing the previous socket already took it out of the epoll set.
+    struct epoll_event ev;
+    ev.events  = EPOLLIN;
+    ev.data.fd = m_socket;
+    epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_socket, &ev);
+}
+
+void ServerSocket::process_packet(UdpPacketView const& packet, sockaddr_in const si_client)
+{
+    if (!packet.header_contains(UDP_H_KEEPALIVE) &&
+        !packet.header_contains(UDP_H_INPUT)     &&
+        !packet.header_contains(UDP_H_POS))
+    {
+        // Debug
+        print_time();
+        printf("Received packet from %s:%d\n",
+               inet_ntoa(si_client.sin_addr),
+               ntohs(si_client.sin_port));
+        printf("           > Packet size: %d byte(s)\n", packet.get_size());
+
+        UdpPacket(packet).print();
+    }
+    if (packet.header_contains(UDP_H_KEEPALIVE))
+    {
+        // Keepalives are answered straight from the receive buffer
+        ping_received(packet.get_token());
+        return;
+    }
+    // A full queue drops the datagram like a full socket buffer would
+    m_queue.try_enqueue(std::pair<UdpPacket, sockaddr_in>(UdpPacket(packet), si_client));
+}
+
+void ServerSocket::receive_batch()
+{
+    char           buffers[RECV_BATCH_SIZE][UDP_MAX_PACKET_SIZE];
+    sockaddr_in    senders[RECV_BATCH_SIZE];
+    struct iovec   iov[RECV_BATCH_SIZE];
+    struct mmsghdr msgs[RECV_BATCH_SIZE];
+
+    for (;;)
+    {
+        memset(msgs, 0, sizeof msgs);
+        for (int i = 0; i < RECV_BATCH_SIZE; ++i)
+        {
+            iov[i].iov_base            = buffers[i];
+            iov[i].iov_len             = UDP_MAX_PACKET_SIZE;
+            msgs[i].msg_hdr.msg_iov     = &iov[i];
+            msgs[i].msg_hdr.msg_iovlen  = 1;
+            msgs[i].msg_hdr.msg_name    = &senders[i];
+            msgs[i].msg_hdr.msg_namelen = sizeof senders[i];
+        }
+
+        int const count = recvmmsg(m_socket, msgs, RECV_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+        if (count <= 0)
+            return; // EAGAIN once the socket is drained
+
+        for (int i = 0; i < count; ++i)
+        {
+            UdpPacketView const view(buffers[i], static_cast<int>(msgs[i].msg_len));
+            if (view.is_valid())
+                process_packet(view, senders[i]);
+        }
+
+        if (count < RECV_BATCH_SIZE)
+            return;
+    }
+}
+
+void ServerSocket::send_batch(UdpPacket const& packet, sockaddr_in const* to, int const count) const
+{
+    struct iovec   iov;
+    struct mmsghdr msgs[SEND_BATCH_SIZE];
+
+    iov.iov_base = const_cast<char*>(packet.to_char_array());
+    iov.iov_len  = packet.get_size();
+
+    memset(msgs, 0, sizeof msgs);
+    for (int i = 0; i < count; ++i)
+    {
+        msgs[i].msg_hdr.msg_iov     = &iov;
+        msgs[i].msg_hdr.msg_iovlen  = 1;
+        msgs[i].msg_hdr.msg_name    = const_cast<sockaddr_in*>(&to[i]);
+        msgs[i].msg_hdr.msg_namelen = sizeof to[i];
+    }
+
+    int sent = 0;
+    while (sent < count)
+    {
+        int const n = sendmmsg(m_socket, msgs + sent, count - sent, 0);
+        if (n == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            print_time();
+            printf("sendmmsg() failed with error : %s\n", strerror(errno));
+            return;
+        }
+        sent += n;
+    }
+}
+
+void ServerSocket::add_client(std::shared_ptr<Connection> client)
+{
+    m_connections.push_back(client);
+
+    std::lock_guard<std::mutex> lock(m_sessions_mutex);
+    m_sessions.insert(client->get_token(), client);
+}
+
+void ServerSocket::broadcast(UdpPacket const& packet) const
+{
+    broadcast_to(packet, -1);
+}
+
+void ServerSocket::broadcast(UdpPacket const& packet, U8 const exclude_client_id) const
+{
+    broadcast_to(packet, exclude_client_id);
+}
+
+// A negative id excludes nobody.
+void ServerSocket::broadcast_to(UdpPacket const& packet, int const exclude_client_id) const
+{
+    sockaddr_in to[SEND_BATCH_SIZE];
+    int         count = 0;
+    for (auto const& client : m_connections)
+    {
+        if (client->get_public_id() == exclude_client_id)
+            continue;
+
+        to[count++] = client->get_sockaddr();
+        if (count == SEND_BATCH_SIZE)
+        {
+            send_batch(packet, to, count);
+            count = 0;
+        }
+    }
+    if (count > 0)
+        send_batch(packet, to, count);
+}
+
+void ServerSocket::drop_client(std::shared_ptr<Connection> client)
+{
+    print_time();
+    printf("Client %08x disconnected\n", client->get_token());
+    {
+        std::lock_guard<std::mutex> lock(m_sessions_mutex);
+        m_sessions.erase(client->get_token());
+    }
+    for (auto c : m_connections)
+    {
+        if (c->get_token() != client->get_token())
+            continue;
+
+        m_connections.erase(remove(m_connections.begin(),
+                                   m_connections.end(),
+                                   c),
+                                   m_connections.end());
+        return;
+    }
+}
+
+void ServerSocket::ping_received(SessionToken const token) const
+{
+    // Take a reference under the lock so a concurrent drop_client() can
+    // not free the connection while it is being touched
+    std::shared_ptr<Connection> client;
+    {
+        std::lock_guard<std::mutex> lock(m_sessions_mutex);
+        auto const found = m_sessions.find(token);
+        if (found == nullptr)
+            return;
+        client = *found;
+    }
+    client->ping_received();
+}
+
+void ServerSocket::send(UdpPacket const& packet, sockaddr_in to) const
+{
+    auto send_data = sendto(m_socket,
+                            packet.to_char_array(),
+                            packet.get_size(),
+                            0,
+                            reinterpret_cast<struct sockaddr*>(&to),
+                            sizeof to);
+    if (send_data == -1)
+    {
+        print_time();
+        printf("sendto() failed with error : %s\n", strerror(errno));
+    }
+}
+
+void ServerSocket::start_conn_check_routine()
+{
+    m_conn_check_running = true;
+    while (m_conn_check_running)
+    {
+        if (m_connections.size() == 0)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(SYNC_FREQUENCY_MS));
+            continue;
+        }
+        auto now = time(nullptr);
+        for (auto const& client : m_connections)
+        {
+            if (client->connection_lost())
+                continue;
+
+            // TODO: fix arbitrary constant value
+            // Idea: Allow client accepting pings successfully with a slight time buffer
+            auto const since_ping_ms = (now - client->get_last_successful_ping()) * 1000;
+            if (since_ping_ms > PING_FREQUENCY_MS * 19 / 10)
+            {
+                client->ping_missed();
+                if (client->connection_lost())
+                {
+                    print_time();
+                    printf("Client %08x missed %d consecutive pings. They may be disconnected.\n",
+                            client->get_token(),
+                            client->consecutive_pings_missed);
+                }
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(PING_FREQUENCY_MS));
+    }
+}
+
+void ServerSocket::start_listener_routine()
+{
+    struct epoll_event events[2];
+
+    print_time();
+    printf("Waiting for data...\n");
+
+    m_listener_running = true;
+    while (m_listener_running)
+    {
+        int const count = epoll_wait(m_epoll, events, 2, -1);
+        if (count == -1)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        for (int i = 0; i < count && m_listener_running; ++i)
+        {
+            if (events[i].data.fd == m_wakeup)
+                drain_wakeup();
+            else
+                receive_batch();
+        }
+    }
+}
+
+void ServerSocket::end_conn_check_routine()
+{
+    m_conn_check_running = false;
+}
+
+void ServerSocket::end_listener_routine()
+{
+    m_listener_running = false;
+
+    uint64_t const one = 1;
+    (void) write(m_wakeup, &one, sizeof one);
+}
+
+void ServerSocket::drain_wakeup()
+{
+    // Reset the counter so a listener restarted after a reopen blocks again.
+    uint64_t count;
+    (void) read(m_wakeup, &count, sizeof count);
+}
+
+void ServerSocket::close()
+{
+    if (m_socket == -1)
+        return;
+
+    shutdown(m_socket, SHUT_RDWR);
+    ::close(m_socket);
+    m_socket = -1;
+}
+
+bool ServerSocket::has_packets() const
+{
+    return !m_queue.empty();
+}
+
+std::pair<UdpPacket, sockaddr_in> ServerSocket::get_packet()
+{
+    std::pair<UdpPacket, sockaddr_in> packet;
+    m_queue.try_dequeue(packet);
+    return packet;
+}
+
+int ServerSocket::get_packets(std::pair<UdpPacket, sockaddr_in>* out, int const max)
+{
+    return static_cast<int>(m_queue.try_dequeue_bulk(out, static_cast<std::size_t>(max)));
+}
+
+std::string ServerSocket::get_ip()
+{
+    char ac[80];
+    if (gethostname(ac, sizeof(ac)) == -1)
+    {
+        printf("Error getting host ip. Error : %s\n", strerror(errno));
+        throw std::runtime_error("get_ip() gethostname() failed.");
+    }
+
+    struct hostent* phe = gethostbyname(ac);
+    if (phe == 0)
+    {
+        throw std::runtime_error("get_ip() bad host lookup failed.");
+    }
+
+    struct in_addr addr;
+    memcpy(&addr, phe->h_addr_list[0], sizeof(struct in_addr));
+    return inet_ntoa(addr);
+}
+
+} // namespace network
+
+#endif // _WIN32
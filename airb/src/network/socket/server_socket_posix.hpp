@@ -0,0 +1,85 @@
+#ifndef NETWORK_SERVER_SOCKET_POSIX_HPP
+#define NETWORK_SERVER_SOCKET_POSIX_HPP
+
+#ifndef _WIN32
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "platform.hpp"
+#include "../connection.hpp"
+#include "../session_table.hpp"
+#include "../utilities/udp_packet.hpp"
+#include "../../utilities/ring_buffer.hpp"
+
+namespace network {
+
+// POSIX counterpart of the Winsock server socket. The listener blocks in
+// epoll_wait on a non-blocking UDP socket and drains it with recvmmsg, so a
+// single thread picks up a whole burst of datagrams per wakeup; broadcasts
+// go out through one sendmmsg call instead of a sendto per client.
+class ServerSocket
+{
+    static int const RECV_BATCH_SIZE = 32;
+    static int const SEND_BATCH_SIZE = 16;
+    static int const RECV_BUFFER_SIZE = 1 << 20;
+    static int const QUEUE_CAPACITY   = 1024;
+    static int const SESSION_CAPACITY = ROOM_MAX_NUM * ROOM_MAX_USERS;
+
+    bool           m_listener_running;
+    bool           m_conn_check_running;
+    int            m_socket;
+    int            m_epoll;
+    int            m_wakeup;
+    sockaddr_in    m_sockaddr;
+    unsigned short m_port;
+
+    // Keepalives find their connection by session token. The listener
+    // thread reads the table while the owning state adds and drops
+    // clients, so every access holds m_sessions_mutex.
+    std::vector<std::shared_ptr<Connection>>  m_connections;
+    SessionTable<std::shared_ptr<Connection>> m_sessions;
+    mutable std::mutex                        m_sessions_mutex;
+
+    utilities::RingBuffer<std::pair<UdpPacket, sockaddr_in>> m_queue;
+
+    void process_packet(UdpPacketView const& packet, sockaddr_in const si_client);
+    void receive_batch ();
+    void drain_wakeup  ();
+    void broadcast_to  (UdpPacket const& packet, int const exclude_client_id)            const;
+    void send_batch    (UdpPacket const& packet, sockaddr_in const* to, int const count) const;
+
+public:
+    explicit ServerSocket(unsigned short port);
+            ~ServerSocket();
+
+    void open                    ();
+    void close                   ();
+    void add_client              (std::shared_ptr<Connection> client);
+    void broadcast               (UdpPacket const& packet)                             const;
+    void broadcast               (UdpPacket const& packet, U8 const exclude_client_id) const;
+    void drop_client             (std::shared_ptr<Connection> client);
+    void ping_received           (SessionToken const token)                            const;
+    void send                    (UdpPacket const& packet, sockaddr_in const to)       const;
+
+    void start_conn_check_routine();
+    void start_listener_routine  ();
+    void end_conn_check_routine  ();
+    void end_listener_routine    ();
+
+    // get_packet() expects has_packets() to be true; get_packets() takes
+    // up to max queued packets at once and returns how many it took
+    bool                              has_packets() const;
+    std::pair<UdpPacket, sockaddr_in> get_packet();
+    int                               get_packets(std::pair<UdpPacket, sockaddr_in>* out, int const max);
+
+    std::string                       get_ip();
+};
+
+} // namespace network
+
+#endif // _WIN32
+
+#endif // NETWORK_SERVER_SOCKET_POSIX_HPP
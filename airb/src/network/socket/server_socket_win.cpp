@@ -1,5 +1,8 @@
 ﻿#include "server_socket_win.hpp"
 
+#ifdef _WIN32
+
+#include <algorithm>
 #include <stdio.h>
 
 #include "../utilities/config.hpp"
@@ -12,7 +15,9 @@ ServerSocket::ServerSocket(unsigned short port)
     , m_conn_check_running(false)
     , m_port(port)
     , m_connections()
-    , m_queue()
+    , m_sessions(SESSION_CAPACITY)
+    , m_sessions_mutex()
+    , m_queue(QUEUE_CAPACITY)
 {
     m_sockaddr.sin_family = AF_INET;
     m_sockaddr.sin_port = htons(m_port);
@@ -60,9 +65,11 @@ void ServerSocket::open()
     printf("Socket bind successful.\n");
 }
 
-void ServerSocket::process_packet(UdpPacket const packet, sockaddr_in const si_client)
+void ServerSocket::process_packet(UdpPacketView const& packet, sockaddr_in const si_client)
 {
-    if (!packet.header_contains(UDP_H_KEEPALIVE) && !packet.header_contains(UDP_H_INPUT))
+    if (!packet.header_contains(UDP_H_KEEPALIVE) &&
+        !packet.header_contains(UDP_H_INPUT)     &&
+        !packet.header_contains(UDP_H_POS))
     {
         // Debug
         print_time();
@@ -71,37 +78,37 @@ void ServerSocket::process_packet(UdpPacket const packet, sockaddr_in const si_c
                ntohs(si_client.sin_port));
         printf("           > Packet size: %d byte(s)\n", packet.get_size());
 
-        packet.print();
+        UdpPacket(packet).print();
     }
     if (packet.header_contains(UDP_H_KEEPALIVE))
     {
-        if (packet.get_data_block()[0] != '\0')
-        {
-            char id[NETWORK_ID_LENGTH] = { '\0' };
-            strcpy_s(id, NETWORK_ID_LENGTH, packet.get_data_block());
-            ping_received(id);
-        }
+        // Keepalives are answered straight from the receive buffer
+        ping_received(packet.get_token());
         return;
     }
-    m_queue.enqueue(std::pair<UdpPacket, sockaddr_in>(packet, si_client));
+    // A full queue drops the datagram like a full socket buffer would
+    m_queue.try_enqueue(std::pair<UdpPacket, sockaddr_in>(UdpPacket(packet), si_client));
 }
 
 void ServerSocket::add_client(std::shared_ptr<Connection> client)
 {
     m_connections.push_back(client);
+
+    std::lock_guard<std::mutex> lock(m_sessions_mutex);
+    m_sessions.insert(client->get_token(), client);
 }
 
-void ServerSocket::broadcast(UdpPacket const packet) const
+void ServerSocket::broadcast(UdpPacket const& packet) const
 {
-    for (auto const client : m_connections)
+    for (auto const& client : m_connections)
     {
         send(packet, client->get_sockaddr());
     }
 }
 
-void ServerSocket::broadcast(UdpPacket const packet, U8 const exclude_client_id) const
+void ServerSocket::broadcast(UdpPacket const& packet, U8 const exclude_client_id) const
 {
-    for (auto const client : m_connections)
+    for (auto const& client : m_connections)
     {
         if (client->get_public_id() == exclude_client_id)
             continue;
@@ -113,10 +120,14 @@ void ServerSocket::broadcast(UdpPacket const packet, U8 const exclude_client_id)
 void ServerSocket::drop_client(std::shared_ptr<Connection> client)
 {
     print_time();
-    printf("Client %s disconnected\n", client->get_id());
+    printf("Client %08x disconnected\n", client->get_token());
+    {
+        std::lock_guard<std::mutex> lock(m_sessions_mutex);
+        m_sessions.erase(client->get_token());
+    }
     for (auto c : m_connections)
     {
-        if (strcmp(c->get_id(), client->get_id()) != 0)
+        if (c->get_token() != client->get_token())
             continue;
 
         m_connections.erase(remove(m_connections.begin(),
@@ -127,18 +138,22 @@ void ServerSocket::drop_client(std::shared_ptr<Connection> client)
     }
 }
 
-void ServerSocket::ping_received(char const* client_id) const
+void ServerSocket::ping_received(SessionToken const token) const
 {
-    for (auto const client : m_connections)
+    // Take a reference under the lock so a concurrent drop_client() can
+    // not free the connection while it is being touched
+    std::shared_ptr<Connection> client;
     {
-        if (strcmp(client->get_id(), client_id) == 0)
-        {
-            client->ping_received();
-        }
+        std::lock_guard<std::mutex> lock(m_sessions_mutex);
+        auto const found = m_sessions.find(token);
+        if (found == nullptr)
+            return;
+        client = *found;
     }
+    client->ping_received();
 }
 
-void ServerSocket::send(UdpPacket packet, sockaddr_in to) const
+void ServerSocket::send(UdpPacket const& packet, sockaddr_in to) const
 {
     int slen = sizeof to;
 
@@ -166,21 +181,22 @@ void ServerSocket::start_conn_check_routine()
             continue;
         }
         auto now = time(nullptr);
-        for (auto const client : m_connections)
+        for (auto const& client : m_connections)
         {
             if (client->connection_lost())
                 continue;
 
             // TODO: fix arbitrary constant value
             // Idea: Allow client accepting pings successfully with a slight time buffer
-            if (now - client->get_last_successful_ping() > PING_FREQUENCY_MS * 1.9f / 1000)
+            auto const since_ping_ms = (now - client->get_last_successful_ping()) * 1000;
+            if (since_ping_ms > PING_FREQUENCY_MS * 19 / 10)
             {
                 client->ping_missed();
                 if (client->connection_lost())
                 {
                     print_time();
-                    printf("Client %s missed %d consecutive pings. They may be disconnected.\n",
-                            client->get_id(),
+                    printf("Client %08x missed %d consecutive pings. They may be disconnected.\n",
+                            client->get_token(),
                             client->consecutive_pings_missed);
                 }
             }
@@ -202,7 +218,6 @@ void ServerSocket::start_listener_routine()
     m_listener_running = true;
     while (m_listener_running)
     {
-        memset(buffer, UDP_H_NULL, UDP_MAX_PACKET_SIZE);
         recv_data = recvfrom(m_socket,
                              buffer,
                              UDP_MAX_PACKET_SIZE,
@@ -217,7 +232,9 @@ void ServerSocket::start_listener_routine()
             continue;
         }
 
-        process_packet(UdpPacket(buffer), si_client);
+        UdpPacketView const view(buffer, recv_data);
+        if (view.is_valid())
+            process_packet(view, si_client);
     }
 }
 
@@ -245,7 +262,14 @@ bool ServerSocket::has_packets() const
 
 std::pair<UdpPacket, sockaddr_in> ServerSocket::get_packet()
 {
-    return m_queue.dequeue();
+    std::pair<UdpPacket, sockaddr_in> packet;
+    m_queue.try_dequeue(packet);
+    return packet;
+}
+
+int ServerSocket::get_packets(std::pair<UdpPacket, sockaddr_in>* out, int const max)
+{
+    return static_cast<int>(m_queue.try_dequeue_bulk(out, static_cast<std::size_t>(max)));
 }
 
 std::string ServerSocket::get_ip()
@@ -269,3 +293,5 @@ std::string ServerSocket::get_ip()
 }
 
 } // namespace network
+
+#endif // _WIN32
@@ -1,30 +1,42 @@
 ﻿#ifndef NETWORK_SERVER_SOCKET_WIN_HPP
 #define NETWORK_SERVER_SOCKET_WIN_HPP
 
+#ifdef _WIN32
+
+#include <mutex>
 #include <vector>
 #include <winsock2.h>
 
 #pragma comment(lib,"ws2_32.lib")
 
 #include "../connection.hpp"
+#include "../session_table.hpp"
 #include "../utilities/udp_packet.hpp"
-#include "../../utilities/async_queue.hpp"
+#include "../../utilities/ring_buffer.hpp"
 
 namespace network {
 
 class ServerSocket
 {
+    static int const QUEUE_CAPACITY   = 1024;
+    static int const SESSION_CAPACITY = ROOM_MAX_NUM * ROOM_MAX_USERS;
+
     bool           m_listener_running;
     bool           m_conn_check_running;
     SOCKET         m_socket;
     sockaddr_in    m_sockaddr;
     unsigned short m_port;
 
-    std::vector<std::shared_ptr<Connection>> m_connections;
+    // Keepalives find their connection by session token. The listener
+    // thread reads the table while the owning state adds and drops
+    // clients, so every access holds m_sessions_mutex.
+    std::vector<std::shared_ptr<Connection>>  m_connections;
+    SessionTable<std::shared_ptr<Connection>> m_sessions;
+    mutable std::mutex                        m_sessions_mutex;
 
-    utilities::AsyncQueue<std::pair<UdpPacket, sockaddr_in>> m_queue;
+    utilities::RingBuffer<std::pair<UdpPacket, sockaddr_in>> m_queue;
 
-    void process_packet(UdpPacket const packet, sockaddr_in const si_client);
+    void process_packet(UdpPacketView const& packet, sockaddr_in const si_client);
 
 public:
     explicit ServerSocket(unsigned short port);
@@ -33,23 +45,28 @@ public:
     void open                    ();
     void close                   () const;
     void add_client              (std::shared_ptr<Connection> client);
-    void broadcast               (UdpPacket const packet)                             const;
-    void broadcast               (UdpPacket const packet, U8 const exclude_client_id) const;
+    void broadcast               (UdpPacket const& packet)                             const;
+    void broadcast               (UdpPacket const& packet, U8 const exclude_client_id) const;
     void drop_client             (std::shared_ptr<Connection> client);
-    void ping_received           (char const* client_id)                              const;
-    void send                    (UdpPacket const packet, sockaddr_in const to)       const;
+    void ping_received           (SessionToken const token)                            const;
+    void send                    (UdpPacket const& packet, sockaddr_in const to)       const;
 
     void start_conn_check_routine();
     void start_listener_routine  ();
     void end_conn_check_routine  ();
     void end_listener_routine    ();
 
+    // get_packet() expects has_packets() to be true; get_packets() takes
+    // up to max queued packets at once and returns how many it took
     bool                              has_packets() const;
     std::pair<UdpPacket, sockaddr_in> get_packet();
+    int                               get_packets(std::pair<UdpPacket, sockaddr_in>* out, int const max);
 
     std::string                       get_ip();
 };
 
 } // namespace network
 
+#endif // _WIN32
+
 #endif // NETWORK_SERVER_SOCKET_WIN_HPP
@@ -1,10 +1,17 @@
 #ifndef NETWORK_CONFIG_HPP
 #define NETWORK_CONFIG_HPP
 
+#include <cstdint>
+
 namespace network {
 
 typedef unsigned char U8;
 
+// Issued by the server when a client connects and carried in the header of
+// every packet the client sends; zero means no session yet
+typedef std::uint32_t SessionToken;
+SessionToken const      NO_SESSION              = 0;
+
 char const              SERVER_DEFAULT_NAME[]   = "Test server #1";
 char const              SERVER_DEFAULT_ADDR[]   = "127.0.0.1";
 int const               SERVER_DEFAULT_PORT     = 51225; // [49152, 65535]
@@ -12,24 +19,28 @@ int const               SERVER_DEFAULT_PORT     = 51225; // [49152, 65535]
 int const               ROOM_MAX_USERS          = 4;
 int const               ROOM_MAX_NUM            = 64;
 
-int const               NETWORK_ID_LENGTH       = 40;
-
 int const               THROUGHPUT_LAG_MS       = 50;
 int const               PING_FREQUENCY_MS       = 2000;
 int const               SYNC_FREQUENCY_MS       = 51;
 int const               CURSOR_SYNC_FREQUENCY_MS= 41;
 int const               MISSED_PINGS_ALLOWED    = 4;
 
+// Area of interest: planes within this distance of the centre of a client's
+// 1920 x 1080 view, plus a margin so they are current before they scroll in,
+// are synced every time; the rest every AOI_FAR_SYNC_INTERVAL syncs
+float const             AOI_HALF_WIDTH          = 960.0f + 320.0f;
+float const             AOI_HALF_HEIGHT         = 540.0f + 320.0f;
+float const             AOI_CELL_SIZE           = 500.0f;
+int const               AOI_FAR_SYNC_INTERVAL   = 4;
+
 int const               UDP_TOTAL_SIZE          = 512;
 int const               UDP_MAX_PACKET_SIZE     = UDP_TOTAL_SIZE - 20;
-int const               UDP_MAX_DATABLOCK_SIZE  = UDP_MAX_PACKET_SIZE
-                                                - NETWORK_ID_LENGTH
-                                                - 3;
+int const               UDP_MAX_DATABLOCK_SIZE  = UDP_MAX_PACKET_SIZE - 10; // Less the header
 
-// UDP packet composition so far (not final):
-//  header    input     pos1      pos2      datablock
-// [--------][--------][--------][--------][-...   ...-]
-//  1 byte    1 byte    1 byte    1 byte     x bytes
+// UDP packet composition (see udp_packet.hpp):
+//  header    move      action    pos       token       length    datablock
+// [--------][--------][--------][--------][--------*4][--------*2][-...   ...-]
+//  1 byte    1 byte    1 byte    1 byte    4 bytes     2 bytes    length bytes
 
 // ------------------------------------------------------ HEADER BYTE
 unsigned char const     UDP_H_NULL              = 0;
@@ -40,7 +51,7 @@ unsigned char const     UDP_H_KEEPALIVE         = 1 << 3;
 unsigned char const     UDP_H_INPUT             = 1 << 4;
 unsigned char const     UDP_H_POS               = 1 << 5;
 unsigned char const     UDP_H_DATABLOCK         = 1 << 6;
-//unsigned char const     UDP_H_ADDITIONAL        = 1 << 7;
+unsigned char const     UDP_H_BINARY            = 1 << 7; // Data block is binary, not text
 
 // ------------------------------------------------------ MOVE INPUT BYTE
 unsigned char const     UDP_IN_PRESS            = 1;
@@ -57,6 +68,8 @@ unsigned char const     UDP_IN_SWITCH_WPN_3     = 1 << 5;
 unsigned char const     UDP_IN_SWITCH_WPN_Q     = 1 << 6;
 
 // ------------------------------------------------------ POS_SYNC BYTE
+// Input packets from a client carry their input sequence number here
+// instead; the server echoes it back in the client's snapshots
 unsigned char const     UDP_POS_PLAYER_1         = 1;
 unsigned char const     UDP_POS_PLAYER_2         = 1 << 1;
 unsigned char const     UDP_POS_PLAYER_3         = 1 << 2;
@@ -3,10 +3,16 @@
 
 #pragma warning(disable : 4996)
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
 #include <iostream>
 
+#include "config.hpp"
+#include "../../math/matrix.hpp"
+
 namespace network {
 
 inline void print_time()
@@ -19,6 +25,23 @@ inline void print_time()
     std::cout << std::setw(2) << std::setfill('0') << now->tm_sec  << "] ";
 }
 
+// Cursor syncs carry "x|y" in their data block. The block is not
+// terminated on the wire, so at most size bytes of data are read.
+inline bool parse_cursor(char const* data, int const size, math::Vector2f& pos)
+{
+    char buffer[UDP_MAX_DATABLOCK_SIZE + 1];
+    std::size_t const n = static_cast<std::size_t>(std::max(std::min(size, UDP_MAX_DATABLOCK_SIZE), 0));
+    std::memcpy(buffer, data, n);
+    buffer[n] = '\0';
+
+    char const* const y = std::strchr(buffer, '|');
+    if (y == nullptr)
+        return false;
+
+    pos = math::Vector2f({ std::strtof(buffer, nullptr), std::strtof(y + 1, nullptr) });
+    return true;
+}
+
 } // namespace network
 
 #endif // NETWORK_UTILITIES_FUNCTIONS_HPP
@@ -0,0 +1,329 @@
+﻿#include "snapshot.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace network {
+
+namespace
+{
+    // Level textures are all 6000 x 4000, matching the bounds used by the
+    // projectiles and the navigation grid.
+    float const WORLD_WIDTH  = 6000.0f;
+    float const WORLD_HEIGHT = 4000.0f;
+
+    float const VELOCITY_SCALE = 4.0f;
+
+    float const TWO_PI = 6.28318530718f;
+
+    U8 const FLAG_HAS_BASELINE  = 1;
+    U8 const FLAG_HAS_INPUT_ACK = 1 << 1;
+
+    int const FIELD_SIZE[Snapshot::NUM_FIELDS] = { 2, 2, 1, 2, 2, 2, 2 };
+
+    void write_u16(char* out, unsigned int const v)
+    {
+        out[0] = static_cast<char>(v & 0xff);
+        out[1] = static_cast<char>((v >> 8) & 0xff);
+    }
+
+    unsigned int read_u16(char const* in)
+    {
+        return static_cast<U8>(in[0]) | static_cast<U8>(in[1]) << 8;
+    }
+
+    unsigned short quantise_coord(float const v, float const extent)
+    {
+        float const t = std::min(std::max(v / extent, 0.0f), 1.0f);
+        return static_cast<unsigned short>(std::lround(t * 65535.0f));
+    }
+
+    float dequantise_coord(unsigned short const q, float const extent)
+    {
+        return static_cast<float>(q) * (extent / 65535.0f);
+    }
+
+    unsigned short quantise_velocity(float const v)
+    {
+        long const q = std::lround(v * VELOCITY_SCALE);
+        return static_cast<unsigned short>(std::min(std::max(q, -32768L), 32767L));
+    }
+
+    float dequantise_velocity(unsigned short const q)
+    {
+        return static_cast<float>(static_cast<short>(q)) / VELOCITY_SCALE;
+    }
+
+    unsigned short quantise_angle(float const rot)
+    {
+        float const turns = rot / TWO_PI;
+        return static_cast<unsigned short>(std::lround((turns - std::floor(turns)) * 256.0f) & 0xff);
+    }
+
+    float dequantise_angle(unsigned short const q)
+    {
+        return static_cast<float>(q) * (TWO_PI / 256.0f);
+    }
+}
+
+Snapshot::Snapshot(unsigned short const seq)
+    : m_sequence(seq)
+    , m_num_planes(0)
+    , m_ids()
+    , m_fields()
+    , m_input_ack()
+    , m_has_input_ack(false)
+{ }
+
+bool Snapshot::add_plane(PlaneState const& state)
+{
+    if (m_num_planes == MAX_PLANES)
+        return false;
+
+    unsigned short* f = m_fields[m_num_planes];
+    f[POSITION_X] = quantise_coord(state.position[X], WORLD_WIDTH);
+    f[POSITION_Y] = quantise_coord(state.position[Y], WORLD_HEIGHT);
+    f[ROTATION]   = quantise_angle(state.rotation);
+    f[VELOCITY_X] = quantise_velocity(state.velocity[X]);
+    f[VELOCITY_Y] = quantise_velocity(state.velocity[Y]);
+    f[CURSOR_X]   = quantise_coord(state.cursor_position[X], WORLD_WIDTH);
+    f[CURSOR_Y]   = quantise_coord(state.cursor_position[Y], WORLD_HEIGHT);
+
+    m_ids[m_num_planes++] = state.public_id;
+    return true;
+}
+
+void Snapshot::set_input_ack(InputAck const& ack)
+{
+    m_input_ack     = ack;
+    m_has_input_ack = true;
+}
+
+// Layout: sequence (2), baseline sequence (2), flags (1), plane count (1),
+// the input ack if flagged (3), one id per plane, a bitmap of planes
+// carrying changes, then for each of those a field mask followed by the
+// masked fields.
+int Snapshot::encode(char* buffer, Snapshot const* baseline) const
+{
+    write_u16(buffer, m_sequence);
+    write_u16(buffer + 2, baseline ? baseline->m_sequence : 0);
+    buffer[4] = static_cast<char>((baseline        ? FLAG_HAS_BASELINE  : 0) |
+                                  (m_has_input_ack ? FLAG_HAS_INPUT_ACK : 0));
+    buffer[5] = static_cast<char>(m_num_planes);
+
+    char* out = buffer + HEADER_SIZE;
+    if (m_has_input_ack)
+    {
+        *out = static_cast<char>(m_input_ack.sequence);
+        write_u16(out + 1, m_input_ack.ticks);
+        out += INPUT_ACK_SIZE;
+    }
+    for (int i = 0; i < m_num_planes; ++i)
+        *out++ = static_cast<char>(m_ids[i]);
+
+    char* changed = out++;
+    *changed = 0;
+    for (int i = 0; i < m_num_planes; ++i)
+    {
+        int const base = baseline ? baseline->find_plane(m_ids[i]) : -1;
+
+        U8 mask = 0;
+        for (int f = 0; f < NUM_FIELDS; ++f)
+            if (base < 0 || m_fields[i][f] != baseline->m_fields[base][f])
+                mask |= 1 << f;
+        if (mask == 0)
+            continue;
+
+        *changed |= 1 << i;
+        *out++ = static_cast<char>(mask);
+        for (int f = 0; f < NUM_FIELDS; ++f)
+        {
+            if ((mask & (1 << f)) == 0)
+                continue;
+
+            if (FIELD_SIZE[f] == 2)
+                write_u16(out, m_fields[i][f]);
+            else
+                *out = static_cast<char>(m_fields[i][f]);
+            out += FIELD_SIZE[f];
+        }
+    }
+    return static_cast<int>(out - buffer);
+}
+
+bool Snapshot::decode(char const* buffer, int const size, SnapshotBuffer const& history)
+{
+    if (size < HEADER_SIZE)
+        return false;
+
+    U8 const flags = static_cast<U8>(buffer[4]);
+    int const ack_size = flags & FLAG_HAS_INPUT_ACK ? INPUT_ACK_SIZE : 0;
+    int const num_planes = static_cast<U8>(buffer[5]);
+    if (num_planes > MAX_PLANES || size < HEADER_SIZE + ack_size + num_planes + 1)
+        return false;
+
+    Snapshot const* baseline = nullptr;
+    if (flags & FLAG_HAS_BASELINE)
+    {
+        baseline = history.find(static_cast<unsigned short>(read_u16(buffer + 2)));
+        if (!baseline)
+            return false;
+    }
+
+    char const* in  = buffer + HEADER_SIZE;
+    char const* end = buffer + size;
+
+    Snapshot result(static_cast<unsigned short>(read_u16(buffer)));
+    if (ack_size != 0)
+    {
+        result.set_input_ack(InputAck {
+            static_cast<U8>(in[0]),
+            static_cast<unsigned short>(read_u16(in + 1))
+        });
+        in += ack_size;
+    }
+    result.m_num_planes = num_planes;
+    for (int i = 0; i < num_planes; ++i)
+        result.m_ids[i] = static_cast<U8>(*in++);
+
+    U8 const changed = static_cast<U8>(*in++);
+    for (int i = 0; i < num_planes; ++i)
+    {
+        int const base = baseline ? baseline->find_plane(result.m_ids[i]) : -1;
+        if (base >= 0)
+            std::copy(baseline->m_fields[base], baseline->m_fields[base] + NUM_FIELDS,
+                      result.m_fields[i]);
+
+        if ((changed & (1 << i)) == 0)
+        {
+            // An elided plane has to exist in the baseline
+            if (base < 0)
+                return false;
+            continue;
+        }
+
+        if (in == end)
+            return false;
+        U8 const mask = static_cast<U8>(*in++);
+        for (int f = 0; f < NUM_FIELDS; ++f)
+        {
+            if ((mask & (1 << f)) == 0)
+                continue;
+            if (end - in < FIELD_SIZE[f])
+                return false;
+
+            result.m_fields[i][f] = FIELD_SIZE[f] == 2
+                                  ? static_cast<unsigned short>(read_u16(in))
+                                  : static_cast<U8>(*in);
+            in += FIELD_SIZE[f];
+        }
+    }
+
+    *this = result;
+    return true;
+}
+
+UdpPacket Snapshot::to_packet(Snapshot const* baseline) const
+{
+    char buffer[MAX_SIZE];
+    int const size = encode(buffer, baseline);
+
+    UdpPacket packet(UDP_H_POS);
+    packet.set_binary_data(buffer, size);
+    return packet;
+}
+
+bool Snapshot::from_packet(UdpPacket const& packet, SnapshotBuffer const& history)
+{
+    if (!packet.header_contains(UDP_H_POS)    ||
+        !packet.header_contains(UDP_H_BINARY) ||
+         packet.header_contains(UDP_H_OK))
+        return false;
+
+    return decode(packet.get_data_block(), packet.get_data_size(), history);
+}
+
+UdpPacket Snapshot::make_ack(unsigned short const seq, U8 const public_id)
+{
+    char buffer[2];
+    write_u16(buffer, seq);
+
+    UdpPacket packet(UDP_H_POS | UDP_H_OK, public_id);
+    packet.set_binary_data(buffer, sizeof buffer);
+    return packet;
+}
+
+bool Snapshot::read_ack(UdpPacket const& packet, unsigned short& seq)
+{
+    if (!packet.header_contains(UDP_H_POS)    ||
+        !packet.header_contains(UDP_H_OK)     ||
+        !packet.header_contains(UDP_H_BINARY) ||
+         packet.get_data_size() != 2)
+        return false;
+
+    seq = static_cast<unsigned short>(read_u16(packet.get_data_block()));
+    return true;
+}
+
+unsigned short Snapshot::get_sequence() const
+{
+    return m_sequence;
+}
+
+int Snapshot::get_num_planes() const
+{
+    return m_num_planes;
+}
+
+PlaneState Snapshot::get_plane(int const i) const
+{
+    unsigned short const* f = m_fields[i];
+
+    PlaneState state;
+    state.public_id          = m_ids[i];
+    state.position[X]        = dequantise_coord(f[POSITION_X], WORLD_WIDTH);
+    state.position[Y]        = dequantise_coord(f[POSITION_Y], WORLD_HEIGHT);
+    state.rotation           = dequantise_angle(f[ROTATION]);
+    state.velocity[X]        = dequantise_velocity(f[VELOCITY_X]);
+    state.velocity[Y]        = dequantise_velocity(f[VELOCITY_Y]);
+    state.cursor_position[X] = dequantise_coord(f[CURSOR_X], WORLD_WIDTH);
+    state.cursor_position[Y] = dequantise_coord(f[CURSOR_Y], WORLD_HEIGHT);
+    return state;
+}
+
+bool Snapshot::get_input_ack(InputAck& ack) const
+{
+    if (m_has_input_ack)
+        ack = m_input_ack;
+    return m_has_input_ack;
+}
+
+int Snapshot::find_plane(U8 const public_id) const
+{
+    for (int i = 0; i < m_num_planes; ++i)
+        if (m_ids[i] == public_id)
+            return i;
+    return -1;
+}
+
+SnapshotBuffer::SnapshotBuffer()
+    : m_snapshots()
+    , m_valid()
+{ }
+
+void SnapshotBuffer::store(Snapshot const& snapshot)
+{
+    int const slot = snapshot.get_sequence() % SIZE;
+    m_snapshots[slot] = snapshot;
+    m_valid[slot]     = true;
+}
+
+Snapshot const* SnapshotBuffer::find(unsigned short const seq) const
+{
+    int const slot = seq % SIZE;
+    if (!m_valid[slot] || m_snapshots[slot].get_sequence() != seq)
+        return nullptr;
+    return &m_snapshots[slot];
+}
+
+} // namespace network
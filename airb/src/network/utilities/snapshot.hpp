@@ -0,0 +1,118 @@
+﻿#ifndef NETWORK_UTILITIES_SNAPSHOT_HPP
+#define NETWORK_UTILITIES_SNAPSHOT_HPP
+
+#include "config.hpp"
+#include "udp_packet.hpp"
+#include "../../math/matrix.hpp"
+
+namespace network {
+
+struct PlaneState
+{
+    U8             public_id;
+    math::Vector2f position;
+    float          rotation;
+    math::Vector2f velocity;
+    math::Vector2f cursor_position;
+};
+
+// Tells the receiving client which of its inputs the server had applied when
+// the snapshot was taken and how many ticks it has run since, so the client
+// can line the server's state up with its own prediction
+struct InputAck
+{
+    U8             sequence;
+    unsigned short ticks;
+};
+
+// True when sequence number a was issued after b, allowing for wrap-around.
+inline bool sequence_newer(unsigned short const a, unsigned short const b)
+{
+    return static_cast<short>(a - b) > 0;
+}
+
+class SnapshotBuffer;
+
+// State of every plane in a room, quantised for the wire: positions and
+// cursors as 16-bit fixed point over the world, rotation in 256 steps and
+// velocity as signed quarter pixels per second.
+//
+// A snapshot is encoded as a delta against a baseline the receiver already
+// holds. Planes whose quantised state did not change are elided down to
+// their id, and changed planes only carry the fields set in their mask.
+// Without a baseline every field is sent, which makes the full snapshot.
+// The input ack is per receiver and never part of the delta.
+class Snapshot final
+{
+public:
+    enum Field
+    {
+        POSITION_X,
+        POSITION_Y,
+        ROTATION,
+        VELOCITY_X,
+        VELOCITY_Y,
+        CURSOR_X,
+        CURSOR_Y,
+        NUM_FIELDS
+    };
+
+    static int const MAX_PLANES     = ROOM_MAX_USERS;
+    static int const HEADER_SIZE    = 6;
+    static int const INPUT_ACK_SIZE = 3;
+    static int const MAX_SIZE       = HEADER_SIZE + INPUT_ACK_SIZE + MAX_PLANES + 1
+                                    + MAX_PLANES * (1 + 2 * NUM_FIELDS);
+
+private:
+    unsigned short m_sequence;
+    int            m_num_planes;
+    U8             m_ids   [MAX_PLANES];
+    unsigned short m_fields[MAX_PLANES][NUM_FIELDS];
+    InputAck       m_input_ack;
+    bool           m_has_input_ack;
+
+public:
+    explicit Snapshot(unsigned short const seq = 0);
+
+    bool add_plane    (PlaneState const& state);
+    void set_input_ack(InputAck const& ack);
+
+    int  encode(char* buffer, Snapshot const* baseline) const;
+    bool decode(char const* buffer, int const size, SnapshotBuffer const& history);
+
+    UdpPacket to_packet  (Snapshot const* baseline) const;
+    bool      from_packet(UdpPacket const& packet, SnapshotBuffer const& history);
+
+    static UdpPacket make_ack(unsigned short const seq, U8 const public_id);
+    static bool      read_ack(UdpPacket const& packet, unsigned short& seq);
+
+    unsigned short get_sequence  () const;
+    int            get_num_planes() const;
+    PlaneState     get_plane     (int const i) const;
+    bool           get_input_ack (InputAck& ack) const;
+
+private:
+    int find_plane(U8 const public_id) const;
+};
+
+// Ring of recently sent or received snapshots, looked up by sequence
+// number when resolving delta baselines.
+class SnapshotBuffer final
+{
+public:
+    static int const SIZE = 32;
+
+private:
+    Snapshot m_snapshots[SIZE];
+    bool     m_valid    [SIZE];
+
+public:
+    SnapshotBuffer();
+
+    void            store(Snapshot const& snapshot);
+    Snapshot const* find (unsigned short const seq) const;
+};
+
+} // namespace network
+
+#endif // NETWORK_UTILITIES_SNAPSHOT_HPP
@@ -1,18 +1,108 @@
 ﻿#include "udp_packet.hpp"
 
+#include <algorithm>
 #include <cstdio>
+#include <cstring>
 
 namespace network {
 
+namespace
+{
+    int const HEADER_BYTE = 0;
+    int const MOVE_BYTE   = 1;
+    int const ACTION_BYTE = 2;
+    int const POS_BYTE    = 3;
+    int const TOKEN_BYTE  = 4;
+    int const LENGTH_BYTE = 8;
+
+    int read_length(char const* buffer)
+    {
+        return static_cast<U8>(buffer[LENGTH_BYTE])
+             | static_cast<U8>(buffer[LENGTH_BYTE + 1]) << 8;
+    }
+
+    SessionToken read_token(char const* buffer)
+    {
+        return static_cast<SessionToken>(static_cast<U8>(buffer[TOKEN_BYTE]))
+             | static_cast<SessionToken>(static_cast<U8>(buffer[TOKEN_BYTE + 1])) << 8
+             | static_cast<SessionToken>(static_cast<U8>(buffer[TOKEN_BYTE + 2])) << 16
+             | static_cast<SessionToken>(static_cast<U8>(buffer[TOKEN_BYTE + 3])) << 24;
+    }
+}
+
+UdpPacketView::UdpPacketView(char const* buffer, int const size)
+    : m_buffer(buffer)
+    , m_size(size)
+{ }
+
+bool UdpPacketView::is_valid() const
+{
+    return m_size >= UDP_HEADER_SIZE
+        && m_size <= UDP_MAX_PACKET_SIZE
+        && UDP_HEADER_SIZE + read_length(m_buffer) == m_size;
+}
+
+U8 UdpPacketView::get_header_byte() const
+{
+    return m_buffer[HEADER_BYTE];
+}
+
+U8 UdpPacketView::get_move_byte() const
+{
+    return m_buffer[MOVE_BYTE];
+}
+
+U8 UdpPacketView::get_action_byte() const
+{
+    return m_buffer[ACTION_BYTE];
+}
+
+U8 UdpPacketView::get_pos_byte() const
+{
+    return m_buffer[POS_BYTE];
+}
+
+SessionToken UdpPacketView::get_token() const
+{
+    return read_token(m_buffer);
+}
+
+char const* UdpPacketView::get_data_block() const
+{
+    return m_buffer + UDP_HEADER_SIZE;
+}
+
+int UdpPacketView::get_data_size() const
+{
+    return read_length(m_buffer);
+}
+
+char const* UdpPacketView::get_buffer() const
+{
+    return m_buffer;
+}
+
+int UdpPacketView::get_size() const
+{
+    return m_size;
+}
+
+bool UdpPacketView::header_contains(U8 header) const
+{
+    return (get_header_byte() & header) != 0;
+}
+
 UdpPacket::UdpPacket()
 {
     reset();
 }
 
-UdpPacket::UdpPacket(char buffer[])
-    : UdpPacket()
+// The view must be valid; only the bytes in use are copied.
+UdpPacket::UdpPacket(UdpPacketView const& view)
+    : m_size(view.get_size())
 {
-    parse_buffer(buffer);
+    memcpy(m_packet, view.get_buffer(), m_size);
+    m_packet[m_size] = '\0';
 }
 
 UdpPacket::UdpPacket(U8 const header)
@@ -21,7 +111,7 @@ UdpPacket::UdpPacket(U8 const header)
     set_header(header);
 }
 
-UdpPacket::UdpPacket(U8 const header, char data[])
+UdpPacket::UdpPacket(U8 const header, char const* data)
     : UdpPacket(header)
 {
     set_data(data);
@@ -33,14 +123,14 @@ UdpPacket::UdpPacket(U8 const header, U8 const pos)
     set_pos(pos);
 }
 
-UdpPacket::UdpPacket(U8 const header, U8 const pos, char data[])
+UdpPacket::UdpPacket(U8 const header, U8 const pos, char const* data)
     : UdpPacket(header, pos)
 {
     set_data(data);
 }
 
 
-UdpPacket::UdpPacket(U8 const header, U8 const input_move, U8 const input_action, char data[])
+UdpPacket::UdpPacket(U8 const header, U8 const input_move, U8 const input_action, char const* data)
     : UdpPacket(header, data)
 {
     set_input_move(input_move);
@@ -54,38 +144,66 @@ UdpPacket::UdpPacket(U8 const header, U8 const input_move, U8 const input_action
     set_input_action(input_action);
 }
 
-UdpPacket::UdpPacket(U8 const header, U8 const input_move, U8 const input_action, U8 const pos, char data[])
+UdpPacket::UdpPacket(U8 const header, U8 const input_move, U8 const input_action, U8 const pos, char const* data)
     : UdpPacket(header, input_move, input_action, data)
 {
     set_pos(pos);
 }
 
+UdpPacket::UdpPacket(UdpPacket const& other)
+    : m_size(other.m_size)
+{
+    memcpy(m_packet, other.m_packet, m_size + 1);
+}
+
 UdpPacket::~UdpPacket()
 { }
 
+UdpPacket& UdpPacket::operator=(UdpPacket const& other)
+{
+    m_size = other.m_size;
+    memcpy(m_packet, other.m_packet, m_size + 1);
+    return *this;
+}
+
 U8 UdpPacket::get_header_byte() const
 {
-    return m_packet[m_header_byte_i];
+    return m_packet[HEADER_BYTE];
 }
 
 U8 UdpPacket::get_move_byte() const
 {
-    return m_packet[m_move_byte_i];
+    return m_packet[MOVE_BYTE];
 }
 
 U8 UdpPacket::get_action_byte() const
 {
-    return m_packet[m_action_byte_i];
+    return m_packet[ACTION_BYTE];
 }
 
 U8 UdpPacket::get_pos_byte() const
 {
-    return m_packet[m_pos_byte_i];
+    return m_packet[POS_BYTE];
+}
+
+SessionToken UdpPacket::get_token() const
+{
+    return read_token(m_packet);
 }
 
 char const* UdpPacket::get_data_block() const
 {
-    return &m_packet[m_datablock_i];
+    return &m_packet[UDP_HEADER_SIZE];
+}
+
+int UdpPacket::get_data_size() const
+{
+    return m_size - UDP_HEADER_SIZE;
+}
+
+int UdpPacket::get_size() const
+{
+    return m_size;
 }
 
 bool UdpPacket::header_contains(U8 header) const
@@ -108,101 +226,65 @@ bool UdpPacket::position_is(U8 pos) const
     return get_pos_byte() == pos;
 }
 
-int UdpPacket::get_size() const
+char const* UdpPacket::to_char_array() const
 {
-    auto size = 0;
-    while (get_data_block()[size] != '\0')
-        size++;
-    if (get_header_byte() != UDP_H_NULL)
-        size++;
-
-    // add input byte size if there is content
-    // (may be empty in game logic standards, but still has size of 1)
-    if (get_data_block()[0] != '\0')
-    {
-        size++; // move byte
-        size++; // action byte
-        size++; // position byte
-    }
-    else
-    {
-        if (get_pos_byte() != UDP_H_NULL)
-            size += 3;
-        else if (get_action_byte() != UDP_H_NULL)
-            size += 2;
-        else if (get_move_byte() != UDP_H_NULL)
-            size++;
-    }
-
-    return size;
-}
-
-void UdpPacket::parse_buffer(char const* buffer)
-{
-    set_header(buffer[m_header_byte_i]);
-
-    if (header_contains(UDP_H_INPUT))
-    {
-        set_input_move(buffer[m_move_byte_i]);
-        set_input_action(buffer[m_action_byte_i]);
-    }
-
-    if (header_contains(UDP_H_POS))
-        set_pos(buffer[m_pos_byte_i]);
-
-    if (!header_contains(UDP_H_DATABLOCK))
-        return;
-
-    auto i = 0;
-    auto byte = m_datablock_i;
-    while (buffer[byte] != '\0')
-        set_data_byte(i++, buffer[byte++]);
+    return m_packet;
 }
 
 void UdpPacket::reset()
 {
-    for (auto i = 0; i < UDP_MAX_PACKET_SIZE; i++)
-        m_packet[i] = UDP_H_NULL;
+    memset(m_packet, UDP_H_NULL, UDP_HEADER_SIZE + 1);
+    m_size = UDP_HEADER_SIZE;
 }
 
 void UdpPacket::set_header(U8 const header)
 {
-    m_packet[m_header_byte_i] = header;
+    m_packet[HEADER_BYTE] = header;
 }
 
 void UdpPacket::set_input_move(U8 const input)
 {
-    m_packet[m_move_byte_i] = input;
+    m_packet[MOVE_BYTE] = input;
 }
 
 void UdpPacket::set_input_action(U8 const input)
 {
-    m_packet[m_action_byte_i] = input;
+    m_packet[ACTION_BYTE] = input;
 }
 
 void UdpPacket::set_pos(U8 const pos)
 {
-    m_packet[m_pos_byte_i] = pos;
+    m_packet[POS_BYTE] = pos;
+}
+
+void UdpPacket::set_token(SessionToken const token)
+{
+    for (int i = 0; i < 4; ++i)
+        m_packet[TOKEN_BYTE + i] = static_cast<char>(token >> (8 * i) & 0xff);
 }
 
 void UdpPacket::set_data(char const* data)
 {
-    auto i = 0;
-    while (data[i] != '\0')
-    {
-        set_data_byte(i, data[i]);
-        i++;
-    }
+    int const size = static_cast<int>(std::min(strlen(data), static_cast<size_t>(UDP_MAX_DATA_SIZE)));
+    memcpy(&m_packet[UDP_HEADER_SIZE], data, size);
+    set_data_size(size);
 }
 
-void UdpPacket::set_data_byte(int const byte, U8 const data)
+void UdpPacket::set_binary_data(char const* data, int const size)
 {
-    m_packet[m_datablock_i + byte] = data;
+    int const clamped = std::min(size, UDP_MAX_DATA_SIZE);
+
+    set_header(get_header_byte() | UDP_H_BINARY);
+    memcpy(&m_packet[UDP_HEADER_SIZE], data, clamped);
+    set_data_size(clamped);
 }
 
-char* UdpPacket::to_char_array() const
+void UdpPacket::set_data_size(int const size)
 {
-    return const_cast<char*>(m_packet);
+    m_packet[LENGTH_BYTE]     = static_cast<char>(size & 0xff);
+    m_packet[LENGTH_BYTE + 1] = static_cast<char>(size >> 8);
+    m_size = UDP_HEADER_SIZE + size;
+    m_packet[m_size] = '\0';
 }
 
 void UdpPacket::print() const
@@ -264,10 +346,14 @@ void UdpPacket::print() const
             printf("           > Input      : SHOOT release\n");
     }
 
+    if (get_token() != NO_SESSION)
+        printf("           > Session    : %08x\n", get_token());
     if (header_contains(UDP_H_POS))
         printf("           > Position   : %c\n", get_pos_byte());
 
-    if (header_contains(UDP_H_DATABLOCK))
+    if (header_contains(UDP_H_BINARY))
+        printf("           > Binary     : %d byte(s)\n", get_data_size());
+    else if (header_contains(UDP_H_DATABLOCK))
         printf("           > Data       : %s\n", get_data_block());
 }
 
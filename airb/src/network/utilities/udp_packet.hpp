@@ -5,51 +5,90 @@
 
 namespace network {
 
+// Packets start with the header, move, action and pos bytes followed by the
+// sender's session token and the data block length, both little-endian
+// (see config.hpp). The explicit length lets data blocks carry zero bytes;
+// text blocks are still null terminated in memory so they can be used as C
+// strings.
+int const UDP_HEADER_SIZE    = 10;
+int const UDP_MAX_DATA_SIZE  = UDP_MAX_PACKET_SIZE - UDP_HEADER_SIZE;
+
+// Read-only view of a received datagram, parsed in place over the receive
+// buffer. It is only valid for as long as that buffer is.
+class UdpPacketView
+{
+private:
+    char const* m_buffer;
+    int         m_size;
+
+public:
+    UdpPacketView(char const* buffer, int const size);
+
+    bool        is_valid        () const;
+
+    U8          get_header_byte () const;
+    U8          get_move_byte   () const;
+    U8          get_action_byte () const;
+    U8          get_pos_byte    () const;
+    SessionToken get_token      () const;
+    char const* get_data_block  () const;
+    int         get_data_size   () const;
+    char const* get_buffer      () const;
+    int         get_size        () const;
+
+    bool        header_contains (U8 header) const;
+};
+
 class UdpPacket
 {
 private:
-    U8   m_header_byte_i = 0;
-    U8   m_move_byte_i   = 1;
-    U8   m_action_byte_i = 2;
-    U8   m_pos_byte_i    = 3;
-    U8   m_datablock_i   = 4;
-    char m_packet[UDP_MAX_PACKET_SIZE];
+    int  m_size;
+    char m_packet[UDP_MAX_PACKET_SIZE + 1];
+
 public:
     UdpPacket();
-    explicit UdpPacket(char buffer[]);
+    explicit UdpPacket(UdpPacketView const& view);
     explicit UdpPacket(U8 const header);
-    UdpPacket(U8 const header, char data[]);
+    UdpPacket(U8 const header, char const* data);
     UdpPacket(U8 const header, U8 const pos);
-    UdpPacket(U8 const header, U8 const pos, char data[]);
-    UdpPacket(U8 const header, U8 const input_move, U8 const input_action, char data[]);
+    UdpPacket(U8 const header, U8 const pos, char const* data);
+    UdpPacket(U8 const header, U8 const input_move, U8 const input_action, char const* data);
     UdpPacket(U8 const header, U8 const input_move, U8 const input_action, U8 const pos);
-    UdpPacket(U8 const header, U8 const input_move, U8 const input_action, U8 const pos, char data[]);
+    UdpPacket(U8 const header, U8 const input_move, U8 const input_action, U8 const pos, char const* data);
+    UdpPacket(UdpPacket const& other);
     ~UdpPacket();
 
+    UdpPacket& operator=(UdpPacket const& other);
+
     U8          get_header_byte () const;
     U8          get_move_byte   () const;
     U8          get_action_byte () const;
     U8          get_pos_byte    () const;
+    SessionToken get_token      () const;
     char const* get_data_block  () const;
+    int         get_data_size   () const;
     int         get_size        () const;
 
     bool        header_contains (U8 header) const;
     bool        move_contains   (U8 input)  const;
     bool        action_contains (U8 input)  const;
     bool        position_is     (U8 pos)    const;
-    char*       to_char_array   ()          const;
+    char const* to_char_array   ()          const;
 
-    void        parse_buffer    (char const* buffer);
     void        reset           ();
 
     void        set_header      (U8 const header);
     void        set_input_move  (U8 const input);
     void        set_input_action(U8 const input);
     void        set_pos         (U8 const pos);
+    void        set_token       (SessionToken const token);
     void        set_data        (char const* data);
-    void        set_data_byte   (int const byte, U8 const data);
+    void        set_binary_data (char const* data, int const size);
 
     void        print() const; // Debug function
+
+private:
+    void        set_data_size   (int const size);
 };
 
 } // namespace network
@@ -1,3 +1,4 @@
+#include <cassert>
 #include <iostream>
 #include "box_collider.hpp"
 #include "collision.hpp"
@@ -6,40 +7,25 @@
 
 namespace physics
 {
+    std::array<int, 2 * BoxCollider::NUM_VERTEXES> const BoxCollider::EDGES = { 1, 0, 2, 1, 3, 2, 0, 3 };
+
     BoxCollider::BoxCollider(std::vector<math::Vector2f> const& vertexes)
-        : m_vertexes(vertexes)
+        : m_vertexes()
         , m_prev_vertexes()
         , m_axes()
-        , m_center((vertexes[0] + vertexes[2]) * 0.5f)
+        , m_center()
         , m_size()
+        , m_rb()
     {
-        for (int i = 0; i < 4; i++)
-            m_prev_vertexes.push_back(m_vertexes[i]);
-        if (vertexes.size() == 4)
-        {
-            m_axes.push_back((m_vertexes[1] - m_vertexes[0]).normalized());
-            m_axes.push_back((m_vertexes[1] - m_vertexes[2]).normalized());
-        }
-        else
-        {
-            m_axes.push_back(math::Vector2f({ -(m_vertexes[0][Y] - m_vertexes[2][Y]),
-                                            (m_vertexes[0][X] - m_vertexes[2][X]) }).normalized());
-            m_axes.push_back(math::Vector2f({ -(m_vertexes[1][Y] - m_vertexes[0][Y]),
-                                            (m_vertexes[1][X] - m_vertexes[0][X]) }).normalized());
-            m_axes.push_back(math::Vector2f({ -(m_vertexes[2][Y] - m_vertexes[1][Y]),
-                                            (m_vertexes[2][X] - m_vertexes[1][X]) }).normalized());
-        }
-        if (vertexes.size() == 4)
-        {
-            m_size = (int)((m_vertexes[1] - m_vertexes[0]).magnitude() *
-                (m_vertexes[1] - m_vertexes[2]).magnitude());
-        }
-        else
-        {
-            m_size = (int)ceil(0.5 * abs(vertexes[0][X] * vertexes[1][Y] - vertexes[0][X] * vertexes[2][Y] +
-                                    vertexes[1][X] * vertexes[2][Y] - vertexes[1][X] * vertexes[0][Y] +
-                                    vertexes[2][X] * vertexes[0][Y] - vertexes[2][X] * vertexes[1][Y]));
-        }
+        assert(vertexes.size() == NUM_VERTEXES);
+
+        for (int i = 0; i < NUM_VERTEXES; i++)
+            m_vertexes[i] = vertexes[i];
+        m_prev_vertexes = m_vertexes;
+        update_axes();
+
+        m_size = (int)((m_vertexes[1] - m_vertexes[0]).magnitude() *
+            (m_vertexes[1] - m_vertexes[2]).magnitude());
     }
 
     BoxCollider::BoxCollider(BoxCollider const& bc)
@@ -63,15 +49,13 @@ namespace physics
     }
     void BoxCollider::update_position(math::Vector2f const& change)
     {
-        for (int i = 0; i < 4; i++)
+        for (int i = 0; i < NUM_VERTEXES; i++)
         {
             m_prev_vertexes[i] = m_vertexes[i];
             m_vertexes[i] += change;
         }
 
-        m_center = (m_vertexes[0] + m_vertexes[2]) * 0.5f;
-        m_axes[0] = (m_vertexes[1] - m_vertexes[0]).normalized();
-        m_axes[1] = (m_vertexes[1] - m_vertexes[2]).normalized();
+        update_axes();
     }
 
     void BoxCollider::set_position(math::Vector2f const& pos, math::Vector2f const& offset_tl,
@@ -82,97 +66,95 @@ namespace physics
         m_vertexes[1] = pos+offset_tr;
         m_vertexes[2] = pos+offset_br;
         m_vertexes[3] = pos+offset_bl;
-        for (int i = 0; i < 4; i++)
-        {
-            m_prev_vertexes[i] = m_vertexes[i];
-        }
-        m_center = (m_vertexes[0] + m_vertexes[2]) * 0.5f;
-        m_axes[0] = (m_vertexes[1] - m_vertexes[0]).normalized();
-        m_axes[1] = (m_vertexes[1] - m_vertexes[2]).normalized();
+        m_prev_vertexes = m_vertexes;
+        update_axes();
     }
     void BoxCollider::update_rotation(float rotation, math::Vector2f point)
     {
-        for (int i = 0; i < 4; i++)
+        float s;
+        float c;
+        math::sin_cos(rotation, s, c);
+        for (int i = 0; i < NUM_VERTEXES; i++)
         {
-            float s = sinf(rotation);
-            float c = cosf(rotation);
             float xold = m_vertexes[i][X] - point[X];
             float yold = m_vertexes[i][Y] - point[Y];
             float xnew = xold * c - yold * s;
             float ynew = xold * s + yold * c;
             m_vertexes[i] = math::Vector2f({ xnew + point[X], ynew + point[Y] });
         }
-        m_center = (m_vertexes[0] + m_vertexes[2]) * 0.5f;
-        m_axes[0] = (m_vertexes[1] - m_vertexes[0]).normalized();
-        m_axes[1] = (m_vertexes[1] - m_vertexes[2]).normalized();
+        update_axes();
     }
 
     void BoxCollider::revert()
     {
-        for (int i = 0; i < 4; i++)
-            m_vertexes[i] = m_prev_vertexes[i];
+        m_vertexes = m_prev_vertexes;
     }
 
-    Collision BoxCollider::check_collision(BoxCollider& b)
+    Collision BoxCollider::check_collision(BoxCollider const& b) const
     {
-        std::vector<math::Vector2f> axes = { m_axes[0], m_axes[1], b.m_axes[0], b.m_axes[1] };
-        for (unsigned i = 0; i < m_axes.size(); i++)
-            axes.push_back(m_axes[i]);
-        for (unsigned i = 0; i < b.m_axes.size(); i++)
-            axes.push_back(b.m_axes[i]);
+        // Both boxes are rectangles, so the two edge directions of each are
+        // the only separating axes. Every axis is projected once; this box's
+        // own axes are then scored from both sides, b's from this box's side.
+        math::Vector2f const axes[2 * NUM_AXES] = { m_axes[0], m_axes[1], b.m_axes[0], b.m_axes[1] };
+        float a_min[2 * NUM_AXES], a_max[2 * NUM_AXES];
+        float b_min[2 * NUM_AXES], b_max[2 * NUM_AXES];
+
+        for (int i = 0; i < 2 * NUM_AXES; i++)
+        {
+            project(axes[i], a_min[i], a_max[i]);
+            b.project(axes[i], b_min[i], b_max[i]);
+            if (b_min[i] > a_max[i] || b_max[i] < a_min[i])
+                return Collision(math::Vector2f::zero(), 0);
+        }
+
         int coll = 0;
         float overlap = 10000;
         math::Vector2f smallest;
-        float a_min, a_max, b_min, b_max;
 
-        for (unsigned i = 0; i < axes.size(); i++)
+        for (int k = 0; k < 3 * NUM_AXES; k++)
         {
-            a_min = m_vertexes[0].dot(axes[i]);
-            a_max = m_vertexes[0].dot(axes[i]);
-            b_min = b.m_vertexes[0].dot(axes[i]);
-            b_max = b.m_vertexes[0].dot(axes[i]);
-            for (unsigned j = 1; j < m_vertexes.size(); j++)
+            int const i = k % (2 * NUM_AXES);
+            float o;
+            if ((a_min[i] <= b_min[i] && a_max[i] >= b_max[i]) || (b_min[i] <= a_min[i] && b_max[i] >= a_max[i]))
             {
-                float n = m_vertexes[j].dot(axes[i]);
-                if (n < a_min)
-                    a_min = n;
-                if (n > a_max)
-                    a_max = n;
+                o = k < NUM_AXES ? b_max[i] - b_min[i] : a_max[i] - a_min[i];
             }
-            for (unsigned j = 1; j < b.m_vertexes.size(); j++)
+            else
             {
-                float n = b.m_vertexes[j].dot(axes[i]);
-                if (n < b_min)
-                    b_min = n;
-                if (n > b_max)
-                    b_max = n;
+                o = k < NUM_AXES ? b_max[i] - a_min[i] : a_max[i] - b_min[i];
             }
-            if (b_min > a_max || b_max < a_min)
+
+            if (o < overlap)
             {
-                return Collision(math::Vector2f::zero(), coll);
+                overlap = o;
+                smallest = axes[i];
+                coll = k < NUM_AXES ? 2 : 1;
             }
-            else
-            {
-                float o;
-                if ((a_min <= b_min && a_max >= b_max) || (b_min <= a_min && b_max >= a_max))
-                {
-                    o = i < 2 ? b_max - b_min : a_max - a_min;
-                }
-                else
-                {
-                    o = i < 2 ? b_max - a_min : a_max - b_min;
-                }
+        }
+        return Collision(overlap * smallest, coll);
+    }
 
-                if (o < overlap)
-                {
-                    overlap = o;
-                    smallest = axes[i];
-                    coll = i < 2 ? 2 : 1;
-                }
-            }
+    math::Vector2f BoxCollider::check_collision(math::Vector2f const& point) const
+    {
+        float overlap = 10000;
+        math::Vector2f smallest;
+        float a_min, a_max;
 
+        for (int i = 0; i < NUM_AXES; i++)
+        {
+            project(m_axes[i], a_min, a_max);
+            float const p = point.dot(m_axes[i]);
+            if (p > a_max || p < a_min)
+                return math::Vector2f::zero();
+
+            float const o = std::min(std::abs(a_max - p), std::abs(a_min - p));
+            if (o < overlap)
+            {
+                overlap = o;
+                smallest = m_axes[i];
+            }
         }
-        return Collision(overlap * smallest, coll);
+        return overlap * smallest;
     }
 
     float BoxCollider::signum(float n)
@@ -180,7 +162,8 @@ namespace physics
         return static_cast<float>((n > 0) - (n < 0));
     }
     TerrainCollision BoxCollider::check_terrain(RigidBodyWithCollider const& rb, entities::LevelTerrain& terr,
-                                                std::chrono::milliseconds const dt, std::vector<int> m_alphas)
+                                                std::chrono::milliseconds const dt,
+                                                std::array<int, 2 * NUM_VERTEXES> const& m_alphas) const
     {
         float const sec = static_cast<float>(static_cast<double>(dt.count()) * 1e-3);
         math::Vector2f vel = rb.get_velocity() * sec;
@@ -188,13 +171,12 @@ namespace physics
         math::Vector2f position = rb.get_position();
         float rotation = rb.get_rotation();
         BoxCollider collider = *this;
+        float const radius = get_radius();
         int iterations = 5;
         TerrainCollision coll(math::Vector2f::zero(), math::Vector2f::zero(), 1.0f);
-        std::vector<math::Vector2i> pixels_to_clear;
         math::Vector2f point;
         math::Vector2f normal;
         float correction;
-        std::vector<math::Vector2f> vert;
         for (int i = 1; i <= iterations; ++i)
         {
             float prev_rotation = rotation;
@@ -208,11 +190,24 @@ namespace physics
 
             rotation += s * math::DOUBLE_PI;
             collider.update_rotation(rotation - prev_rotation, position);
-            vert = collider.get_vertexes();
+
+            // Conservative advancement: sub-steps where the whole box is
+            // further from the terrain than its radius need no sampling,
+            // and neither do edges that are clear on their own or cross
+            // only empty terrain.
+            if (terr.is_disc_empty(collider.get_center(), radius))
+                continue;
+
+            auto const& vert = collider.get_vertexes();
             for (int k = 0; k < 8; k += 2)
             {
                 math::Vector2f move = vert[m_alphas[k]] - vert[m_alphas[k + 1]];
-                int magn = (int)move.magnitude();
+                float const length = move.magnitude();
+                if (terr.is_disc_empty((vert[m_alphas[k]] + vert[m_alphas[k + 1]]) * 0.5f, length * 0.5f)
+                    || terr.is_segment_empty(vert[m_alphas[k + 1]], vert[m_alphas[k]]))
+                    continue;
+
+                int magn = (int)length;
                 math::Vector2f norm = move.normalized();
                 for (int j = 0; j <= magn; ++j)
                 {
@@ -1,6 +1,7 @@
 #ifndef PHYSICS_BOX_COLLIDER_HPP
 #define PHYSICS_BOX_COLLIDER_HPP
 
+#include <algorithm>
 #include <array>
 #include <vector>
 #include <chrono>
@@ -13,12 +14,22 @@ namespace physics {
 class Collision;
 class RigidBodyWithCollider;
 
+// Oriented box kept in fixed-size arrays so that collision checks never
+// allocate. Vertexes go around the box, which makes edges 0-1 and 1-2 the
+// only two unique axes.
 class BoxCollider final
 {
+public:
+    static int const NUM_VERTEXES = 4;
+    static int const NUM_AXES     = 2;
+
+    // Vertex index pairs of the four edges, as walked by the terrain checks
+    static std::array<int, 2 * NUM_VERTEXES> const EDGES;
+
 private:
-    std::vector<math::Vector2f> m_vertexes;
-    std::vector<math::Vector2f> m_prev_vertexes;
-    std::vector<math::Vector2f> m_axes;
+    std::array<math::Vector2f, NUM_VERTEXES> m_vertexes;
+    std::array<math::Vector2f, NUM_VERTEXES> m_prev_vertexes;
+    std::array<math::Vector2f, NUM_AXES>     m_axes;
     math::Vector2f m_center;
     int m_size;
     int m_rb;
@@ -30,18 +41,24 @@ public:
     BoxCollider& operator=(BoxCollider const& rhs);
 
     float signum(float n);
-    Collision check_collision(BoxCollider& b);
+    Collision check_collision(BoxCollider const& b) const;
+    math::Vector2f check_collision(math::Vector2f const& point) const;
     TerrainCollision check_terrain(RigidBodyWithCollider const& rb, entities::LevelTerrain& terr,
-                       std::chrono::milliseconds const dt, std::vector<int> m_alphas); 
+                       std::chrono::milliseconds const dt, std::array<int, 2 * NUM_VERTEXES> const& m_alphas) const;
     void revert();
     void update_position(math::Vector2f const& change);
     void set_position(math::Vector2f const& pos, math::Vector2f const& offset_tl, 
                       math::Vector2f const& offset_tr, math::Vector2f const& offset_br,
                       math::Vector2f const& offset_bl);
     void update_rotation(float rotation, math::Vector2f point);
-    inline std::vector<math::Vector2f> get_vertexes();
-    inline math::Vector2f get_center();
-    inline std::vector<math::Vector2f> get_axes();
+    inline std::array<math::Vector2f, NUM_VERTEXES> const& get_vertexes() const;
+    inline math::Vector2f const& get_center() const;
+    inline float get_radius() const;
+    inline std::array<math::Vector2f, NUM_AXES> const& get_axes() const;
+
+private:
+    inline void project(math::Vector2f const& axis, float& min, float& max) const;
+    inline void update_axes();
     //inline RigidBodyWithCollider& get_rb();
     //inline void set_rb(RigidBodyWithCollider const& rb);
 };
@@ -1,18 +1,42 @@
 namespace physics
 {
-    inline std::vector<math::Vector2f> BoxCollider::get_vertexes()
+    inline std::array<math::Vector2f, BoxCollider::NUM_VERTEXES> const& BoxCollider::get_vertexes() const
     {
         return m_vertexes;
     }
-    inline math::Vector2f BoxCollider::get_center()
+    inline math::Vector2f const& BoxCollider::get_center() const
     {
         return m_center;
     }
 
-    inline std::vector<math::Vector2f> BoxCollider::get_axes()
+    // Distance from the center to every vertex
+    inline float BoxCollider::get_radius() const
+    {
+        return (m_vertexes[0] - m_vertexes[2]).magnitude() * 0.5f;
+    }
+
+    inline std::array<math::Vector2f, BoxCollider::NUM_AXES> const& BoxCollider::get_axes() const
     {
         return m_axes;
     }
+
+    // Written as independent multiply-adds over the fixed vertex count so
+    // the compiler can unroll and vectorise it.
+    inline void BoxCollider::project(math::Vector2f const& axis, float& min, float& max) const
+    {
+        float d[NUM_VERTEXES];
+        for (int i = 0; i < NUM_VERTEXES; ++i)
+            d[i] = m_vertexes[i][X] * axis[X] + m_vertexes[i][Y] * axis[Y];
+        min = std::min(std::min(d[0], d[1]), std::min(d[2], d[3]));
+        max = std::max(std::max(d[0], d[1]), std::max(d[2], d[3]));
+    }
+
+    inline void BoxCollider::update_axes()
+    {
+        m_center  = (m_vertexes[0] + m_vertexes[2]) * 0.5f;
+        m_axes[0] = (m_vertexes[1] - m_vertexes[0]).normalized();
+        m_axes[1] = (m_vertexes[1] - m_vertexes[2]).normalized();
+    }
     /*inline RigidBodyWithCollider BoxCollider::get_rb()
     {
         return m_rb;
@@ -20,10 +20,10 @@ namespace physics
                          math::Vector2f const& net_f,
                          float const net_t)
         : m_mass(mass)
-        , m_inverse_mass(mass == 0.0f ? 0.0f : 1.0f / mass)
         , m_moment_of_inertia(mass / 6.0f)
         , m_max_speed(max_spd)
         , m_max_angular_speed(max_ang_spd)
+        , m_inverse_mass(mass == 0.0f ? 0.0f : 1.0f / mass)
 
         , m_position(pos)
         , m_rotation(rot)
@@ -42,6 +42,7 @@ namespace physics
         , m_moment_of_inertia(rb.m_moment_of_inertia)
         , m_max_speed(rb.m_max_speed)
         , m_max_angular_speed(rb.m_max_angular_speed)
+        , m_inverse_mass(rb.m_inverse_mass)
 
         , m_position(rb.m_position)
         , m_rotation(rb.m_rotation)
@@ -59,6 +60,7 @@ namespace physics
         m_moment_of_inertia = rhs.m_moment_of_inertia;
         m_max_speed = rhs.m_max_speed;
         m_max_angular_speed = rhs.m_max_angular_speed;
+        m_inverse_mass = rhs.m_inverse_mass;
 
         m_position = rhs.m_position;
         m_rotation = rhs.m_rotation;
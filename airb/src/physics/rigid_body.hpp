@@ -3,6 +3,7 @@
 
 #include <chrono>
 
+#include "../math/general.hpp"
 #include "../math/matrix.hpp"
 #include "box_collider.hpp"
 
@@ -75,7 +75,10 @@ namespace physics
 
     inline math::Vector2f RigidBody::get_forward() const
     {
-        return math::Vector2f({ cosf(m_rotation), sinf(m_rotation) });
+        float s;
+        float c;
+        math::sin_cos(m_rotation, s, c);
+        return math::Vector2f({ c, s });
     }
 
     inline float RigidBody::get_angular_velocity() const
@@ -41,12 +41,20 @@ namespace physics
         bool solid = 0;
         for (unsigned n = 0; n < m_collider.size(); ++n)
         {
-            std::vector<math::Vector2f> vert = m_collider[n].get_vertexes();
+            // Boxes well clear of the terrain need no edge walk
+            if (terr.is_disc_empty(m_collider[n].get_center() - m_inverse_mass * correction,
+                                   m_collider[n].get_radius()))
+                continue;
+
+            auto vert = m_collider[n].get_vertexes();
             for (unsigned i = 0; i < vert.size(); ++i)
                 vert[i] -= m_inverse_mass * correction;
-            std::vector<int> alphas = { 1, 0, 2, 1, 3, 2, 0, 3 };
+            auto const& alphas = BoxCollider::EDGES;
             for (int k = 0; k < 8; k += 2)
             {
+                if (terr.is_segment_empty(vert[alphas[k + 1]], vert[alphas[k]]))
+                    continue;
+
                 math::Vector2f move = vert[alphas[k]] - vert[alphas[k + 1]];
                 int magn = (int)move.magnitude();
                 math::Vector2f norm = move.normalized();
@@ -76,12 +84,19 @@ namespace physics
         solid = 0;
         for (unsigned n = 0; n < b.m_collider.size(); ++n)
         {
-            std::vector<math::Vector2f> vert = b.m_collider[n].get_vertexes();
+            if (terr.is_disc_empty(b.m_collider[n].get_center() + m_inverse_mass * correction,
+                                   b.m_collider[n].get_radius()))
+                continue;
+
+            auto vert = b.m_collider[n].get_vertexes();
             for (unsigned i = 0; i < vert.size(); ++i)
                 vert[i] += m_inverse_mass * correction;
-            std::vector<int> alphas = { 1, 0, 2, 1, 3, 2, 0, 3 };
+            auto const& alphas = BoxCollider::EDGES;
             for (int k = 0; k < 8; k += 2)
             {
+                if (terr.is_segment_empty(vert[alphas[k + 1]], vert[alphas[k]]))
+                    continue;
+
                 math::Vector2f move = vert[alphas[k]] - vert[alphas[k + 1]];
                 int magn = (int)move.magnitude();
                 math::Vector2f norm = move.normalized();
@@ -160,9 +175,8 @@ namespace physics
 
         m_prev_position = m_position;
 
-        std::vector<int> m_alphas = { 1, 0, 2, 1, 3, 2, 0, 3 };
-        TerrainCollision coll = m_collider[0].check_terrain(*this, terr, dt, m_alphas);
-        TerrainCollision coll2 = m_collider[1].check_terrain(*this, terr, dt, m_alphas);
+        TerrainCollision coll = m_collider[0].check_terrain(*this, terr, dt, BoxCollider::EDGES);
+        TerrainCollision coll2 = m_collider[1].check_terrain(*this, terr, dt, BoxCollider::EDGES);
         math::Vector2f normal = coll.get_collision_normal();
         math::Vector2f point = coll.get_collision_point();
         float correction = std::min(coll.get_correction(), coll2.get_correction());
@@ -199,4 +213,18 @@ namespace physics
         reset_torque();
     }
 
+    void RigidBodyWithCollider::set_transform(math::Vector2f const& pos, float const rot)
+    {
+        math::Vector2f const shift = pos - m_position;
+        float const          turn  = rot - m_rotation;
+
+        m_position = pos;
+        m_rotation = rot;
+        for (auto& c : m_collider)
+        {
+            c.update_position(shift);
+            c.update_rotation(turn, m_position);
+        }
+    }
+
 } // namespace physics
\ No newline at end of file
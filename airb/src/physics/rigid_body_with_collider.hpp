@@ -23,6 +23,9 @@ namespace physics
         math::Vector2f find_point_of_impact(math::Vector2f normal);
         void update(std::chrono::milliseconds const dt, entities::LevelTerrain& terr) override;
 
+        // Moves and turns the body to pos and rot, taking the colliders along
+        void set_transform(math::Vector2f const& pos, float const rot);
+
         inline std::vector<BoxCollider>& get_collider();
     };
 
@@ -0,0 +1,59 @@
+#include "spatial_grid.hpp"
+
+#include <algorithm>
+
+#include "rigid_body_with_collider.hpp"
+
+namespace physics {
+
+SpatialGrid::SpatialGrid(math::Vector2i const& world_dim)
+    : m_num_cells      ({ std::max(1, (world_dim[X] + CELL_SIZE - 1) / CELL_SIZE),
+                          std::max(1, (world_dim[Y] + CELL_SIZE - 1) / CELL_SIZE) })
+    , m_cells          (m_num_cells[X] * m_num_cells[Y])
+    , m_occupied_cells ()
+{ }
+
+void SpatialGrid::clear()
+{
+    for (int const c : m_occupied_cells)
+        m_cells[c].clear();
+    m_occupied_cells.clear();
+}
+
+void SpatialGrid::insert(int const id, math::Vector2f const& min, math::Vector2f const& max)
+{
+    // Bodies partly outside the level are clamped to the border cells,
+    // and so are queries, since projectiles leave the level too.
+    int const x0 = cell_x(min[X]);
+    int const x1 = cell_x(max[X]);
+    int const y0 = cell_y(min[Y]);
+    int const y1 = cell_y(max[Y]);
+
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+        {
+            int const c = y * m_num_cells[X] + x;
+            if (m_cells[c].empty())
+                m_occupied_cells.push_back(c);
+            m_cells[c].push_back(id);
+        }
+}
+
+void SpatialGrid::insert(int const id, RigidBodyWithCollider& rb)
+{
+    auto& colliders = rb.get_collider();
+    if (colliders.empty())
+        return;
+
+    math::Vector2f min = colliders[0].get_center();
+    math::Vector2f max = min;
+    for (auto& c : colliders)
+        for (auto const& v : c.get_vertexes())
+        {
+            min = math::Vector2f({ std::min(min[X], v[X]), std::min(min[Y], v[Y]) });
+            max = math::Vector2f({ std::max(max[X], v[X]), std::max(max[Y], v[Y]) });
+        }
+    insert(id, min, max);
+}
+
+} // namespace physics
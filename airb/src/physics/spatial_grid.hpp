@@ -0,0 +1,50 @@
+#ifndef PHYSICS_SPATIAL_GRID_HPP
+#define PHYSICS_SPATIAL_GRID_HPP
+
+#include <vector>
+
+#include "../math/general.hpp"
+#include "../math/matrix.hpp"
+
+namespace physics {
+
+class RigidBodyWithCollider;
+
+// Uniform grid broad phase over the level. Bodies are inserted into every
+// cell their bounding box touches, so a point query only has to look at
+// the one cell it falls into. Anything off the level counts as being in
+// the closest border cell. Meant to be cleared and refilled each tick;
+// cell storage is kept between ticks.
+class SpatialGrid final
+{
+public:
+    static int const CELL_SIZE = 256;
+
+private:
+    math::Vector2i                m_num_cells;
+    std::vector<std::vector<int>> m_cells;
+    std::vector<int>              m_occupied_cells;
+
+public:
+    explicit SpatialGrid(math::Vector2i const& world_dim);
+            ~SpatialGrid() = default;
+
+    SpatialGrid            (SpatialGrid const&) = delete;
+    SpatialGrid& operator= (SpatialGrid const&) = delete;
+
+    void clear  ();
+    void insert (int const id, math::Vector2f const& min, math::Vector2f const& max);
+    void insert (int const id, RigidBodyWithCollider& rb);
+
+    inline std::vector<int> const& query(math::Vector2f const& point) const;
+
+private:
+    inline int cell_x(float const x) const;
+    inline int cell_y(float const y) const;
+};
+
+} // namespace physics
+
+#include "spatial_grid.inl"
+
+#endif // PHYSICS_SPATIAL_GRID_HPP
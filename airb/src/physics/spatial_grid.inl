@@ -0,0 +1,20 @@
+namespace physics {
+
+inline std::vector<int> const& SpatialGrid::query(math::Vector2f const& point) const
+{
+    // Points off the level look in the border cells, where bodies hanging
+    // over the edge were clamped to
+    return m_cells[cell_y(point[Y]) * m_num_cells[X] + cell_x(point[X])];
+}
+
+inline int SpatialGrid::cell_x(float const x) const
+{
+    return math::clamp(static_cast<int>(x) / CELL_SIZE, 0, m_num_cells[X] - 1);
+}
+
+inline int SpatialGrid::cell_y(float const y) const
+{
+    return math::clamp(static_cast<int>(y) / CELL_SIZE, 0, m_num_cells[Y] - 1);
+}
+
+} // namespace physics
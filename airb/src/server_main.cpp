@@ -0,0 +1,185 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "logic/dedicated_server.hpp"
+#include "logic/replay.hpp"
+#include "logic/room_server.hpp"
+#include "network/utilities/config.hpp"
+#include "utilities/job_system.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/random.hpp"
+#include "utilities/spawn_point.hpp"
+
+namespace
+{
+    struct Level
+    {
+        char const*        name;
+        graphics::Textures id;
+        char const*        path;
+    };
+
+    Level const LEVELS[] =
+    {
+        { "cave",   graphics::Textures::CAVE,   "res/textures/levels/cave.tga"   },
+        { "city",   graphics::Textures::CITY,   "res/textures/levels/city.tga"   },
+        { "jungle", graphics::Textures::JUNGLE, "res/textures/levels/jungle.tga" },
+        { "desert", graphics::Textures::DESERT, "res/textures/levels/desert.tga" },
+        { "snow",   graphics::Textures::SNOW,   "res/textures/levels/snow.tga"   }
+    };
+
+    // Re-simulates a recorded match without sleeping between ticks and
+    // reports whether it still plays out the same.
+    int play_replay(std::string const& path)
+    {
+        logic::ReplayPlayer player(path);
+
+        Level const* level = nullptr;
+        for (auto const& l : LEVELS)
+            if (player.get_level_id() == l.id)
+                level = &l;
+
+        if (level == nullptr)
+        {
+            std::cerr << path << " was recorded on an unknown level." << std::endl;
+            return 1;
+        }
+
+        logic::DedicatedServer s(level->id, level->path, player.get_seed());
+
+        auto const start = std::chrono::steady_clock::now();
+        logic::ReplayPlayer::Result const r = player.play(s);
+        std::chrono::duration<double> const wall = std::chrono::steady_clock::now() - start;
+
+        double const match = static_cast<double>(r.ticks)
+                           * std::chrono::duration<double>(logic::TICK_DURATION).count();
+        std::cout << "Replayed " << r.ticks << " ticks (" << match << " s) on " << level->name
+                  << " in " << wall.count() << " s, " << match / wall.count()
+                  << " times real time." << std::endl;
+        std::cout << r.keyframes << " keyframes, " << r.mismatches << " mismatches";
+        if (r.first_mismatch_tick >= 0)
+            std::cout << ", first at tick " << r.first_mismatch_tick;
+        std::cout << "." << std::endl;
+        if (!r.complete)
+            std::cerr << path << " ended before its last record." << std::endl;
+
+        return r.complete && r.mismatches == 0 ? 0 : 1;
+    }
+
+    Level const* find_level(std::string const& name)
+    {
+        for (auto const& l : LEVELS)
+            if (name == l.name)
+                return &l;
+
+        std::cerr << "Unknown level \"" << name << "\"." << std::endl;
+        return nullptr;
+    }
+
+    // Hosts many small matches on the default port, each in a room of its
+    // own, stepped by a fixed number of worker threads.
+    int run_rooms(int argc, char* argv[])
+    {
+        Level const* level = find_level(argc > 2 ? argv[2] : LEVELS[0].name);
+        if (level == nullptr)
+            return 1;
+
+        int workers = utilities::JobSystem::default_num_workers() + 1;
+        if (argc > 3)
+        {
+            char* end = nullptr;
+            workers = static_cast<int>(std::strtol(argv[3], &end, 10));
+            if (end == argv[3] || *end != '\0' || workers < 1)
+            {
+                std::cerr << "Invalid worker count \"" << argv[3] << "\"." << std::endl;
+                return 1;
+            }
+        }
+
+        utilities::init_spawn_points();
+        try
+        {
+            logic::RoomServer s(level->id, level->path,
+                                static_cast<unsigned short>(network::SERVER_DEFAULT_PORT), workers);
+            s.run();
+        }
+        catch (std::exception const& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+}
+
+// airb_server [level [seed [replay file to record]]]
+// airb_server --replay <replay file>
+// airb_server --rooms [level [workers]]
+int main(int argc, char* argv[])
+{
+    if (argc > 1 && std::string(argv[1]) == "--rooms")
+        return run_rooms(argc, argv);
+
+    if (argc > 1 && std::string(argv[1]) == "--replay")
+    {
+        if (argc != 3)
+        {
+            std::cerr << "Usage: " << argv[0] << " --replay <file>" << std::endl;
+            return 1;
+        }
+
+        utilities::init_spawn_points();
+        try
+        {
+            return play_replay(argv[2]);
+        }
+        catch (std::exception const& ex)
+        {
+            std::cerr << ex.what() << std::endl;
+            return 1;
+        }
+    }
+
+    Level const* level = find_level(argc > 1 ? argv[1] : LEVELS[0].name);
+    if (level == nullptr)
+        return 1;
+
+    // A match is reproducible from its seed, so a logged seed can be
+    // passed back in to replay it.
+    std::uint64_t seed = utilities::Random::make_seed();
+    if (argc > 2)
+    {
+        char* end = nullptr;
+        seed = std::strtoull(argv[2], &end, 10);
+        if (end == argv[2] || *end != '\0')
+        {
+            std::cerr << "Invalid seed \"" << argv[2] << "\"." << std::endl;
+            return 1;
+        }
+    }
+
+    bool err = false;
+
+    utilities::init_spawn_points();
+
+    try
+    {
+        utilities::Debug::log("Starting dedicated server.");
+        logic::DedicatedServer s(level->id, level->path, seed);
+        if (argc > 3)
+            s.start_recording(argv[3]);
+        s.run();
+    }
+    catch (std::exception const& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        err = true;
+    }
+
+    utilities::Debug::log("Exiting dedicated server.");
+    return err ? 1 : 0;
+}
@@ -0,0 +1,74 @@
+#include "binary_stream.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace utilities {
+
+std::size_t const BinaryWriter::BUFFER_SIZE;
+std::size_t const BinaryReader::BUFFER_SIZE;
+
+BinaryWriter::BinaryWriter(std::string const& path)
+    : m_file   (std::fopen(path.c_str(), "wb"))
+    , m_buffer (BUFFER_SIZE)
+    , m_used   (0)
+{
+    if (m_file == nullptr)
+        throw std::runtime_error("Opening file " + path + " for writing failed.");
+}
+
+BinaryWriter::~BinaryWriter()
+{
+    flush();
+    std::fclose(m_file);
+}
+
+void BinaryWriter::flush()
+{
+    // A short write means a full disk or a lost device; the rest of the
+    // recording is dropped rather than stopping the match.
+    if (m_used > 0)
+        std::fwrite(m_buffer.data(), 1, m_used, m_file);
+    m_used = 0;
+    std::fflush(m_file);
+}
+
+BinaryReader::BinaryReader(std::string const& path)
+    : m_file   (std::fopen(path.c_str(), "rb"))
+    , m_buffer (BUFFER_SIZE)
+    , m_used   (0)
+    , m_size   (0)
+{
+    if (m_file == nullptr)
+        throw std::runtime_error("Opening file " + path + " failed.");
+}
+
+BinaryReader::~BinaryReader()
+{
+    std::fclose(m_file);
+}
+
+bool BinaryReader::read(void* data, std::size_t const size)
+{
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    for (std::size_t left = size; left > 0; )
+    {
+        if (m_used == m_size && !refill())
+            return false;
+        std::size_t const n = std::min(left, m_size - m_used);
+        std::memcpy(bytes, &m_buffer[m_used], n);
+        m_used += n;
+        bytes  += n;
+        left   -= n;
+    }
+    return true;
+}
+
+bool BinaryReader::refill()
+{
+    m_used = 0;
+    m_size = std::fread(m_buffer.data(), 1, BUFFER_SIZE, m_file);
+    return m_size > 0;
+}
+
+} // namespace utilities
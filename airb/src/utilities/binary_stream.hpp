@@ -0,0 +1,77 @@
+#ifndef UTILITIES_BINARY_STREAM_HPP
+#define UTILITIES_BINARY_STREAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace utilities {
+
+// Little-endian binary file output through a fixed buffer, so a record of
+// a few bytes per tick costs a copy instead of a system call. The file is
+// flushed when the buffer fills and on destruction.
+class BinaryWriter final
+{
+private:
+    static std::size_t const BUFFER_SIZE = 1 << 16;
+
+    std::FILE*                 m_file;
+    std::vector<unsigned char> m_buffer;
+    std::size_t                m_used;
+
+public:
+    explicit BinaryWriter(std::string const& path);
+            ~BinaryWriter();
+
+    BinaryWriter            (BinaryWriter const&) = delete;
+    BinaryWriter& operator= (BinaryWriter const&) = delete;
+
+    inline void write_u8  (std::uint8_t const v);
+    inline void write_u16 (std::uint16_t const v);
+    inline void write_u32 (std::uint32_t const v);
+    inline void write_u64 (std::uint64_t const v);
+    inline void write_i32 (std::int32_t const v);
+    inline void write_f32 (float const v);
+    inline void write     (void const* data, std::size_t const size);
+
+    void flush();
+};
+
+// Reads what BinaryWriter wrote, refilling a fixed buffer from the file.
+// Reads past the end of the file fail and leave the value untouched.
+class BinaryReader final
+{
+private:
+    static std::size_t const BUFFER_SIZE = 1 << 16;
+
+    std::FILE*                 m_file;
+    std::vector<unsigned char> m_buffer;
+    std::size_t                m_used;
+    std::size_t                m_size;
+
+public:
+    explicit BinaryReader(std::string const& path);
+            ~BinaryReader();
+
+    BinaryReader            (BinaryReader const&) = delete;
+    BinaryReader& operator= (BinaryReader const&) = delete;
+
+    inline bool read_u8  (std::uint8_t& v);
+    inline bool read_u16 (std::uint16_t& v);
+    inline bool read_u32 (std::uint32_t& v);
+    inline bool read_u64 (std::uint64_t& v);
+    inline bool read_i32 (std::int32_t& v);
+    inline bool read_f32 (float& v);
+    bool        read     (void* data, std::size_t const size);
+
+private:
+    bool refill();
+};
+
+} // namespace utilities
+
+#include "binary_stream.inl"
+
+#endif // UTILITIES_BINARY_STREAM_HPP
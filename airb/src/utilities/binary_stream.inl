@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstring>
+
+namespace utilities {
+
+inline void BinaryWriter::write_u8(std::uint8_t const v)
+{
+    if (m_used == BUFFER_SIZE)
+        flush();
+    m_buffer[m_used++] = v;
+}
+
+inline void BinaryWriter::write_u16(std::uint16_t const v)
+{
+    unsigned char const b[2] =
+    {
+        static_cast<unsigned char>(v),
+        static_cast<unsigned char>(v >> 8u)
+    };
+    write(b, sizeof(b));
+}
+
+inline void BinaryWriter::write_u32(std::uint32_t const v)
+{
+    unsigned char const b[4] =
+    {
+        static_cast<unsigned char>(v),
+        static_cast<unsigned char>(v >> 8u),
+        static_cast<unsigned char>(v >> 16u),
+        static_cast<unsigned char>(v >> 24u)
+    };
+    write(b, sizeof(b));
+}
+
+inline void BinaryWriter::write_u64(std::uint64_t const v)
+{
+    write_u32(static_cast<std::uint32_t>(v));
+    write_u32(static_cast<std::uint32_t>(v >> 32u));
+}
+
+inline void BinaryWriter::write_i32(std::int32_t const v)
+{
+    write_u32(static_cast<std::uint32_t>(v));
+}
+
+inline void BinaryWriter::write_f32(float const v)
+{
+    static_assert(sizeof(float) == sizeof(std::uint32_t), "float must be 32 bits");
+    std::uint32_t bits;
+    std::memcpy(&bits, &v, sizeof(bits));
+    write_u32(bits);
+}
+
+inline void BinaryWriter::write(void const* data, std::size_t const size)
+{
+    unsigned char const* bytes = static_cast<unsigned char const*>(data);
+    for (std::size_t left = size; left > 0; )
+    {
+        if (m_used == BUFFER_SIZE)
+            flush();
+        std::size_t const n = std::min(left, BUFFER_SIZE - m_used);
+        std::memcpy(&m_buffer[m_used], bytes, n);
+        m_used += n;
+        bytes  += n;
+        left   -= n;
+    }
+}
+
+inline bool BinaryReader::read_u8(std::uint8_t& v)
+{
+    if (m_used == m_size && !refill())
+        return false;
+    v = m_buffer[m_used++];
+    return true;
+}
+
+inline bool BinaryReader::read_u16(std::uint16_t& v)
+{
+    unsigned char b[2];
+    if (!read(b, sizeof(b)))
+        return false;
+    v = static_cast<std::uint16_t>(b[0] | b[1] << 8u);
+    return true;
+}
+
+inline bool BinaryReader::read_u32(std::uint32_t& v)
+{
+    unsigned char b[4];
+    if (!read(b, sizeof(b)))
+        return false;
+    v = static_cast<std::uint32_t>(b[0])
+      | static_cast<std::uint32_t>(b[1]) << 8u
+      | static_cast<std::uint32_t>(b[2]) << 16u
+      | static_cast<std::uint32_t>(b[3]) << 24u;
+    return true;
+}
+
+inline bool BinaryReader::read_u64(std::uint64_t& v)
+{
+    std::uint32_t lo;
+    std::uint32_t hi;
+    if (!read_u32(lo) || !read_u32(hi))
+        return false;
+    v = static_cast<std::uint64_t>(hi) << 32u | lo;
+    return true;
+}
+
+inline bool BinaryReader::read_i32(std::int32_t& v)
+{
+    std::uint32_t u;
+    if (!read_u32(u))
+        return false;
+    v = static_cast<std::int32_t>(u);
+    return true;
+}
+
+inline bool BinaryReader::read_f32(float& v)
+{
+    std::uint32_t bits;
+    if (!read_u32(bits))
+        return false;
+    std::memcpy(&v, &bits, sizeof(v));
+    return true;
+}
+
+} // namespace utilities
@@ -0,0 +1,74 @@
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace utilities {
+
+int const Histogram::SUB_BUCKET_BITS;
+int const Histogram::SUB_BUCKETS;
+int const Histogram::NUM_BUCKETS;
+
+Histogram::Histogram()
+    : m_counts ()
+    , m_total  (0)
+    , m_sum    (0)
+    , m_max    (0)
+{ }
+
+void Histogram::merge(Histogram const& other)
+{
+    for (int i = 0; i < NUM_BUCKETS; ++i)
+        m_counts[i] += other.m_counts[i];
+    m_total += other.m_total;
+    m_sum   += other.m_sum;
+    m_max    = std::max(m_max, other.m_max);
+}
+
+void Histogram::reset()
+{
+    std::fill(m_counts, m_counts + NUM_BUCKETS, 0u);
+    m_total = 0;
+    m_sum   = 0;
+    m_max   = 0;
+}
+
+double Histogram::get_mean() const
+{
+    return m_total == 0 ? 0.0 : static_cast<double>(m_sum) / static_cast<double>(m_total);
+}
+
+std::uint32_t Histogram::get_percentile(double const fraction) const
+{
+    if (m_total == 0)
+        return 0;
+
+    double const clamped = std::min(std::max(fraction, 0.0), 1.0);
+    std::uint64_t const rank = std::max(
+        static_cast<std::uint64_t>(std::ceil(clamped * static_cast<double>(m_total))),
+        std::uint64_t(1)
+    );
+
+    std::uint64_t seen = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i)
+    {
+        seen += m_counts[i];
+        if (seen >= rank)
+            return std::min(get_bucket_limit(i), m_max);
+    }
+    return m_max;
+}
+
+std::uint32_t Histogram::get_bucket_limit(int const bucket)
+{
+    if (bucket < SUB_BUCKETS)
+        return static_cast<std::uint32_t>(bucket);
+
+    int const shift = bucket / SUB_BUCKETS - 1;
+    int const sub   = bucket % SUB_BUCKETS;
+    std::uint64_t const lower = static_cast<std::uint64_t>(SUB_BUCKETS + sub) << shift;
+    std::uint64_t const limit = lower + (std::uint64_t(1) << shift) - 1;
+    return static_cast<std::uint32_t>(std::min<std::uint64_t>(limit, 0xffffffffu));
+}
+
+} // namespace utilities
@@ -0,0 +1,50 @@
+#ifndef UTILITIES_HISTOGRAM_HPP
+#define UTILITIES_HISTOGRAM_HPP
+
+#include <cstdint>
+
+namespace utilities {
+
+// Counts of unsigned 32-bit values, such as durations in microseconds, in
+// log-linear buckets: every power of two is split into eight, so a
+// percentile is off by at most an eighth of its value however wide the
+// range is. Recording is a few shifts and an increment, and the whole
+// histogram is a fixed array that can be copied and merged.
+class Histogram final
+{
+private:
+    static int const SUB_BUCKET_BITS = 3;
+    static int const SUB_BUCKETS     = 1 << SUB_BUCKET_BITS;
+    static int const NUM_BUCKETS     = (32 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    std::uint32_t m_counts[NUM_BUCKETS];
+    std::uint64_t m_total;
+    std::uint64_t m_sum;
+    std::uint32_t m_max;
+
+public:
+     Histogram();
+    ~Histogram() = default;
+
+    inline void record (std::uint32_t const value);
+    void        merge  (Histogram const& other);
+    void        reset  ();
+
+    inline std::uint64_t get_count () const;
+    inline std::uint32_t get_max   () const;
+    double               get_mean  () const;
+
+    // Upper bound of the bucket holding the given fraction in [0, 1] of
+    // the values recorded, never above the largest one
+    std::uint32_t get_percentile(double const fraction) const;
+
+private:
+    static inline int    get_bucket       (std::uint32_t const value);
+    static std::uint32_t get_bucket_limit (int const bucket);
+};
+
+} // namespace utilities
+
+#include "histogram.inl"
+
+#endif // UTILITIES_HISTOGRAM_HPP
@@ -0,0 +1,38 @@
+namespace utilities {
+
+inline void Histogram::record(std::uint32_t const value)
+{
+    ++m_counts[get_bucket(value)];
+    ++m_total;
+    m_sum += value;
+    if (value > m_max)
+        m_max = value;
+}
+
+inline std::uint64_t Histogram::get_count() const
+{
+    return m_total;
+}
+
+inline std::uint32_t Histogram::get_max() const
+{
+    return m_max;
+}
+
+inline int Histogram::get_bucket(std::uint32_t const value)
+{
+    if (value < static_cast<std::uint32_t>(SUB_BUCKETS))
+        return static_cast<int>(value);
+
+    // Index of the highest set bit picks the power of two, the bits below
+    // it the sub-bucket
+    int msb = 0;
+    for (std::uint32_t v = value; v > 1u; v >>= 1u)
+        ++msb;
+
+    int const shift = msb - SUB_BUCKET_BITS;
+    int const sub   = static_cast<int>(value >> shift) - SUB_BUCKETS;
+    return (shift + 1) * SUB_BUCKETS + sub;
+}
+
+} // namespace utilities
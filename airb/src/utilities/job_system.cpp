@@ -0,0 +1,133 @@
+#include "job_system.hpp"
+
+#include <algorithm>
+
+namespace utilities {
+
+int JobSystem::default_num_workers()
+{
+    int const hw = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(hw - 1, 0);
+}
+
+JobSystem::JobSystem(int const num_workers)
+    : m_queues  ()
+    , m_workers ()
+
+    , m_wake_mutex ()
+    , m_wake       ()
+    , m_pending    (0)
+    , m_quit       (false)
+{
+    int const n = std::max(num_workers, 0);
+
+    // The last queue belongs to the thread calling parallel_for
+    for (int i = 0; i < n + 1; ++i)
+        m_queues.push_back(std::make_unique<Queue>());
+
+    m_workers.reserve(static_cast<size_t>(n));
+    for (int i = 0; i < n; ++i)
+        m_workers.emplace_back([this, i] { worker_loop(i); });
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_wake_mutex);
+        m_quit = true;
+    }
+    m_wake.notify_all();
+
+    for (auto& w : m_workers)
+        w.join();
+}
+
+int JobSystem::get_num_threads() const
+{
+    return static_cast<int>(m_workers.size()) + 1;
+}
+
+void JobSystem::run(Task const& task, int const count, int const grain)
+{
+    int const num_queues = static_cast<int>(m_queues.size());
+    int const step       = std::max(grain, 1);
+    int const num_jobs   = (count + step - 1) / step;
+
+    std::atomic<int> remaining(num_jobs);
+
+    for (int q = 0; q < num_queues; ++q)
+    {
+        Queue& queue = *m_queues[q];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        for (int j = q; j < num_jobs; j += num_queues)
+            queue.jobs.push_back(Job{ &task, j * step, std::min((j + 1) * step, count), &remaining });
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_wake_mutex);
+        m_pending += num_jobs;
+    }
+    m_wake.notify_all();
+
+    int const own = num_queues - 1;
+    while (remaining.load(std::memory_order_acquire) > 0)
+        if (!run_one(own))
+            std::this_thread::yield();
+}
+
+bool JobSystem::run_one(int const queue)
+{
+    int const num_queues = static_cast<int>(m_queues.size());
+
+    Job  job   = Job{ nullptr, 0, 0, nullptr };
+    bool found = false;
+
+    {
+        Queue& own = *m_queues[queue];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+
+    for (int k = 1; k < num_queues && !found; ++k)
+    {
+        Queue& victim = *m_queues[(queue + k) % num_queues];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    --m_pending;
+    job.task->invoke(job.task->func, job.begin, job.end);
+
+    // Last touch of the job; the caller may return as soon as this lands
+    job.remaining->fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+void JobSystem::worker_loop(int const queue)
+{
+    for (;;)
+    {
+        if (run_one(queue))
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+        m_wake.wait(lock, [this] { return m_quit || m_pending.load() > 0; });
+        if (m_quit)
+            return;
+    }
+}
+
+} // namespace utilities
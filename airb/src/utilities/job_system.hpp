@@ -0,0 +1,87 @@
+#ifndef UTILITIES_JOB_SYSTEM_HPP
+#define UTILITIES_JOB_SYSTEM_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utilities {
+
+// Fixed pool of worker threads for data-parallel loops over the
+// simulation. A loop is cut into jobs that are dealt out to one deque per
+// thread; a thread pops from the back of its own deque and steals from the
+// front of the others once it runs dry. The calling thread works through
+// the loop as well and returns only when every job has finished, so a pool
+// without workers simply runs the loop inline.
+//
+// Jobs must only write state owned by their own indices. Any effect on
+// shared state is recorded per index and applied by the caller afterwards,
+// in index order, which keeps results independent of the thread count.
+// parallel_for is meant to be called from one thread and not from inside
+// a job.
+class JobSystem final
+{
+private:
+    struct Task
+    {
+        void       (*invoke)(void const* func, int const begin, int const end);
+        void const*  func;
+    };
+
+    struct Job
+    {
+        Task const*       task;
+        int               begin;
+        int               end;
+        std::atomic<int>* remaining;
+    };
+
+    struct Queue
+    {
+        std::deque<Job> jobs;
+        std::mutex      mutex;
+
+        Queue() : jobs(), mutex() { }
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread>            m_workers;
+
+    std::mutex              m_wake_mutex;
+    std::condition_variable m_wake;
+    std::atomic<int>        m_pending;
+    bool                    m_quit;
+
+public:
+    // One worker fewer than the hardware has threads, the caller being
+    // the last one
+    static int default_num_workers();
+
+    explicit JobSystem(int const num_workers = default_num_workers());
+            ~JobSystem();
+
+    JobSystem            (JobSystem const&) = delete;
+    JobSystem& operator= (JobSystem const&) = delete;
+
+    // Calls func(begin, end) over [0, count) in ranges of at most grain
+    // indices and returns once all of them are done
+    template<class Func>
+    void parallel_for(int const count, int const grain, Func const& func);
+
+    int get_num_threads() const;
+
+private:
+    void run         (Task const& task, int const count, int const grain);
+    bool run_one     (int const queue);
+    void worker_loop (int const queue);
+};
+
+} // namespace utilities
+
+#include "job_system.tpp"
+
+#endif // UTILITIES_JOB_SYSTEM_HPP
@@ -0,0 +1,26 @@
+namespace utilities {
+
+template<class Func>
+void JobSystem::parallel_for(int const count, int const grain, Func const& func)
+{
+    if (count <= 0)
+        return;
+
+    if (m_workers.empty() || count <= grain)
+    {
+        func(0, count);
+        return;
+    }
+
+    Task const task =
+    {
+        [](void const* f, int const begin, int const end)
+        {
+            (*static_cast<Func const*>(f))(begin, end);
+        },
+        &func
+    };
+    run(task, count, grain);
+}
+
+} // namespace utilities
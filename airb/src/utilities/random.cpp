@@ -0,0 +1,22 @@
+#include "random.hpp"
+
+#include <random>
+
+namespace utilities {
+
+std::uint64_t const Random::MULTIPLIER;
+std::uint64_t const Random::INCREMENT;
+
+Random::Random(std::uint64_t const s)
+    : m_state (0)
+{
+    seed(s);
+}
+
+std::uint64_t Random::make_seed()
+{
+    std::random_device rd;
+    return (static_cast<std::uint64_t>(rd()) << 32u) | static_cast<std::uint64_t>(rd());
+}
+
+} // namespace utilities
@@ -0,0 +1,41 @@
+#ifndef UTILITIES_RANDOM_HPP
+#define UTILITIES_RANDOM_HPP
+
+#include <cstdint>
+
+namespace utilities {
+
+// PCG32 generator. Unlike rand() its sequence depends only on the seed,
+// not on the platform or on other code drawing from a shared state, so a
+// match seeded the same way makes the same choices everywhere.
+class Random final
+{
+private:
+    static std::uint64_t const MULTIPLIER = 6364136223846793005ull;
+    static std::uint64_t const INCREMENT  = 1442695040888963407ull;
+
+    std::uint64_t m_state;
+
+public:
+    explicit Random(std::uint64_t const s);
+            ~Random() = default;
+
+    Random            (Random const&) = delete;
+    Random& operator= (Random const&) = delete;
+
+    inline void          seed       (std::uint64_t const s);
+    inline std::uint32_t next       ();
+    // Uniform in [0, bound); bound must be positive
+    inline int           next_int   (int const bound);
+    // Uniform in [0, 1)
+    inline float         next_float ();
+
+    // Seed for a new match taken from the operating system
+    static std::uint64_t make_seed();
+};
+
+} // namespace utilities
+
+#include "random.inl"
+
+#endif // UTILITIES_RANDOM_HPP
@@ -0,0 +1,37 @@
+#include <cassert>
+
+namespace utilities {
+
+inline void Random::seed(std::uint64_t const s)
+{
+    m_state = 0;
+    next();
+    m_state += s;
+    next();
+}
+
+inline std::uint32_t Random::next()
+{
+    std::uint64_t const old = m_state;
+    m_state = old * MULTIPLIER + INCREMENT;
+
+    std::uint32_t const xorshifted = static_cast<std::uint32_t>(((old >> 18u) ^ old) >> 27u);
+    std::uint32_t const rot        = static_cast<std::uint32_t>(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((0u - rot) & 31u));
+}
+
+inline int Random::next_int(int const bound)
+{
+    assert(bound > 0);
+
+    // Multiply-shift keeps the high bits, which are the better ones
+    return static_cast<int>((static_cast<std::uint64_t>(next()) * static_cast<std::uint64_t>(bound)) >> 32u);
+}
+
+inline float Random::next_float()
+{
+    // 24 bits fill the float mantissa exactly
+    return static_cast<float>(next() >> 8u) * (1.0f / 16777216.0f);
+}
+
+} // namespace utilities
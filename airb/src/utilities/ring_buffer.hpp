@@ -0,0 +1,78 @@
+#ifndef UTILITIES_RING_BUFFER_HPP
+#define UTILITIES_RING_BUFFER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace utilities {
+
+// Bounded lock-free queue for handing items from the socket listener
+// threads to the thread polling them. Any number of threads may enqueue,
+// only one may dequeue.
+//
+// Every slot carries a sequence number telling whose turn it is: a
+// producer claims the slot at the tail with one compare-and-swap and
+// publishes it by bumping its sequence, the consumer takes the slot at the
+// head once its sequence says it is filled and hands it back a lap later.
+// With a single producer the swap never has to be retried. The head and
+// tail each sit on a cache line of their own so the two sides do not
+// invalidate each other's line on every operation.
+//
+// A full queue refuses new items instead of waiting or growing.
+template<class T>
+class RingBuffer final
+{
+private:
+    static std::size_t const CACHE_LINE_SIZE = 64;
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        T                        value;
+
+        Slot() : sequence(0), value() { }
+    };
+
+    std::unique_ptr<Slot[]> const m_slots;
+    std::size_t const             m_mask;
+
+    char                     m_pad0[CACHE_LINE_SIZE];
+    std::atomic<std::size_t> m_tail;
+    char                     m_pad1[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+    std::atomic<std::size_t> m_head;
+    char                     m_pad2[CACHE_LINE_SIZE - sizeof(std::atomic<std::size_t>)];
+
+public:
+    // The capacity is rounded up to a power of two, and to at least two
+    explicit RingBuffer(std::size_t const capacity);
+            ~RingBuffer() = default;
+
+    RingBuffer            (RingBuffer const&) = delete;
+    RingBuffer& operator= (RingBuffer const&) = delete;
+
+    // Return false without touching the item when the queue is full
+    bool try_enqueue(T const& item);
+    bool try_enqueue(T&& item);
+
+    // Consumer only. Moves out the oldest item, or up to max of the oldest
+    // items into out, and returns how many were taken.
+    bool        try_dequeue      (T& item);
+    std::size_t try_dequeue_bulk (T* out, std::size_t const max);
+
+    // Consumer only; producers may have filled slots since
+    bool        empty        () const;
+    std::size_t get_capacity () const;
+
+private:
+    template<class U>
+    bool enqueue(U&& item);
+
+    static std::size_t round_up_pow2(std::size_t const n);
+};
+
+} // namespace utilities
+
+#include "ring_buffer.tpp"
+
+#endif // UTILITIES_RING_BUFFER_HPP
@@ -0,0 +1,114 @@
+#include <utility>
+
+namespace utilities {
+
+template<class T>
+RingBuffer<T>::RingBuffer(std::size_t const capacity)
+    : m_slots (new Slot[round_up_pow2(capacity)])
+    , m_mask  (round_up_pow2(capacity) - 1)
+    , m_pad0  ()
+    , m_tail  (0)
+    , m_pad1  ()
+    , m_head  (0)
+    , m_pad2  ()
+{
+    for (std::size_t i = 0; i <= m_mask; ++i)
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+template<class T>
+bool RingBuffer<T>::try_enqueue(T const& item)
+{
+    return enqueue(item);
+}
+
+template<class T>
+bool RingBuffer<T>::try_enqueue(T&& item)
+{
+    return enqueue(std::move(item));
+}
+
+template<class T>
+template<class U>
+bool RingBuffer<T>::enqueue(U&& item)
+{
+    std::size_t pos = m_tail.load(std::memory_order_relaxed);
+    Slot* slot;
+    for (;;)
+    {
+        slot = &m_slots[pos & m_mask];
+        std::size_t const seq = slot->sequence.load(std::memory_order_acquire);
+        std::ptrdiff_t const diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+        // The slot is free for this lap; another producer may race for it
+        if (diff == 0)
+        {
+            if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        // The consumer has not taken the slot from the previous lap yet
+        else if (diff < 0)
+        {
+            return false;
+        }
+        else
+        {
+            pos = m_tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->value = std::forward<U>(item);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+template<class T>
+bool RingBuffer<T>::try_dequeue(T& item)
+{
+    return try_dequeue_bulk(&item, 1) == 1;
+}
+
+template<class T>
+std::size_t RingBuffer<T>::try_dequeue_bulk(T* out, std::size_t const max)
+{
+    std::size_t const head = m_head.load(std::memory_order_relaxed);
+    std::size_t n = 0;
+    for (; n < max; ++n)
+    {
+        Slot& slot = m_slots[(head + n) & m_mask];
+        if (slot.sequence.load(std::memory_order_acquire) != head + n + 1)
+            break;
+
+        out[n] = std::move(slot.value);
+        slot.sequence.store(head + n + m_mask + 1, std::memory_order_release);
+    }
+
+    m_head.store(head + n, std::memory_order_relaxed);
+    return n;
+}
+
+template<class T>
+bool RingBuffer<T>::empty() const
+{
+    std::size_t const head = m_head.load(std::memory_order_relaxed);
+    return m_slots[head & m_mask].sequence.load(std::memory_order_acquire) != head + 1;
+}
+
+template<class T>
+std::size_t RingBuffer<T>::get_capacity() const
+{
+    return m_mask + 1;
+}
+
+template<class T>
+std::size_t RingBuffer<T>::round_up_pow2(std::size_t const n)
+{
+    // A filled slot's sequence equals the next lap's position when there
+    // is only one slot, so a second enqueue would overwrite an unread item
+    std::size_t p = 2;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+
+} // namespace utilities
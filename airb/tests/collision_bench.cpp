@@ -0,0 +1,110 @@
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_planes.hpp"
+#include "../src/physics/collision.hpp"
+
+// The narrow phase of a busy tick with every allocation counted: 64
+// turned planes close together, each pair of boxes checked with
+// BoxCollider::check_collision as the plane against plane loop does, and
+// 1,000 projectiles checked against every box as the projectile loop
+// does. Both loops have to stay off the heap.
+
+namespace {
+
+int const NUM_PLANES      = 64;
+int const NUM_PROJECTILES = 1000;
+int const TICKS           = 200;
+
+long g_allocations = 0;
+
+volatile float g_sink;
+
+template<class Tick>
+void run(char const* const name, long const tests, Tick const& tick)
+{
+    long const before = g_allocations;
+    double const ns = test::time_ns(TICKS, tick);
+    double const allocations = static_cast<double>(g_allocations - before) / TICKS;
+
+    std::printf("  %-12s %7ld tests/tick  %6.0f allocations/tick  %8.1f M tests/s  %8.3f ms/tick\n",
+                name, tests, allocations, static_cast<double>(tests) * 1e3 / ns, ns * 1e-6);
+}
+
+} // namespace
+
+void* operator new(std::size_t const size)
+{
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* const p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    std::mt19937 rng(31);
+    std::uniform_real_distribution<float> x(1000.0f, 1600.0f);
+    std::uniform_real_distribution<float> y(1000.0f, 1400.0f);
+    std::uniform_real_distribution<float> rot(0.0f, 6.2831853f);
+
+    std::vector<physics::RigidBodyWithCollider> planes;
+    for (int i = 0; i < NUM_PLANES; ++i)
+        planes.push_back(test::make_plane_body(math::Vector2f({ x(rng), y(rng) }), rot(rng)));
+
+    std::vector<math::Vector2f> projectiles;
+    for (int i = 0; i < NUM_PROJECTILES; ++i)
+        projectiles.push_back(math::Vector2f({ x(rng), y(rng) }));
+
+    std::printf("collision_bench: %d planes, %d projectiles, %d ticks\n",
+                NUM_PLANES, NUM_PROJECTILES, TICKS);
+
+    int box_hits = 0;
+    run("box-box", static_cast<long>(NUM_PLANES) * (NUM_PLANES - 1) / 2 * 4, [&]()
+    {
+        box_hits = 0;
+        float mtv = 0.0f;
+        for (size_t i = 0; i < planes.size(); ++i)
+            for (size_t k = i + 1; k < planes.size(); ++k)
+                for (auto const& a : planes[i].get_collider())
+                    for (auto const& b : planes[k].get_collider())
+                    {
+                        physics::Collision coll = a.check_collision(b);
+                        math::Vector2f const m = coll.get_mtv();
+                        box_hits += m[X] != 0 || m[Y] != 0;
+                        mtv += m[X] + m[Y];
+                    }
+        g_sink = mtv;
+    });
+
+    int point_hits = 0;
+    run("point-box", static_cast<long>(NUM_PROJECTILES) * NUM_PLANES * 2, [&]()
+    {
+        point_hits = 0;
+        for (auto const& pos : projectiles)
+            for (auto& plane : planes)
+                for (auto const& c : plane.get_collider())
+                {
+                    math::Vector2f const m = c.check_collision(pos);
+                    point_hits += m[X] != 0 || m[Y] != 0;
+                }
+        g_sink = static_cast<float>(point_hits);
+    });
+
+    std::printf("  %d box hits, %d projectile hits per tick\n", box_hits, point_hits);
+    return 0;
+}
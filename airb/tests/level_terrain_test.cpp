@@ -0,0 +1,63 @@
+#include "test.hpp"
+#include "test_level.hpp"
+
+// LevelTerrain pixel lookups at and past the edges of the level.
+
+namespace {
+
+int const WIDTH  = 45;
+int const HEIGHT = 30;
+
+bool is_solid(int const x, int const y)
+{
+    return (x + y) % 3 == 0;
+}
+
+void test_pixels_inside_match_image()
+{
+    test::TestLevel level(WIDTH, HEIGHT, is_solid);
+    entities::LevelTerrain const& terrain = level.get_terrain();
+
+    bool same = true;
+    for (int y = 0; y < HEIGHT; ++y)
+        for (int x = 0; x < WIDTH; ++x)
+            same = same && terrain.is_pixel_solid(math::Vector2i({ x, y })) == is_solid(x, y);
+    CHECK(same);
+}
+
+void test_pixels_outside_are_solid()
+{
+    // Open terrain, so only the border can make a pixel solid
+    test::TestLevel level(WIDTH, HEIGHT, [](int, int) { return false; });
+    entities::LevelTerrain const& terrain = level.get_terrain();
+
+    CHECK(!terrain.is_pixel_solid(math::Vector2i({ 0, 0 })));
+    CHECK(!terrain.is_pixel_solid(math::Vector2i({ WIDTH - 1, HEIGHT - 1 })));
+
+    // Just past every edge and corner, where collider edge walks step off
+    // the level, and far enough out to miss the mask entirely
+    int const xs[5] = { -100000, -1, WIDTH / 2, WIDTH, WIDTH + 100000 };
+    int const ys[5] = { -100000, -1, HEIGHT / 2, HEIGHT, HEIGHT + 100000 };
+    for (int const x : xs)
+        for (int const y : ys)
+        {
+            bool const inside = x == WIDTH / 2 && y == HEIGHT / 2;
+            CHECK(terrain.is_pixel_solid(math::Vector2i({ x, y })) == !inside);
+        }
+
+    // Rows past the level used to read the empty lower half of the image
+    bool below = true;
+    for (int y = HEIGHT; y < 2 * HEIGHT; ++y)
+        for (int x = 0; x < WIDTH; ++x)
+            below = below && terrain.is_pixel_solid(math::Vector2i({ x, y }));
+    CHECK(below);
+}
+
+} // namespace
+
+int main()
+{
+    test_pixels_inside_match_image();
+    test_pixels_outside_are_solid();
+    return test::finish("level_terrain_test");
+}
@@ -0,0 +1,119 @@
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_level.hpp"
+#include "../src/ai/open_list.hpp"
+#include "../src/ai/path_finding.hpp"
+
+namespace {
+
+float f_score(ai::SearchNode const* n)
+{
+    return n->m_accumulated_distance + n->m_heuristic_distance;
+}
+
+void test_pops_in_f_order()
+{
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> dist(0.0f, 100.0f);
+
+    std::vector<ai::SearchNode> nodes;
+    for (int i = 0; i < 500; ++i)
+        nodes.emplace_back(i % 120, i / 120, 120);
+
+    ai::OpenList open;
+    for (auto& n : nodes)
+    {
+        n.m_accumulated_distance = dist(rng);
+        n.m_heuristic_distance   = dist(rng);
+        open.push(&n);
+    }
+    CHECK(open.size() == 500);
+
+    // Lower some keys while queued, the way a cheaper route does
+    for (size_t i = 0; i < nodes.size(); i += 3)
+    {
+        CHECK(open.contains(&nodes[i]));
+        nodes[i].m_accumulated_distance *= 0.25f;
+        open.decrease_key(&nodes[i]);
+    }
+
+    float last = -1.0f;
+    int   popped = 0;
+    while (ai::SearchNode* n = open.pop())
+    {
+        CHECK(f_score(n) >= last);
+        CHECK(!open.contains(n));
+        last = f_score(n);
+        ++popped;
+    }
+    CHECK(popped == 500);
+    CHECK(open.empty());
+}
+
+void test_ties_prefer_nodes_near_goal()
+{
+    ai::SearchNode far(0, 0, 120);
+    ai::SearchNode near(1, 0, 120);
+    far.m_accumulated_distance  = 2.0f;
+    far.m_heuristic_distance    = 8.0f;
+    near.m_accumulated_distance = 8.0f;
+    near.m_heuristic_distance   = 2.0f;
+
+    ai::OpenList open;
+    open.push(&far);
+    open.push(&near);
+    CHECK(open.pop() == &near);
+    CHECK(open.pop() == &far);
+    CHECK(open.pop() == nullptr);
+}
+
+void test_clear_resets_heap_indices()
+{
+    std::vector<ai::SearchNode> nodes(10, ai::SearchNode(0, 0, 120));
+    ai::OpenList open;
+    for (auto& n : nodes)
+        open.push(&n);
+    open.clear();
+
+    CHECK(open.empty());
+    for (auto const& n : nodes)
+        CHECK(!open.contains(&n));
+}
+
+void test_path_around_wall()
+{
+    // 20x20 nav cells with a wall across the middle, open at its right end
+    test::TestLevel level(1000, 1000, [](int const x, int const y)
+    {
+        return y >= 450 && y < 550 && x < 750;
+    });
+    ai::PathFinding paths(level.get_terrain());
+
+    paths.find_path(math::Vector2f({ 175.0f, 175.0f }), math::Vector2f({ 175.0f, 825.0f }));
+    for (int i = 0; i < 100 && !paths.get_found_goal(); ++i)
+        paths.find_path(math::Vector2f({ 175.0f, 175.0f }), math::Vector2f({ 175.0f, 825.0f }));
+    CHECK(paths.get_found_goal());
+
+    // Sealed off entirely, the search runs dry instead of finding a path
+    test::TestLevel sealed(1000, 1000, [](int const, int const y)
+    {
+        return y >= 450 && y < 550;
+    });
+    ai::PathFinding no_path(sealed.get_terrain());
+    for (int i = 0; i < 100; ++i)
+        no_path.find_path(math::Vector2f({ 175.0f, 175.0f }), math::Vector2f({ 175.0f, 825.0f }));
+    CHECK(!no_path.get_found_goal());
+}
+
+} // namespace
+
+int main()
+{
+    test_pops_in_f_order();
+    test_ties_prefer_nodes_near_goal();
+    test_clear_resets_heap_indices();
+    test_path_around_wall();
+    return test::finish("open_list_test");
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_level.hpp"
+#include "../src/ai/open_list.hpp"
+#include "../src/ai/path_finding.hpp"
+
+// A* expansions per second on the full 120x80 navigation grid, with the
+// indexed heap against the linear-scan list the path finder used before,
+// and whole PathFinding searches per second on the same level.
+
+namespace {
+
+int const GRID_WIDTH  = 120;
+int const GRID_HEIGHT = 80;
+int const CELL        = entities::LevelTerrain::NAV_CELL_SIZE;
+
+// Membership and the cheapest node are both found by scanning
+class LinearOpenList
+{
+private:
+    std::vector<ai::SearchNode*> m_nodes;
+
+public:
+    LinearOpenList() : m_nodes() { }
+
+    bool empty() const { return m_nodes.empty(); }
+    void clear()       { m_nodes.clear(); }
+    void push(ai::SearchNode* n) { m_nodes.push_back(n); }
+    void decrease_key(ai::SearchNode*) { }
+
+    bool contains(ai::SearchNode const* n) const
+    {
+        return std::find(m_nodes.begin(), m_nodes.end(), n) != m_nodes.end();
+    }
+
+    ai::SearchNode* pop()
+    {
+        auto best = std::min_element(m_nodes.begin(), m_nodes.end(),
+                                     [](ai::SearchNode const* a, ai::SearchNode const* b)
+        {
+            return a->m_accumulated_distance + a->m_heuristic_distance
+                 < b->m_accumulated_distance + b->m_heuristic_distance;
+        });
+        ai::SearchNode* n = *best;
+        m_nodes.erase(best);
+        return n;
+    }
+};
+
+template<class List>
+long search(entities::LevelTerrain const& terrain, std::vector<ai::SearchNode>& nodes, List& open,
+            int const start, int const goal)
+{
+    for (auto& n : nodes)
+    {
+        n.m_visited    = false;
+        n.m_heap_index = -1;
+    }
+    open.clear();
+
+    ai::SearchNode* const goal_node = &nodes[goal];
+    nodes[start].m_accumulated_distance = 0.0f;
+    nodes[start].m_heuristic_distance   = nodes[start].calculate_heuristic_distance(goal_node);
+    open.push(&nodes[start]);
+
+    long expansions = 0;
+    while (!open.empty())
+    {
+        ai::SearchNode* const current = open.pop();
+        current->m_visited = true;
+        ++expansions;
+        if (current == goal_node)
+            break;
+
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dx = -1; dx <= 1; ++dx)
+            {
+                int const x = current->m_x + dx;
+                int const y = current->m_y + dy;
+                if ((dx == 0 && dy == 0) || terrain.is_nav_cell_blocked(x, y))
+                    continue;
+
+                ai::SearchNode* const next = &nodes[y * GRID_WIDTH + x];
+                if (next->m_visited)
+                    continue;
+
+                float const cost = current->m_accumulated_distance + (dx != 0 && dy != 0 ? 1.4141f : 1.0f);
+                if (open.contains(next))
+                {
+                    if (cost >= next->m_accumulated_distance)
+                        continue;
+                    next->m_accumulated_distance = cost;
+                    open.decrease_key(next);
+                    continue;
+                }
+                next->m_accumulated_distance = cost;
+                next->m_heuristic_distance   = next->calculate_heuristic_distance(goal_node);
+                open.push(next);
+            }
+    }
+    return expansions;
+}
+
+template<class List>
+void run(char const* const name, entities::LevelTerrain const& terrain,
+         std::vector<std::pair<int, int>> const& queries)
+{
+    std::vector<ai::SearchNode> nodes;
+    for (int y = 0; y < GRID_HEIGHT; ++y)
+        for (int x = 0; x < GRID_WIDTH; ++x)
+            nodes.emplace_back(x, y, GRID_WIDTH);
+
+    List open;
+    long expansions = 0;
+    auto const start = std::chrono::steady_clock::now();
+    for (auto const& q : queries)
+        expansions += search(terrain, nodes, open, q.first, q.second);
+    std::chrono::duration<double> const secs = std::chrono::steady_clock::now() - start;
+
+    std::printf("  %-14s %8ld expansions  %10.0f expansions/s\n",
+                name, expansions, static_cast<double>(expansions) / secs.count());
+}
+
+} // namespace
+
+int main()
+{
+    // Pillars every 600 px leave corridors for the searches to wind through
+    test::TestLevel level(GRID_WIDTH * CELL, GRID_HEIGHT * CELL, [](int const x, int const y)
+    {
+        return x % 600 >= 300 && x % 600 < 400 && y % 800 >= 100 && y % 800 < 600;
+    });
+    entities::LevelTerrain& terrain = level.get_terrain();
+
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> cell_x(1, GRID_WIDTH - 2);
+    std::uniform_int_distribution<int> cell_y(1, GRID_HEIGHT - 2);
+    auto const random_free_cell = [&]()
+    {
+        for (;;)
+        {
+            int const x = cell_x(rng);
+            int const y = cell_y(rng);
+            if (!terrain.is_nav_cell_blocked(x, y))
+                return y * GRID_WIDTH + x;
+        }
+    };
+
+    std::vector<std::pair<int, int>> queries;
+    for (int i = 0; i < 50; ++i)
+        queries.emplace_back(random_free_cell(), random_free_cell());
+
+    std::printf("path_finding_bench: %zu searches on a %dx%d grid\n", queries.size(), GRID_WIDTH, GRID_HEIGHT);
+    run<ai::OpenList>  ("indexed heap", terrain, queries);
+    run<LinearOpenList>("linear scan",  terrain, queries);
+
+    // The path finder itself, restarted for every query
+    ai::PathFinding paths(terrain);
+    int found = 0;
+    auto const start = std::chrono::steady_clock::now();
+    for (auto const& q : queries)
+    {
+        math::Vector2f const from({ static_cast<float>(q.first  % GRID_WIDTH * CELL + CELL / 2),
+                                    static_cast<float>(q.first  / GRID_WIDTH * CELL + CELL / 2) });
+        math::Vector2f const to  ({ static_cast<float>(q.second % GRID_WIDTH * CELL + CELL / 2),
+                                    static_cast<float>(q.second / GRID_WIDTH * CELL + CELL / 2) });
+        paths.set_initialized_start_goal(false);
+        paths.set_found_goal(false);
+        for (int i = 0; i < 100 && !paths.get_found_goal(); ++i)
+            paths.find_path(from, to);
+        found += paths.get_found_goal() ? 1 : 0;
+    }
+    std::chrono::duration<double, std::micro> const us = std::chrono::steady_clock::now() - start;
+    std::printf("  PathFinding    %d/%zu found  %10.1f us/search\n",
+                found, queries.size(), us.count() / static_cast<double>(queries.size()));
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "../src/network/utilities/udp_packet.hpp"
+#include "../src/utilities/ring_buffer.hpp"
+
+// Items per second through RingBuffer against the mutex and condition
+// variable queue the sockets used before, with one and with several
+// producer threads feeding a single consumer.
+
+namespace {
+
+// The AsyncQueue the sockets used before RingBuffer replaced it
+template<class T>
+class AsyncQueue final
+{
+private:
+    std::queue<T>           m_queue;
+    mutable std::mutex      m_mutex;
+    std::condition_variable m_cond_var;
+
+public:
+    AsyncQueue() : m_queue(), m_mutex(), m_cond_var() { }
+
+    void enqueue(T t)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push(std::move(t));
+        m_cond_var.notify_one();
+    }
+
+    T dequeue()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (m_queue.empty())
+            m_cond_var.wait(lock);
+        T val = std::move(m_queue.front());
+        m_queue.pop();
+        return val;
+    }
+};
+
+template<class T, class Produce, class Consume>
+double run(int const producers, int const per_producer, Produce const& produce, Consume const& consume)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&]()
+        {
+            T const item = T();
+            for (int i = 0; i < per_producer; ++i)
+                produce(item);
+        });
+    consume(producers * per_producer);
+    for (auto& t : threads)
+        t.join();
+
+    std::chrono::duration<double> const secs = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(producers * per_producer) / secs.count();
+}
+
+template<class T>
+void compare(char const* const name, int const producers, int const per_producer)
+{
+    AsyncQueue<T> async;
+    double const async_rate = run<T>(producers, per_producer,
+        [&](T const& item) { async.enqueue(item); },
+        [&](int const total)
+        {
+            for (int i = 0; i < total; ++i)
+                async.dequeue();
+        });
+
+    utilities::RingBuffer<T> ring(1024);
+    double const ring_rate = run<T>(producers, per_producer,
+        [&](T const& item)
+        {
+            while (!ring.try_enqueue(item))
+                std::this_thread::yield();
+        },
+        [&](int const total)
+        {
+            std::vector<T> batch(64);
+            for (int got = 0; got < total; )
+            {
+                std::size_t const n = ring.try_dequeue_bulk(batch.data(), batch.size());
+                if (n == 0)
+                    std::this_thread::yield();
+                got += static_cast<int>(n);
+            }
+        });
+
+    std::printf("  %-10s %d producer(s)  AsyncQueue %10.0f items/s  RingBuffer %10.0f items/s  x%.1f\n",
+                name, producers, async_rate, ring_rate, ring_rate / async_rate);
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("ring_buffer_bench\n");
+    compare<std::uint64_t>     ("uint64",    1, 2000000);
+    compare<std::uint64_t>     ("uint64",    4, 500000);
+    compare<network::UdpPacket>("UdpPacket", 1, 500000);
+    compare<network::UdpPacket>("UdpPacket", 4, 125000);
+    return 0;
+}
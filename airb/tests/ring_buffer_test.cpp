@@ -0,0 +1,170 @@
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+#include "../src/utilities/ring_buffer.hpp"
+
+namespace {
+
+void test_capacity_rounds_up()
+{
+    CHECK(utilities::RingBuffer<int>(1).get_capacity()    == 2);
+    CHECK(utilities::RingBuffer<int>(3).get_capacity()    == 4);
+    CHECK(utilities::RingBuffer<int>(1000).get_capacity() == 1024);
+    CHECK(utilities::RingBuffer<int>(1024).get_capacity() == 1024);
+}
+
+void test_empty_and_full()
+{
+    utilities::RingBuffer<std::string> queue(4);
+    CHECK(queue.empty());
+
+    // An empty queue leaves the item alone
+    std::string item = "untouched";
+    CHECK(!queue.try_dequeue(item));
+    CHECK(item == "untouched");
+    CHECK(queue.try_dequeue_bulk(&item, 8) == 0);
+
+    for (int i = 0; i < 4; ++i)
+        CHECK(queue.try_enqueue(std::to_string(i)));
+    CHECK(!queue.empty());
+
+    // A full queue refuses without moving from the item
+    std::string extra = "extra";
+    CHECK(!queue.try_enqueue(std::move(extra)));
+    CHECK(extra == "extra");
+    CHECK(!queue.try_enqueue(extra));
+
+    // One slot handed back makes room for exactly one more
+    CHECK(queue.try_dequeue(item) && item == "0");
+    CHECK(queue.try_enqueue(std::move(extra)));
+    CHECK(!queue.try_enqueue(std::string("more")));
+
+    std::string out[8];
+    CHECK(queue.try_dequeue_bulk(out, 0) == 0);
+    CHECK(queue.try_dequeue_bulk(out, 8) == 4);
+    CHECK(out[0] == "1" && out[1] == "2" && out[2] == "3" && out[3] == "extra");
+    CHECK(queue.empty());
+}
+
+void test_fifo_over_many_laps()
+{
+    // Partial fills and drains so head and tail wrap at different points
+    utilities::RingBuffer<int> queue(8);
+    int next_in  = 0;
+    int next_out = 0;
+    bool in_order = true;
+    for (int round = 0; round < 1000; ++round)
+    {
+        int const fill = round % 9;
+        for (int i = 0; i < fill; ++i)
+            if (queue.try_enqueue(next_in))
+                ++next_in;
+
+        int out[8];
+        std::size_t const n = queue.try_dequeue_bulk(out, static_cast<std::size_t>(round % 5 + 1));
+        for (std::size_t i = 0; i < n; ++i)
+            in_order = in_order && out[i] == next_out++;
+    }
+    int v;
+    while (queue.try_dequeue(v))
+        in_order = in_order && v == next_out++;
+
+    CHECK(in_order);
+    CHECK(next_out == next_in);
+    CHECK(queue.empty());
+}
+
+void test_smallest_ring()
+{
+    // Asking for one slot still refuses the second unread item instead
+    // of overwriting the first
+    utilities::RingBuffer<int> queue(1);
+    for (int i = 0; i < 100; ++i)
+    {
+        CHECK(queue.try_enqueue(i));
+        CHECK(queue.try_enqueue(i + 1000));
+        CHECK(!queue.try_enqueue(-1));
+        int v = -1;
+        CHECK(queue.try_dequeue(v) && v == i);
+        CHECK(queue.try_dequeue(v) && v == i + 1000);
+        CHECK(queue.empty());
+    }
+}
+
+void test_move_only_items()
+{
+    utilities::RingBuffer<std::unique_ptr<int>> queue(2);
+    CHECK(queue.try_enqueue(std::unique_ptr<int>(new int(7))));
+
+    std::unique_ptr<int> out;
+    CHECK(queue.try_dequeue(out) && out && *out == 7);
+}
+
+void test_many_producers_one_consumer()
+{
+    int const producers = 4;
+    int const per_producer = 200000;
+    utilities::RingBuffer<std::uint64_t> queue(1024);
+
+    // Producers retry when the ring is full, the way a busy listener would
+    // see its datagrams back up
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+        threads.emplace_back([&queue, p, per_producer]()
+        {
+            for (std::uint64_t i = 0; i < static_cast<std::uint64_t>(per_producer); ++i)
+                while (!queue.try_enqueue(static_cast<std::uint64_t>(p) << 32 | i))
+                    std::this_thread::yield();
+        });
+
+    std::vector<char>          seen(static_cast<size_t>(producers * per_producer), 0);
+    std::vector<std::uint64_t> next(producers, 0);
+    bool exactly_once = true;
+    bool in_order     = true;
+    int  received     = 0;
+
+    std::uint64_t batch[64];
+    while (received < producers * per_producer)
+    {
+        std::size_t const n = queue.try_dequeue_bulk(batch, 64);
+        if (n == 0)
+            std::this_thread::yield();
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            int const           p = static_cast<int>(batch[i] >> 32);
+            std::uint64_t const v = batch[i] & 0xffffffffu;
+            char& s = seen[static_cast<size_t>(p) * per_producer + v];
+
+            exactly_once = exactly_once && s == 0;
+            s = 1;
+            // Each producer's items come out in the order it put them in
+            in_order = in_order && v == next[static_cast<size_t>(p)]++;
+        }
+        received += static_cast<int>(n);
+    }
+    for (auto& t : threads)
+        t.join();
+
+    CHECK(exactly_once);
+    CHECK(in_order);
+    CHECK(received == producers * per_producer);
+    CHECK(queue.empty());
+}
+
+} // namespace
+
+int main()
+{
+    test_capacity_rounds_up();
+    test_empty_and_full();
+    test_fifo_over_many_laps();
+    test_smallest_ring();
+    test_move_only_items();
+    test_many_producers_one_consumer();
+    return test::finish("ring_buffer_test");
+}
@@ -0,0 +1,128 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "../src/network/utilities/snapshot.hpp"
+
+// Size and cost of the snapshots the servers send every SYNC_FREQUENCY_MS:
+// a full room of planes flying about, one of them parked, encoded in full
+// and as a delta against the snapshot sent before, and decoded again.
+
+namespace {
+
+int const   NUM_SYNCS  = 1000;
+long const  ITERATIONS = 1000000;
+float const SYNC_SEC   = static_cast<float>(network::SYNC_FREQUENCY_MS) * 0.001f;
+
+volatile int g_sink;
+
+void report(char const* const name, double const ns)
+{
+    std::printf("  %-22s %8.1f ns/op  %10.0f ops/s\n", name, ns, 1e9 / ns);
+}
+
+// One snapshot per sync. The last plane sits still; the others fly on
+// with a slow turn, as planes in a dogfight would between two syncs.
+std::vector<network::Snapshot> make_syncs()
+{
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> x(500.0f, 5500.0f);
+    std::uniform_real_distribution<float> y(500.0f, 3500.0f);
+    std::uniform_real_distribution<float> turn(-1.5f, 1.5f);
+
+    network::PlaneState planes[network::Snapshot::MAX_PLANES];
+    for (int p = 0; p < network::Snapshot::MAX_PLANES; ++p)
+    {
+        planes[p].public_id       = static_cast<network::U8>(p + 1);
+        planes[p].position        = math::Vector2f({ x(rng), y(rng) });
+        planes[p].rotation        = 0.0f;
+        planes[p].velocity        = math::Vector2f::zero();
+        planes[p].cursor_position = math::Vector2f({ x(rng), y(rng) });
+    }
+
+    std::vector<network::Snapshot> syncs;
+    for (int s = 0; s < NUM_SYNCS; ++s)
+    {
+        network::Snapshot snapshot(static_cast<unsigned short>(s));
+        for (int p = 0; p < network::Snapshot::MAX_PLANES; ++p)
+        {
+            network::PlaneState& plane = planes[p];
+            if (p + 1 < network::Snapshot::MAX_PLANES)
+            {
+                plane.rotation += turn(rng) * SYNC_SEC;
+                plane.velocity  = math::Vector2f({ std::cos(plane.rotation), std::sin(plane.rotation) }) * 600.0f;
+                plane.position += plane.velocity * SYNC_SEC;
+                plane.cursor_position += plane.velocity * SYNC_SEC;
+            }
+            snapshot.add_plane(plane);
+        }
+        syncs.push_back(snapshot);
+    }
+    return syncs;
+}
+
+} // namespace
+
+int main()
+{
+    std::vector<network::Snapshot> const syncs = make_syncs();
+    char buffer[network::Snapshot::MAX_SIZE];
+
+    long full_bytes   = 0;
+    long delta_bytes  = 0;
+    long packet_bytes = 0;
+    for (size_t s = 1; s < syncs.size(); ++s)
+    {
+        full_bytes   += syncs[s].encode(buffer, nullptr);
+        delta_bytes  += syncs[s].encode(buffer, &syncs[s - 1]);
+        packet_bytes += syncs[s].to_packet(&syncs[s - 1]).get_size();
+    }
+    double const n = static_cast<double>(syncs.size() - 1);
+    double const syncs_per_sec = 1000.0 / network::SYNC_FREQUENCY_MS;
+
+    std::printf("snapshot_bench: %d planes, a snapshot every %d ms\n",
+                network::Snapshot::MAX_PLANES, network::SYNC_FREQUENCY_MS);
+    std::printf("  %-22s %8.1f B/tick   %10.0f B/s per client\n",
+                "full", static_cast<double>(full_bytes) / n, static_cast<double>(full_bytes) / n * syncs_per_sec);
+    std::printf("  %-22s %8.1f B/tick   %10.0f B/s per client\n",
+                "delta", static_cast<double>(delta_bytes) / n, static_cast<double>(delta_bytes) / n * syncs_per_sec);
+    std::printf("  %-22s %8.1f B/tick   %10.0f B/s per client\n",
+                "delta datagram", static_cast<double>(packet_bytes) / n, static_cast<double>(packet_bytes) / n * syncs_per_sec);
+
+    network::Snapshot const& base = syncs[syncs.size() - 2];
+    network::Snapshot const& next = syncs.back();
+
+    report("encode full", test::time_ns(ITERATIONS, [&]()
+    {
+        g_sink = next.encode(buffer, nullptr);
+    }));
+    report("encode delta", test::time_ns(ITERATIONS, [&]()
+    {
+        g_sink = next.encode(buffer, &base);
+    }));
+    report("to_packet delta", test::time_ns(ITERATIONS, [&]()
+    {
+        g_sink = next.to_packet(&base).get_size();
+    }));
+
+    network::SnapshotBuffer history;
+    history.store(base);
+    int const full_size  = next.encode(buffer, nullptr);
+    std::vector<char> const full(buffer, buffer + full_size);
+    int const delta_size = next.encode(buffer, &base);
+    std::vector<char> const delta(buffer, buffer + delta_size);
+
+    report("decode full", test::time_ns(ITERATIONS, [&]()
+    {
+        network::Snapshot out;
+        g_sink = out.decode(full.data(), full_size, history);
+    }));
+    report("decode delta", test::time_ns(ITERATIONS, [&]()
+    {
+        network::Snapshot out;
+        g_sink = out.decode(delta.data(), delta_size, history);
+    }));
+    return 0;
+}
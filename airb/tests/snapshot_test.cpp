@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "test.hpp"
+#include "../src/network/utilities/snapshot.hpp"
+
+namespace {
+
+float const WORLD_WIDTH  = 6000.0f;
+float const WORLD_HEIGHT = 4000.0f;
+float const TWO_PI       = 6.28318530718f;
+
+network::PlaneState make_plane(network::U8 const id, float const x, float const y, float const rot,
+                               float const vx, float const vy)
+{
+    network::PlaneState s;
+    s.public_id       = id;
+    s.position        = math::Vector2f({ x, y });
+    s.rotation        = rot;
+    s.velocity        = math::Vector2f({ vx, vy });
+    s.cursor_position = math::Vector2f({ WORLD_WIDTH - x, WORLD_HEIGHT - y });
+    return s;
+}
+
+bool same_plane(network::PlaneState const& a, network::PlaneState const& b)
+{
+    return a.public_id == b.public_id
+        && a.position[X] == b.position[X] && a.position[Y] == b.position[Y]
+        && a.rotation == b.rotation
+        && a.velocity[X] == b.velocity[X] && a.velocity[Y] == b.velocity[Y]
+        && a.cursor_position[X] == b.cursor_position[X]
+        && a.cursor_position[Y] == b.cursor_position[Y];
+}
+
+// Smallest difference between two angles, in radians
+float angle_error(float const a, float const b)
+{
+    float const d = std::fmod(std::fabs(a - b), TWO_PI);
+    return std::min(d, TWO_PI - d);
+}
+
+network::Snapshot round_trip(network::Snapshot const& s, network::Snapshot const* baseline,
+                             network::SnapshotBuffer const& history, int* size = nullptr)
+{
+    char buffer[network::Snapshot::MAX_SIZE];
+    int const n = s.encode(buffer, baseline);
+    if (size)
+        *size = n;
+
+    network::Snapshot out;
+    CHECK(out.decode(buffer, n, history));
+    return out;
+}
+
+void test_full_snapshot_within_quantisation()
+{
+    std::mt19937 rng(8);
+    std::uniform_real_distribution<float> x(0.0f, WORLD_WIDTH);
+    std::uniform_real_distribution<float> y(0.0f, WORLD_HEIGHT);
+    std::uniform_real_distribution<float> rot(-10.0f, 10.0f);
+    std::uniform_real_distribution<float> vel(-2000.0f, 2000.0f);
+    network::SnapshotBuffer const none;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        network::Snapshot s(static_cast<unsigned short>(i));
+        network::PlaneState in[network::Snapshot::MAX_PLANES];
+        for (int p = 0; p < network::Snapshot::MAX_PLANES; ++p)
+        {
+            in[p] = make_plane(static_cast<network::U8>(p * 3 + 1), x(rng), y(rng), rot(rng), vel(rng), vel(rng));
+            CHECK(s.add_plane(in[p]));
+        }
+        CHECK(!s.add_plane(in[0]));
+
+        network::Snapshot const out = round_trip(s, nullptr, none);
+        CHECK(out.get_sequence() == i);
+        CHECK(out.get_num_planes() == network::Snapshot::MAX_PLANES);
+        for (int p = 0; p < network::Snapshot::MAX_PLANES; ++p)
+        {
+            network::PlaneState const o = out.get_plane(p);
+            CHECK(o.public_id == in[p].public_id);
+            CHECK(std::fabs(o.position[X] - in[p].position[X]) <= WORLD_WIDTH  / 65535.0f);
+            CHECK(std::fabs(o.position[Y] - in[p].position[Y]) <= WORLD_HEIGHT / 65535.0f);
+            CHECK(std::fabs(o.cursor_position[X] - in[p].cursor_position[X]) <= WORLD_WIDTH  / 65535.0f);
+            CHECK(std::fabs(o.cursor_position[Y] - in[p].cursor_position[Y]) <= WORLD_HEIGHT / 65535.0f);
+            CHECK(angle_error(o.rotation, in[p].rotation) <= TWO_PI / 512.0f + 1e-4f);
+            CHECK(std::fabs(o.velocity[X] - in[p].velocity[X]) <= 0.125f);
+            CHECK(std::fabs(o.velocity[Y] - in[p].velocity[Y]) <= 0.125f);
+        }
+    }
+}
+
+void test_quantisation_bounds()
+{
+    network::SnapshotBuffer const none;
+    network::Snapshot s(1);
+    s.add_plane(make_plane(1, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+    s.add_plane(make_plane(2, WORLD_WIDTH, WORLD_HEIGHT, TWO_PI - 0.001f, 8191.75f, -8192.0f));
+    // Off the level, past the velocity range and several turns round
+    s.add_plane(make_plane(3, -50.0f, 1e6f, -TWO_PI * 3.0f - 0.5f, 1e6f, -1e6f));
+    s.add_plane(make_plane(4, 1e6f, -1.0f, TWO_PI * 7.0f + 0.5f, -0.1f, 0.1f));
+
+    network::Snapshot const out = round_trip(s, nullptr, none);
+    network::PlaneState const edge_lo = out.get_plane(0);
+    network::PlaneState const edge_hi = out.get_plane(1);
+    network::PlaneState const wild_a  = out.get_plane(2);
+    network::PlaneState const wild_b  = out.get_plane(3);
+
+    // The ends of the range are exact
+    CHECK(edge_lo.position[X] == 0.0f && edge_lo.position[Y] == 0.0f);
+    CHECK(edge_hi.position[X] == WORLD_WIDTH && edge_hi.position[Y] == WORLD_HEIGHT);
+    CHECK(edge_hi.velocity[X] == 8191.75f && edge_hi.velocity[Y] == -8192.0f);
+
+    // Just short of a full turn rounds to zero instead of overflowing
+    CHECK(edge_hi.rotation == 0.0f);
+
+    // Positions clamp to the level, velocities saturate
+    CHECK(wild_a.position[X] == 0.0f && wild_a.position[Y] == WORLD_HEIGHT);
+    CHECK(wild_b.position[X] == WORLD_WIDTH && wild_b.position[Y] == 0.0f);
+    CHECK(wild_a.velocity[X] == 8191.75f && wild_a.velocity[Y] == -8192.0f);
+    CHECK(wild_b.velocity[X] == 0.0f && wild_b.velocity[Y] == 0.0f);
+
+    // Angles come back in [0, 2pi) whatever turn they were given in
+    CHECK(angle_error(wild_a.rotation, -0.5f) <= TWO_PI / 512.0f + 1e-4f);
+    CHECK(angle_error(wild_b.rotation,  0.5f) <= TWO_PI / 512.0f + 1e-4f);
+    CHECK(wild_a.rotation >= 0.0f && wild_a.rotation < TWO_PI);
+    CHECK(wild_b.rotation >= 0.0f && wild_b.rotation < TWO_PI);
+}
+
+void test_delta_against_baseline()
+{
+    network::SnapshotBuffer sent;
+    network::SnapshotBuffer received;
+
+    network::Snapshot base(100);
+    base.add_plane(make_plane(1, 100.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    base.add_plane(make_plane(2, 900.0f, 800.0f, 2.0f, 0.0f, -10.0f));
+    base.add_plane(make_plane(3, 3000.0f, 1500.0f, 3.0f, 5.0f, 5.0f));
+    sent.store(base);
+    received.store(round_trip(base, nullptr, received));
+
+    // Plane 1 unchanged, 2 moved along x only, 3 gone, 4 new
+    network::Snapshot next(101);
+    next.add_plane(make_plane(1, 100.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    network::PlaneState moved = make_plane(2, 900.0f, 800.0f, 2.0f, 0.0f, -10.0f);
+    moved.position[X] = 950.0f;
+    next.add_plane(moved);
+    next.add_plane(make_plane(4, 10.0f, 20.0f, 0.5f, 1.0f, 2.0f));
+
+    int full_size  = 0;
+    int delta_size = 0;
+    network::Snapshot const full  = round_trip(next, nullptr, received, &full_size);
+    network::Snapshot const delta = round_trip(next, sent.find(100), received, &delta_size);
+
+    CHECK(delta.get_num_planes() == 3);
+    for (int p = 0; p < 3; ++p)
+        CHECK(same_plane(delta.get_plane(p), full.get_plane(p)));
+
+    // Ids and bitmap, a mask and one field for plane 2, all of plane 4
+    int const header = network::Snapshot::HEADER_SIZE + 3 + 1;
+    CHECK(delta_size == header + (1 + 2) + (1 + 2 * 6 + 1));
+    CHECK(delta_size < full_size);
+
+    // Nothing changed: only ids and an empty bitmap go out
+    int same_size = 0;
+    network::Snapshot repeat(102);
+    repeat.add_plane(make_plane(1, 100.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    network::Snapshot const same = round_trip(repeat, sent.find(100), received, &same_size);
+    CHECK(same_size == network::Snapshot::HEADER_SIZE + 1 + 1);
+    CHECK(same_plane(same.get_plane(0), full.get_plane(0)));
+}
+
+void test_missing_baseline_and_truncation()
+{
+    network::SnapshotBuffer sent;
+    network::SnapshotBuffer received;
+
+    network::Snapshot base(7);
+    base.add_plane(make_plane(1, 100.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    base.add_plane(make_plane(2, 400.0f, 300.0f, 2.0f, 20.0f, 0.0f));
+    sent.store(base);
+
+    network::Snapshot next(8);
+    next.add_plane(make_plane(1, 100.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    next.add_plane(make_plane(2, 410.0f, 300.0f, 2.0f, 20.0f, 0.0f));
+
+    char buffer[network::Snapshot::MAX_SIZE];
+    int const size = next.encode(buffer, sent.find(7));
+
+    // The receiver never got snapshot 7
+    network::Snapshot out;
+    CHECK(!out.decode(buffer, size, received));
+
+    // Nor does a stale snapshot in the same slot stand in for it
+    received.store(network::Snapshot(7 + network::SnapshotBuffer::SIZE));
+    CHECK(!out.decode(buffer, size, received));
+
+    received.store(base);
+    CHECK(out.decode(buffer, size, received));
+
+    // Every cut of the datagram is refused rather than read past its end
+    for (int n = 0; n < size; ++n)
+    {
+        network::Snapshot cut;
+        CHECK(!cut.decode(buffer, n, received));
+    }
+
+    // A plane count beyond MAX_PLANES is refused
+    buffer[5] = static_cast<char>(network::Snapshot::MAX_PLANES + 1);
+    CHECK(!out.decode(buffer, size, received));
+}
+
+void test_sequence_wraparound()
+{
+    CHECK( network::sequence_newer(1, 0));
+    CHECK(!network::sequence_newer(0, 1));
+    CHECK(!network::sequence_newer(5, 5));
+    CHECK( network::sequence_newer(0, 65535));
+    CHECK( network::sequence_newer(3, 65533));
+    CHECK(!network::sequence_newer(65533, 3));
+
+    // Half the range apart is where newer flips
+    for (unsigned int a = 0; a < 65536; a += 4099)
+    {
+        unsigned short const b = static_cast<unsigned short>(a);
+        CHECK( network::sequence_newer(static_cast<unsigned short>(b + 32767), b));
+        CHECK(!network::sequence_newer(static_cast<unsigned short>(b + 32768), b));
+        CHECK( network::sequence_newer(b, static_cast<unsigned short>(b + 32769)));
+    }
+
+    // The history keeps working across the wrap
+    network::SnapshotBuffer history;
+    for (unsigned int seq = 65520; seq < 65536 + 16; ++seq)
+        history.store(network::Snapshot(static_cast<unsigned short>(seq)));
+    for (unsigned int seq = 65520; seq < 65536 + 16; ++seq)
+    {
+        network::Snapshot const* s = history.find(static_cast<unsigned short>(seq));
+        CHECK(s != nullptr && s->get_sequence() == static_cast<unsigned short>(seq));
+    }
+    CHECK(history.find(65519) == nullptr);
+
+    // A delta against a baseline from before the wrap decodes after it
+    network::Snapshot base(65535);
+    base.add_plane(make_plane(1, 100.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    history.store(base);
+    network::Snapshot next(0);
+    next.add_plane(make_plane(1, 150.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    network::Snapshot const out = round_trip(next, &base, history);
+    CHECK(out.get_sequence() == 0);
+    CHECK(std::fabs(out.get_plane(0).position[X] - 150.0f) <= WORLD_WIDTH / 65535.0f);
+}
+
+void test_input_ack_and_packets()
+{
+    network::SnapshotBuffer history;
+    network::Snapshot base(40);
+    base.add_plane(make_plane(1, 100.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    history.store(base);
+
+    // The ack rides along even when the planes are all elided
+    network::Snapshot next(41);
+    next.add_plane(make_plane(1, 100.0f, 200.0f, 1.0f, 10.0f, 0.0f));
+    next.set_input_ack(network::InputAck { 250, 1234 });
+
+    int size = 0;
+    network::Snapshot const out = round_trip(next, &base, history, &size);
+    network::InputAck ack { 0, 0 };
+    CHECK(out.get_input_ack(ack));
+    CHECK(ack.sequence == 250 && ack.ticks == 1234);
+    CHECK(size == network::Snapshot::HEADER_SIZE + network::Snapshot::INPUT_ACK_SIZE + 1 + 1);
+
+    network::InputAck untouched { 9, 9 };
+    CHECK(!round_trip(base, nullptr, history).get_input_ack(untouched));
+    CHECK(untouched.sequence == 9 && untouched.ticks == 9);
+
+    // Through a packet, and the ack the client sends back
+    network::UdpPacket const packet = next.to_packet(&base);
+    network::Snapshot from_wire;
+    CHECK(from_wire.from_packet(packet, history));
+    CHECK(same_plane(from_wire.get_plane(0), out.get_plane(0)));
+
+    network::UdpPacket const reply = network::Snapshot::make_ack(41, 3);
+    unsigned short seq = 0;
+    CHECK(network::Snapshot::read_ack(reply, seq) && seq == 41);
+    CHECK(!network::Snapshot::read_ack(packet, seq));
+    CHECK(!from_wire.from_packet(reply, history));
+}
+
+} // namespace
+
+int main()
+{
+    test_full_snapshot_within_quantisation();
+    test_quantisation_bounds();
+    test_delta_against_baseline();
+    test_missing_baseline_and_truncation();
+    test_sequence_wraparound();
+    test_input_ack_and_packets();
+    return test::finish("snapshot_test");
+}
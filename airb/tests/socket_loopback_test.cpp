@@ -0,0 +1,113 @@
+#include <chrono>
+#include <memory>
+#include <thread>
+
+#include "test.hpp"
+#include "../src/network/connection.hpp"
+#include "../src/network/socket/client_socket.hpp"
+#include "../src/network/socket/server_socket.hpp"
+
+// The server and client sockets talking over 127.0.0.1 with their
+// listener threads running, the way the game drives them.
+
+namespace {
+
+unsigned short const TEST_PORT = network::SERVER_DEFAULT_PORT + 7;
+
+// Polls cond until it holds or two seconds have passed
+template<class Cond>
+bool wait_for(Cond const& cond)
+{
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!cond())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void test_connect_keepalive_and_drop()
+{
+    network::ServerSocket server(TEST_PORT);
+    network::ClientSocket client("127.0.0.1", TEST_PORT);
+    std::thread server_listener(&network::ServerSocket::start_listener_routine, &server);
+    std::thread client_listener(&network::ClientSocket::start_listener_routine, &client);
+
+    // Connect request reaches the server's queue with the client's address
+    client.init_connect();
+    CHECK(wait_for([&]() { return server.has_packets(); }));
+    auto const request = server.get_packet();
+    CHECK(request.first.header_contains(network::UDP_H_CONNECT));
+    CHECK(request.first.get_token() == network::NO_SESSION);
+    CHECK(request.second.sin_addr.s_addr == htonl(INADDR_LOOPBACK));
+
+    // The welcome carries the session token the client stamps from now on
+    auto const conn = std::make_shared<network::Connection>(request.second);
+    server.add_client(conn);
+    network::UdpPacket welcome(network::UDP_H_CONNECT | network::UDP_H_OK | network::UDP_H_POS,
+                               conn->get_public_id());
+    welcome.set_token(conn->get_token());
+    server.send(welcome, request.second);
+    CHECK(wait_for([&]() { return client.get_token() == conn->get_token(); }));
+    CHECK(wait_for([&]() { return client.has_packets(); }));
+    CHECK(client.get_packet().header_contains(network::UDP_H_OK));
+
+    // Keepalives are answered on the listener thread and never queued
+    conn->consecutive_pings_missed = 3;
+    client.send(network::UdpPacket(network::UDP_H_KEEPALIVE));
+    CHECK(wait_for([&]() { return conn->consecutive_pings_missed == 0; }));
+    CHECK(!server.has_packets());
+
+    // A burst of input all arrives, stamped and in order
+    int const burst = 100;
+    for (int i = 0; i < burst; ++i)
+        client.send(network::UdpPacket(network::UDP_H_INPUT | network::UDP_H_POS,
+                                       network::UDP_H_NULL, network::UDP_H_NULL,
+                                       static_cast<network::U8>(i)));
+    std::pair<network::UdpPacket, sockaddr_in> batch[burst];
+    int received = 0;
+    bool in_order = true;
+    wait_for([&]()
+    {
+        int const n = server.get_packets(batch, burst - received);
+        for (int i = 0; i < n; ++i)
+        {
+            in_order = in_order && batch[i].first.get_pos_byte() == received + i
+                                && batch[i].first.get_token() == conn->get_token();
+        }
+        received += n;
+        return received == burst;
+    });
+    CHECK(received == burst);
+    CHECK(in_order);
+
+    // Broadcasts reach every client, an excluded one gets nothing
+    server.broadcast(network::UdpPacket(network::UDP_H_POS, 42));
+    CHECK(wait_for([&]() { return client.has_packets(); }));
+    CHECK(client.get_packet().get_pos_byte() == 42);
+    server.broadcast(network::UdpPacket(network::UDP_H_POS, 43), conn->get_public_id());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(!client.has_packets());
+
+    // Once dropped, the connection is no longer found by its keepalives
+    server.drop_client(conn);
+    conn->consecutive_pings_missed = 3;
+    client.send(network::UdpPacket(network::UDP_H_KEEPALIVE));
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    CHECK(conn->consecutive_pings_missed == 3);
+
+    server.end_listener_routine();
+    client.end_listener_routine();
+    server_listener.join();
+    client_listener.join();
+}
+
+} // namespace
+
+int main()
+{
+    test_connect_keepalive_and_drop();
+    return test::finish("socket_loopback_test");
+}
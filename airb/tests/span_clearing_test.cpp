@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_level.hpp"
+#include "../src/entities/terrain_mask.hpp"
+
+// The SIMD alpha clearing and the tiled bit clearing against plain
+// per-pixel loops, on spans that start and end anywhere.
+
+namespace {
+
+int const GUARD = 16;
+
+void test_alpha_span_matches_scalar()
+{
+    std::mt19937 rng(4);
+    std::uniform_int_distribution<int> byte(0, 255);
+
+    // Offsets move the span off any 16/32 byte boundary the vector stores
+    // might otherwise happen to hit, the guard pixels catch overruns.
+    for (int offset = 0; offset < 9; ++offset)
+        for (int count = 0; count <= 70; ++count)
+        {
+            std::vector<GLubyte> simd(static_cast<size_t>(offset + count + GUARD) * 4);
+            for (auto& b : simd)
+                b = static_cast<GLubyte>(byte(rng));
+            std::vector<GLubyte> scalar(simd);
+
+            entities::LevelTerrain::clear_alpha_span       (&simd[static_cast<size_t>(offset) * 4],   count);
+            entities::LevelTerrain::clear_alpha_span_scalar(&scalar[static_cast<size_t>(offset) * 4], count);
+            CHECK(simd == scalar);
+        }
+}
+
+void test_mask_span_matches_pixels()
+{
+    // Not a whole number of tiles in either direction
+    int const width  = 37;
+    int const height = 19;
+    std::vector<GLubyte> rgba(static_cast<size_t>(width * height) * 4, 0xff);
+
+    for (int y = 0; y < height; ++y)
+        for (int start = 0; start < width; ++start)
+            for (int end = start; end <= width; ++end)
+            {
+                entities::TerrainMask mask(math::Vector2i({ width, height }), rgba.data(), 4);
+                mask.clear_span(y, start, end);
+
+                bool same = true;
+                for (int py = 0; py < height; ++py)
+                    for (int px = 0; px < width; ++px)
+                    {
+                        bool const cleared = py == y && px >= start && px < end;
+                        same = same && mask.is_solid(px, py) == !cleared;
+                    }
+                CHECK(same);
+            }
+}
+
+// The same midpoint circle LevelTerrain rasterises, one pixel at a time
+void clear_circle(std::vector<bool>& solid, int const width, int const height,
+                  int const cx, int const cy, int const r)
+{
+    auto const row = [&](int const y, int const x0, int const x1)
+    {
+        if (y < 0 || y >= height)
+            return;
+        for (int x = std::max(x0, 0); x < std::min(x1, width); ++x)
+            solid[static_cast<size_t>(y * width + x)] = false;
+    };
+
+    int x   = r;
+    int y   = 0;
+    int err = 0;
+    while (x >= y)
+    {
+        row(cy + y, cx - x, cx + x);
+        row(cy - y, cx - x, cx + x);
+        row(cy + x, cx - y, cx + y);
+        row(cy - x, cx - y, cx + y);
+
+        err += 1 + 2 * (++y);
+        if (2 * (err - x) + 1 > 0)
+            err += 1 - 2 * (--x);
+    }
+}
+
+void test_destroyed_circles_match_scalar()
+{
+    int const width  = 203;
+    int const height = 117;
+    test::TestLevel level(width, height, [](int const, int const) { return true; });
+    entities::LevelTerrain& terrain = level.get_terrain();
+    std::vector<bool> expected(static_cast<size_t>(width * height), true);
+
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> px(0, width - 1);
+    std::uniform_int_distribution<int> py(0, height - 1);
+    std::uniform_int_distribution<int> radius(1, 29);
+
+    // Centres on tile edges and terrain borders, then random ones that
+    // overlap, several per update so that their spans get merged.
+    std::vector<std::pair<math::Vector2i, int>> circles = {
+        { math::Vector2i({ 8, 8 }), 3 },     { math::Vector2i({ 15, 40 }), 7 },
+        { math::Vector2i({ 0, 0 }), 12 },    { math::Vector2i({ width - 1, height - 1 }), 9 },
+        { math::Vector2i({ 64, 0 }), 5 },    { math::Vector2i({ 0, 63 }), 4 },
+        { math::Vector2i({ 100, 56 }), 1 },  { math::Vector2i({ 101, 57 }), 2 },
+    };
+    for (int i = 0; i < 60; ++i)
+        circles.emplace_back(math::Vector2i({ px(rng), py(rng) }), radius(rng));
+
+    for (size_t i = 0; i < circles.size(); ++i)
+    {
+        auto const& c = circles[i];
+        terrain.destroy_circle(c.first, c.second);
+        clear_circle(expected, width, height, c.first[X], c.first[Y], c.second);
+        if (i % 4 == 3)
+            terrain.update();
+    }
+    terrain.update();
+
+    GLubyte const* const rgba = level.get_image_data();
+    bool same = true;
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+        {
+            GLubyte const* const p = &rgba[(y * width + x) * 4];
+            bool const solid = expected[static_cast<size_t>(y * width + x)];
+            same = same && (p[3] != 0) == solid
+                        && terrain.is_pixel_solid(math::Vector2i({ x, y })) == solid
+                        && p[0] == 0x40 && p[1] == 0x40 && p[2] == 0x40;
+        }
+    CHECK(same);
+}
+
+} // namespace
+
+int main()
+{
+    test_alpha_span_matches_scalar();
+    test_mask_span_matches_pixels();
+    test_destroyed_circles_match_scalar();
+    return test::finish("span_clearing_test");
+}
@@ -0,0 +1,81 @@
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_planes.hpp"
+#include "../src/physics/spatial_grid.hpp"
+
+// Projectile against plane hits per tick, the all-pairs loop the servers
+// ran before against the grid broad phase: 64 planes and 1,000 live
+// projectiles on a 6000x4000 level, a tenth of them sitting on a plane.
+
+namespace {
+
+int const NUM_PLANES      = 64;
+int const NUM_PROJECTILES = 1000;
+int const TICKS           = 2000;
+
+volatile int g_sink;
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<float> x(0.0f, 6000.0f);
+    std::uniform_real_distribution<float> y(0.0f, 4000.0f);
+    std::uniform_real_distribution<float> rot(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> near(-20.0f, 20.0f);
+
+    std::vector<physics::RigidBodyWithCollider> planes;
+    for (int i = 0; i < NUM_PLANES; ++i)
+        planes.push_back(test::make_plane_body(math::Vector2f({ x(rng), y(rng) }), rot(rng)));
+
+    std::vector<math::Vector2f> projectiles;
+    for (int i = 0; i < NUM_PROJECTILES; ++i)
+        projectiles.push_back(i % 10 == 0
+            ? planes[static_cast<size_t>(i) % planes.size()].get_position() + math::Vector2f({ near(rng), near(rng) })
+            : math::Vector2f({ x(rng), y(rng) }));
+
+    std::printf("spatial_grid_bench: %d planes, %d projectiles, %d ticks\n",
+                NUM_PLANES, NUM_PROJECTILES, TICKS);
+
+    long pairs = 0;
+    int  hits  = 0;
+    double const brute_ns = test::time_ns(TICKS, [&]()
+    {
+        pairs = 0;
+        hits  = 0;
+        for (auto const& pos : projectiles)
+            for (auto& plane : planes)
+            {
+                ++pairs;
+                hits += test::hits(plane, pos);
+            }
+        g_sink = hits;
+    });
+    std::printf("  all pairs  %7ld pairs/tick  %4d hits  %8.3f ms/tick\n", pairs, hits, brute_ns * 1e-6);
+
+    // Rebuilding the grid is part of every tick
+    physics::SpatialGrid grid(math::Vector2i({ 6000, 4000 }));
+    double const grid_ns = test::time_ns(TICKS, [&]()
+    {
+        grid.clear();
+        for (size_t i = 0; i < planes.size(); ++i)
+            grid.insert(static_cast<int>(i), planes[i]);
+
+        pairs = 0;
+        hits  = 0;
+        for (auto const& pos : projectiles)
+            for (int const i : grid.query(pos))
+            {
+                ++pairs;
+                hits += test::hits(planes[static_cast<size_t>(i)], pos);
+            }
+        g_sink = hits;
+    });
+    std::printf("  grid       %7ld pairs/tick  %4d hits  %8.3f ms/tick  x%.1f\n",
+                pairs, hits, grid_ns * 1e-6, brute_ns / grid_ns);
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_planes.hpp"
+#include "../src/physics/spatial_grid.hpp"
+
+namespace {
+
+float const WORLD_WIDTH  = 6000.0f;
+float const WORLD_HEIGHT = 4000.0f;
+
+std::vector<physics::RigidBodyWithCollider> scatter_planes(std::mt19937& rng, int const count)
+{
+    // Some planes hang over the level border, and projectiles below fly
+    // past it, so the clamped cells get used from both sides
+    std::uniform_real_distribution<float> x(-150.0f, WORLD_WIDTH + 150.0f);
+    std::uniform_real_distribution<float> y(-150.0f, WORLD_HEIGHT + 150.0f);
+    std::uniform_real_distribution<float> rot(0.0f, 6.2831853f);
+
+    std::vector<physics::RigidBodyWithCollider> planes;
+    for (int i = 0; i < count; ++i)
+        planes.push_back(test::make_plane_body(math::Vector2f({ x(rng), y(rng) }), rot(rng)));
+    return planes;
+}
+
+void test_matches_all_pairs()
+{
+    std::mt19937 rng(12);
+    std::uniform_real_distribution<float> x(-300.0f, WORLD_WIDTH + 300.0f);
+    std::uniform_real_distribution<float> y(-300.0f, WORLD_HEIGHT + 300.0f);
+    std::uniform_real_distribution<float> near(-110.0f, 110.0f);
+
+    physics::SpatialGrid grid(math::Vector2i({ static_cast<int>(WORLD_WIDTH),
+                                               static_cast<int>(WORLD_HEIGHT) }));
+    int total_hits = 0;
+    for (int tick = 0; tick < 20; ++tick)
+    {
+        // The plane count changes between ticks so clear() has to drop ids
+        // that are no longer there
+        auto planes = scatter_planes(rng, tick % 2 == 0 ? 64 : 9);
+        grid.clear();
+        for (size_t i = 0; i < planes.size(); ++i)
+            grid.insert(static_cast<int>(i), planes[i]);
+
+        bool same_hits = true;
+        bool in_range  = true;
+        bool ascending = true;
+        for (int p = 0; p < 2000; ++p)
+        {
+            // Every other projectile sits on or next to a plane
+            math::Vector2f pos({ x(rng), y(rng) });
+            if (p % 2 == 0)
+                pos = planes[static_cast<size_t>(p) % planes.size()].get_position()
+                    + math::Vector2f({ near(rng), near(rng) });
+
+            std::vector<int> brute;
+            for (size_t i = 0; i < planes.size(); ++i)
+                if (test::hits(planes[i], pos))
+                    brute.push_back(static_cast<int>(i));
+
+            // The grid keeps insertion order, so the narrow phase sees
+            // candidates in the order the all-pairs loop did
+            std::vector<int> grid_hits;
+            int last = -1;
+            for (int const i : grid.query(pos))
+            {
+                in_range  = in_range && i >= 0 && i < static_cast<int>(planes.size());
+                ascending = ascending && i > last;
+                last = i;
+                if (test::hits(planes[static_cast<size_t>(i)], pos))
+                    grid_hits.push_back(i);
+            }
+            same_hits = same_hits && grid_hits == brute;
+            total_hits += static_cast<int>(brute.size());
+        }
+        CHECK(same_hits);
+        CHECK(in_range);
+        CHECK(ascending);
+    }
+    // The placement above has to actually produce hits to mean anything
+    CHECK(total_hits > 1000);
+}
+
+void test_cells_and_bounds()
+{
+    physics::SpatialGrid grid(math::Vector2i({ 1000, 600 }));
+    float const cell = static_cast<float>(physics::SpatialGrid::CELL_SIZE);
+
+    // A box straddling a cell corner is in all four cells
+    grid.insert(3, math::Vector2f({ cell - 10.0f, cell - 10.0f }),
+                   math::Vector2f({ cell + 10.0f, cell + 10.0f }));
+    CHECK(grid.query(math::Vector2f({ cell - 5.0f, cell - 5.0f })).size() == 1);
+    CHECK(grid.query(math::Vector2f({ cell + 5.0f, cell - 5.0f })).size() == 1);
+    CHECK(grid.query(math::Vector2f({ cell - 5.0f, cell + 5.0f })).size() == 1);
+    CHECK(grid.query(math::Vector2f({ cell + 5.0f, cell + 5.0f })).size() == 1);
+    CHECK(grid.query(math::Vector2f({ 2.5f * cell, 0.5f * cell })).empty());
+
+    // A box past the level edge lands in the border cells, and points past
+    // the edge find it there
+    grid.insert(4, math::Vector2f({ 990.0f, -50.0f }), math::Vector2f({ 1200.0f, 20.0f }));
+    auto const& border = grid.query(math::Vector2f({ 999.0f, 0.0f }));
+    CHECK(border.size() == 1 && border[0] == 4);
+    CHECK(grid.query(math::Vector2f({ 1100.0f, -40.0f })) == border);
+    CHECK(grid.query(math::Vector2f({ 1e6f, -1e6f })) == border);
+
+    // Off the level elsewhere only the nearest border cell is looked at
+    CHECK(grid.query(math::Vector2f({ -1.0f, 2.5f * cell })).empty());
+    CHECK(grid.query(math::Vector2f({ 10.0f, 1e6f })).empty());
+    CHECK(grid.query(math::Vector2f({ 3.5f * cell, 1e6f })).empty());
+
+    grid.clear();
+    CHECK(grid.query(math::Vector2f({ cell + 5.0f, cell + 5.0f })).empty());
+    CHECK(grid.query(math::Vector2f({ 1100.0f, -40.0f })).empty());
+}
+
+} // namespace
+
+int main()
+{
+    test_matches_all_pairs();
+    test_cells_and_bounds();
+    return test::finish("spatial_grid_test");
+}
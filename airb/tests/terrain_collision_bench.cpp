@@ -0,0 +1,101 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_level.hpp"
+#include "test_planes.hpp"
+
+// Terrain collision of 64 planes at 700 px/s over a 3000x2000 level with
+// a floor and pillars: RigidBodyWithCollider::update, which runs
+// BoxCollider::check_terrain on both boxes, and correct_positions for
+// every other pair of planes. Planes respawn every 200 ticks so a share
+// of them keeps grazing terrain. Run with the distance field early-outs
+// and without them; the two runs have to end in the same state.
+
+namespace {
+
+int const   WIDTH       = 3000;
+int const   HEIGHT      = 2000;
+int const   NUM_PLANES  = 64;
+int const   TICKS       = 2000;
+int const   RESPAWN     = 200;
+float const PLANE_SPEED = 700.0f;
+
+std::chrono::milliseconds const DT(8);
+
+bool is_solid(int const x, int const y)
+{
+    return y >= 1800 || (x % 400 < 80 && y >= 1200);
+}
+
+struct Result
+{
+    double ns_per_plane_tick;
+    float  state;
+};
+
+Result run(entities::LevelTerrain& terrain)
+{
+    std::mt19937 rng(16);
+    std::uniform_real_distribution<float> x(100.0f, WIDTH - 100.0f);
+    std::uniform_real_distribution<float> y(100.0f, HEIGHT - 100.0f);
+    std::uniform_real_distribution<float> rot(0.0f, 6.2831853f);
+
+    std::vector<physics::RigidBodyWithCollider> planes;
+    for (int i = 0; i < NUM_PLANES; ++i)
+    {
+        planes.push_back(test::make_plane_body(math::Vector2f::zero(), 0.0f));
+        planes.back().set_max_speed(50000.0f);
+    }
+
+    auto const start = std::chrono::steady_clock::now();
+    for (int t = 0; t < TICKS; ++t)
+    {
+        if (t % RESPAWN == 0)
+            for (auto& plane : planes)
+            {
+                float const r = rot(rng);
+                plane.set_transform(math::Vector2f({ x(rng), y(rng) }), r);
+                plane.set_velocity(math::Vector2f({ std::cos(r), std::sin(r) }) * PLANE_SPEED);
+            }
+
+        for (auto& plane : planes)
+        {
+            plane.add_static_forces();
+            plane.update(DT, terrain);
+        }
+        for (size_t i = 0; i + 1 < planes.size(); i += 2)
+            planes[i].correct_positions(math::Vector2f({ 0.05f, 0.05f }), DT, planes[i + 1], terrain);
+    }
+    std::chrono::duration<double, std::nano> const ns = std::chrono::steady_clock::now() - start;
+
+    float state = 0.0f;
+    for (auto const& plane : planes)
+        state += plane.get_position()[X] + plane.get_position()[Y] + plane.get_rotation();
+    return { ns.count() / (static_cast<double>(TICKS) * NUM_PLANES), state };
+}
+
+} // namespace
+
+int main()
+{
+    test::TestLevel level(WIDTH, HEIGHT, is_solid);
+    entities::LevelTerrain& terrain = level.get_terrain();
+
+    std::printf("terrain_collision_bench: %dx%d level, %d planes, %d ticks\n",
+                WIDTH, HEIGHT, NUM_PLANES, TICKS);
+
+    terrain.set_use_clearance(false);
+    Result const walk = run(terrain);
+    terrain.set_use_clearance(true);
+    Result const field = run(terrain);
+
+    std::printf("  %-16s %8.1f ns/plane/tick\n", "edge walks", walk.ns_per_plane_tick);
+    std::printf("  %-16s %8.1f ns/plane/tick  x%.1f  %s\n", "distance field",
+                field.ns_per_plane_tick, walk.ns_per_plane_tick / field.ns_per_plane_tick,
+                field.state == walk.state ? "same state" : "STATE DIFFERS");
+    return 0;
+}
@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "test.hpp"
+#include "test_level.hpp"
+#include "../src/entities/projectile_system.hpp"
+
+// 1,000 explosions on a solid 2048x1024 level, queued a few per tick the
+// way projectiles land, through the whole LevelTerrain::update path. The
+// alpha clearing inside it is then timed on its own, the SIMD span path
+// against the scalar loop over the same rows.
+
+namespace {
+
+int const WIDTH            = 2048;
+int const HEIGHT           = 1024;
+int const NUM_CIRCLES      = 1000;
+int const CIRCLES_PER_TICK = 4;
+int const SPAN_PASSES      = 50;
+
+volatile int g_sink;
+
+struct Row
+{
+    int y;
+    int start_x;
+    int end_x;
+};
+
+// The rows LevelTerrain::add_circle_spans clears for one circle, clipped
+// to the level, widest span per row
+void add_circle_rows(std::vector<Row>& rows, math::Vector2i const& center, int const r)
+{
+    std::vector<Row> circle;
+    auto const add = [&circle](int const y, int const start_x, int const end_x)
+    {
+        int const start = std::max(start_x, 0);
+        int const end   = std::min(end_x, WIDTH);
+        if (y < 0 || y >= HEIGHT || start >= end)
+            return;
+        for (auto& row : circle)
+            if (row.y == y)
+            {
+                row.start_x = std::min(row.start_x, start);
+                row.end_x   = std::max(row.end_x, end);
+                return;
+            }
+        circle.push_back({ y, start, end });
+    };
+
+    int x   = r;
+    int y   = 0;
+    int err = 0;
+    while (x >= y)
+    {
+        add(center[Y] + y, center[X] - x, center[X] + x);
+        add(center[Y] - y, center[X] - x, center[X] + x);
+        add(center[Y] + x, center[X] - y, center[X] + y);
+        add(center[Y] - x, center[X] - y, center[X] + y);
+
+        err += 1 + 2 * (++y);
+        if (2 * (err - x) + 1 > 0)
+            err += 1 - 2 * (--x);
+    }
+    rows.insert(rows.end(), circle.begin(), circle.end());
+}
+
+long count_pixels(std::vector<Row> const& rows)
+{
+    long n = 0;
+    for (auto const& row : rows)
+        n += row.end_x - row.start_x;
+    return n;
+}
+
+template<class Clear>
+double time_spans(std::vector<GLubyte>& rgba, std::vector<Row> const& rows, Clear const& clear)
+{
+    return test::time_ns(SPAN_PASSES, [&]()
+    {
+        for (auto const& row : rows)
+            clear(&rgba[(static_cast<size_t>(row.y) * WIDTH + static_cast<size_t>(row.start_x)) * 4],
+                  row.end_x - row.start_x);
+        g_sink = rgba[0];
+    });
+}
+
+} // namespace
+
+int main()
+{
+    std::mt19937 rng(21);
+    std::uniform_int_distribution<int> x(0, WIDTH - 1);
+    std::uniform_int_distribution<int> y(0, HEIGHT - 1);
+    std::uniform_int_distribution<int> type(0, entities::ProjectileSystem::NUM_TYPES - 1);
+
+    std::vector<std::pair<math::Vector2i, int>> circles;
+    std::vector<Row> rows;
+    for (int i = 0; i < NUM_CIRCLES; ++i)
+    {
+        circles.emplace_back(math::Vector2i({ x(rng), y(rng) }),
+                             entities::ProjectileSystem::EXPLOSION_RADII[type(rng)]);
+        add_circle_rows(rows, circles.back().first, circles.back().second);
+    }
+    long const pixels = count_pixels(rows);
+
+    std::printf("terrain_destruction_bench: %dx%d level, %d circles, %ld pixels in their spans\n",
+                WIDTH, HEIGHT, NUM_CIRCLES, pixels);
+
+    {
+        test::TestLevel level(WIDTH, HEIGHT, [](int, int) { return true; });
+        entities::LevelTerrain& terrain = level.get_terrain();
+
+        auto const start = std::chrono::steady_clock::now();
+        for (int i = 0; i < NUM_CIRCLES; ++i)
+        {
+            terrain.destroy_circle(circles[static_cast<size_t>(i)].first, circles[static_cast<size_t>(i)].second);
+            if ((i + 1) % CIRCLES_PER_TICK == 0)
+                terrain.update();
+        }
+        terrain.update();
+        std::chrono::duration<double, std::nano> const ns = std::chrono::steady_clock::now() - start;
+
+        std::printf("  %-12s %10.1f us/circle  %10.1f Mpixels/s  (%d circles per update)\n",
+                    "update", ns.count() * 1e-3 / NUM_CIRCLES,
+                    static_cast<double>(pixels) * 1e3 / ns.count(), CIRCLES_PER_TICK);
+    }
+
+    std::vector<GLubyte> rgba(static_cast<size_t>(WIDTH) * HEIGHT * 4, 0xff);
+    double const simd_ns   = time_spans(rgba, rows, entities::LevelTerrain::clear_alpha_span);
+    double const scalar_ns = time_spans(rgba, rows, entities::LevelTerrain::clear_alpha_span_scalar);
+
+#if defined(__AVX2__)
+    char const* const path = "avx2";
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    char const* const path = "sse2";
+#else
+    char const* const path = "scalar";
+#endif
+    std::printf("  %-12s %10.1f us/pass    %10.1f Mpixels/s\n",
+                path, simd_ns * 1e-3, static_cast<double>(pixels) * 1e3 / simd_ns);
+    std::printf("  %-12s %10.1f us/pass    %10.1f Mpixels/s  x%.1f\n",
+                "scalar", scalar_ns * 1e-3, static_cast<double>(pixels) * 1e3 / scalar_ns,
+                scalar_ns / simd_ns);
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_level.hpp"
+#include "../src/entities/terrain_distance_field.hpp"
+#include "../src/entities/terrain_mask.hpp"
+
+// The tile chamfer field against exact distances from a brute-force scan
+// over every solid pixel, on a fresh field and after destroyed circles
+// have been refreshed.
+
+namespace {
+
+int const WIDTH  = 203;
+int const HEIGHT = 117;
+int const TILE   = entities::TerrainMask::TILE_SIZE;
+
+// Solid pixels scattered as small squares, with the density setting how
+// far the open space between them reaches
+std::vector<bool> make_blobs(unsigned const seed, int const count, int const size)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> x(0, WIDTH - 1);
+    std::uniform_int_distribution<int> y(0, HEIGHT - 1);
+
+    std::vector<bool> solid(static_cast<size_t>(WIDTH * HEIGHT), false);
+    for (int i = 0; i < count; ++i)
+    {
+        int const bx = x(rng);
+        int const by = y(rng);
+        for (int py = by; py < std::min(by + size, HEIGHT); ++py)
+            for (int px = bx; px < std::min(bx + size, WIDTH); ++px)
+                solid[static_cast<size_t>(py * WIDTH + px)] = true;
+    }
+    return solid;
+}
+
+// Distance from pos to the closest solid pixel square or to the edge of
+// the terrain, whichever is nearer
+float brute_clearance(entities::TerrainMask const& mask, math::Vector2f const& pos)
+{
+    float best = std::min(std::min(pos[X], static_cast<float>(WIDTH)  - pos[X]),
+                          std::min(pos[Y], static_cast<float>(HEIGHT) - pos[Y]));
+    for (int y = 0; y < HEIGHT; ++y)
+        for (int x = 0; x < WIDTH; ++x)
+            if (mask.is_solid(x, y))
+            {
+                float const dx = std::max(std::max(static_cast<float>(x) - pos[X], pos[X] - static_cast<float>(x + 1)), 0.0f);
+                float const dy = std::max(std::max(static_cast<float>(y) - pos[Y], pos[Y] - static_cast<float>(y + 1)), 0.0f);
+                best = std::min(best, std::sqrt(dx * dx + dy * dy));
+            }
+    return std::max(best, 0.0f);
+}
+
+void test_fresh_field_bounds()
+{
+    std::mt19937 rng(16);
+    std::uniform_real_distribution<float> x(-4.0f, WIDTH + 4.0f);
+    std::uniform_real_distribution<float> y(-4.0f, HEIGHT + 4.0f);
+
+    // From nearly open to crowded, so distances both short and across many
+    // tiles get checked
+    int const densities[3] = { 3, 20, 150 };
+    for (int const count : densities)
+    {
+        std::vector<bool> const solid = make_blobs(static_cast<unsigned>(count), count, 3);
+        std::vector<GLubyte> rgba(static_cast<size_t>(WIDTH * HEIGHT) * 4, 0);
+        for (size_t i = 0; i < solid.size(); ++i)
+            rgba[i * 4 + 3] = solid[i] ? 0xff : 0;
+
+        entities::TerrainMask const          mask(math::Vector2i({ WIDTH, HEIGHT }), rgba.data(), 4);
+        entities::TerrainDistanceField const field(mask);
+
+        bool lower_bound = true;
+        bool tight       = true;
+        for (int i = 0; i < 3000; ++i)
+        {
+            math::Vector2f const pos({ x(rng), y(rng) });
+            float const clearance = field.get_clearance(pos);
+            float const exact     = brute_clearance(mask, pos);
+
+            // Never more room than there is
+            lower_bound = lower_bound && clearance <= exact + 1e-4f;
+
+            // Chebyshev over tiles loses at most a factor of sqrt(2) and
+            // the two partial tiles at either end
+            tight = tight && exact <= 1.4143f * (clearance + 2 * TILE) + 1e-3f;
+        }
+        CHECK(lower_bound);
+        CHECK(tight);
+
+        // A body gone NaN must not read outside the field
+        float const nan = std::numeric_limits<float>::quiet_NaN();
+        CHECK(field.get_clearance(math::Vector2f({ nan, 50.0f })) == 0.0f);
+        CHECK(field.get_clearance(math::Vector2f({ 50.0f, nan })) == 0.0f);
+    }
+}
+
+void test_refresh_after_destroy()
+{
+    // Crowded enough that every distance stays well inside the refresh
+    // margin, so a refreshed window has to match a full rebuild exactly
+    std::vector<bool> const solid = make_blobs(1600, 1600, 2);
+    test::TestLevel level(WIDTH, HEIGHT, [&solid](int const x, int const y)
+    {
+        return solid[static_cast<size_t>(y * WIDTH + x)];
+    });
+    entities::LevelTerrain& terrain = level.get_terrain();
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int> cx(0, WIDTH - 1);
+    std::uniform_int_distribution<int> cy(0, HEIGHT - 1);
+    std::uniform_int_distribution<int> radius(4, 30);
+    std::uniform_real_distribution<float> offset(-3.0f, 3.0f);
+
+    for (int round = 0; round < 6; ++round)
+    {
+        std::vector<std::pair<math::Vector2i, int>> circles;
+        for (int i = 0; i < 4; ++i)
+        {
+            circles.emplace_back(math::Vector2i({ cx(rng), cy(rng) }), radius(rng));
+            terrain.destroy_circle(circles.back().first, circles.back().second);
+        }
+
+        // Nothing counts as cleared before update() has run
+        math::Vector2f const first(circles[0].first);
+        CHECK(!terrain.is_disc_empty(first, static_cast<float>(circles[0].second)));
+
+        terrain.update();
+
+        entities::TerrainMask const mask(math::Vector2i({ WIDTH, HEIGHT }), level.get_image_data(), 4);
+        entities::TerrainDistanceField const rebuilt(mask);
+
+        bool conservative = true;
+        bool same_as_full = true;
+        for (auto const& c : circles)
+            for (int i = 0; i < 200; ++i)
+            {
+                math::Vector2f const pos({ static_cast<float>(c.first[X]) + offset(rng) * static_cast<float>(c.second) / 3.0f,
+                                           static_cast<float>(c.first[Y]) + offset(rng) * static_cast<float>(c.second) / 3.0f });
+                float const exact = brute_clearance(mask, pos);
+
+                // is_disc_empty keeps a pixel of slack for its callers
+                for (float r = 0.0f; r < 40.0f; r += 1.5f)
+                    conservative = conservative && (!terrain.is_disc_empty(pos, r) || r + 1.0f < exact);
+
+                // The answers flip exactly where the rebuilt field says
+                float const expected = rebuilt.get_clearance(pos);
+                same_as_full = same_as_full
+                            &&  terrain.is_disc_empty(pos, expected - 1.5f)
+                            && !terrain.is_disc_empty(pos, expected - 0.5f);
+            }
+        CHECK(conservative);
+        CHECK(same_as_full);
+    }
+
+    // The craters opened up tiles that are counted as clear again
+    bool any_clear = false;
+    for (int y = 0; y < HEIGHT && !any_clear; y += 2)
+        for (int x = 0; x < WIDTH && !any_clear; x += 2)
+            any_clear = terrain.is_disc_empty(math::Vector2f({ static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f }), 6.0f);
+    CHECK(any_clear);
+}
+
+} // namespace
+
+int main()
+{
+    test_fresh_field_bounds();
+    test_refresh_after_destroy();
+    return test::finish("terrain_distance_field_test");
+}
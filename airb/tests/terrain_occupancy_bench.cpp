@@ -0,0 +1,106 @@
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "test.hpp"
+#include "test_level.hpp"
+
+// Rect and segment queries through the occupancy pyramid against the
+// per-pixel scans they replace, on a 2048x1024 level with hills, caves
+// and 200 destroyed circles. Nav cells ask 50x50 rects, collider edges
+// ask segments a plane's length long.
+
+namespace {
+
+int const WIDTH       = 2048;
+int const HEIGHT      = 1024;
+int const NUM_QUERIES = 4096;
+
+volatile int g_sink;
+
+bool is_solid(int const x, int const y)
+{
+    float const ground = 500.0f + 200.0f * std::sin(static_cast<float>(x) * 0.004f);
+    float const cx     = static_cast<float>(x % 300) - 150.0f;
+    float const cy     = static_cast<float>(y) - 250.0f;
+    return static_cast<float>(y) < ground && cx * cx + cy * cy > 4900.0f;
+}
+
+template<class Fast, class Scan>
+void compare(char const* const name, Fast const& fast, Scan const& scan)
+{
+    int agree = 0;
+    for (int i = 0; i < NUM_QUERIES; ++i)
+        agree += fast(i) == scan(i);
+
+    int n = 0;
+    double const fast_ns = test::time_ns(20, [&]()
+    {
+        for (int i = 0; i < NUM_QUERIES; ++i)
+            n += fast(i);
+    }) / NUM_QUERIES;
+    double const scan_ns = test::time_ns(2, [&]()
+    {
+        for (int i = 0; i < NUM_QUERIES; ++i)
+            n += scan(i);
+    }) / NUM_QUERIES;
+    g_sink = n;
+
+    std::printf("  %-14s pyramid %9.1f ns  per-pixel %10.1f ns  x%-7.1f %d/%d agree\n",
+                name, fast_ns, scan_ns, scan_ns / fast_ns, agree, NUM_QUERIES);
+}
+
+} // namespace
+
+int main()
+{
+    test::TestLevel level(WIDTH, HEIGHT, is_solid);
+    entities::LevelTerrain& terrain = level.get_terrain();
+
+    std::mt19937 rng(17);
+    std::uniform_int_distribution<int>    x(0, WIDTH - 1);
+    std::uniform_int_distribution<int>    y(0, HEIGHT - 1);
+    std::uniform_int_distribution<int>    r(5, 40);
+    std::uniform_real_distribution<float> reach(-100.0f, 100.0f);
+
+    for (int i = 0; i < 200; ++i)
+        terrain.destroy_circle(math::Vector2i({ x(rng), y(rng) }), r(rng));
+    terrain.update();
+
+    std::printf("terrain_occupancy_bench: %dx%d level, %d queries each\n", WIDTH, HEIGHT, NUM_QUERIES);
+
+    int const sizes[3] = { 8, 50, 256 };
+    for (int const size : sizes)
+    {
+        std::vector<math::Vector2i> corners;
+        for (int i = 0; i < NUM_QUERIES; ++i)
+            corners.push_back(math::Vector2i({ x(rng), y(rng) }));
+        auto const tr = [&corners, size](int const i)
+        {
+            return corners[static_cast<size_t>(i)] + math::Vector2i({ size - 1, size - 1 });
+        };
+
+        char name[32];
+        std::snprintf(name, sizeof name, "empty %dx%d", size, size);
+        compare(name,
+            [&](int const i) { return terrain.is_rect_empty(corners[static_cast<size_t>(i)], tr(i)); },
+            [&](int const i) { return test::scan_rect(terrain, corners[static_cast<size_t>(i)], tr(i), false); });
+        std::snprintf(name, sizeof name, "solid %dx%d", size, size);
+        compare(name,
+            [&](int const i) { return terrain.is_rect_solid(corners[static_cast<size_t>(i)], tr(i)); },
+            [&](int const i) { return test::scan_rect(terrain, corners[static_cast<size_t>(i)], tr(i), true); });
+    }
+
+    std::vector<math::Vector2f> from;
+    std::vector<math::Vector2f> to;
+    for (int i = 0; i < NUM_QUERIES; ++i)
+    {
+        from.push_back(math::Vector2f({ static_cast<float>(x(rng)) + 0.5f, static_cast<float>(y(rng)) + 0.5f }));
+        to.push_back(from.back() + math::Vector2f({ reach(rng), reach(rng) }));
+    }
+    compare("segment",
+        [&](int const i) { return terrain.is_segment_empty(from[static_cast<size_t>(i)], to[static_cast<size_t>(i)]); },
+        [&](int const i) { return test::scan_segment_empty(terrain, from[static_cast<size_t>(i)], to[static_cast<size_t>(i)]); });
+    return 0;
+}
@@ -0,0 +1,160 @@
+#include <cmath>
+#include <random>
+
+#include "test.hpp"
+#include "test_level.hpp"
+
+// Rect and segment queries through the occupancy pyramid against plain
+// per-pixel scans, before and after circles are destroyed.
+
+namespace {
+
+int const WIDTH  = 301;
+int const HEIGHT = 187;
+
+// Hills with caves and a few floating slabs, so there are wide uniform
+// areas for the pyramid to skip as well as mixed edge tiles
+bool is_solid(int const x, int const y)
+{
+    float const ground = 90.0f + 30.0f * std::sin(static_cast<float>(x) * 0.05f);
+    float const cx     = static_cast<float>(x % 60) - 30.0f;
+    float const cy     = static_cast<float>(y) - 40.0f;
+    bool  const cave   = cx * cx + cy * cy < 200.0f;
+    bool  const slab   = y > 140 && y < 150 && x % 97 < 40;
+    return (static_cast<float>(y) < ground && !cave) || slab;
+}
+
+struct Counts
+{
+    int empty;
+    int solid;
+    int mixed;
+};
+
+Counts check_rects(entities::LevelTerrain const& terrain, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> x(-40, WIDTH + 40);
+    std::uniform_int_distribution<int> y(-40, HEIGHT + 40);
+    std::uniform_int_distribution<int> size(0, 150);
+    std::uniform_int_distribution<int> shift(0, 4);
+
+    Counts counts = { 0, 0, 0 };
+    bool same_empty = true;
+    bool same_solid = true;
+    for (int i = 0; i < 20000; ++i)
+    {
+        math::Vector2i bl({ x(rng), y(rng) });
+        math::Vector2i tr;
+        switch (i % 4)
+        {
+        case 0:
+            // Aligned to pyramid nodes of some level, where a single
+            // uniform node answers on its own
+            {
+                int const node = entities::TerrainMask::TILE_SIZE << shift(rng);
+                bl = math::Vector2i({ bl[X] / node * node, bl[Y] / node * node });
+                tr = bl + math::Vector2i({ node - 1, node - 1 });
+            }
+            break;
+        case 1:
+            // Single pixels
+            tr = bl;
+            break;
+        default:
+            // Anything, including rects hanging off the terrain and some
+            // with their corners the wrong way round
+            tr = bl + math::Vector2i({ size(rng) - 10, size(rng) - 10 });
+            break;
+        }
+
+        bool const empty = terrain.is_rect_empty(bl, tr);
+        bool const solid = terrain.is_rect_solid(bl, tr);
+        same_empty = same_empty && empty == test::scan_rect(terrain, bl, tr, false);
+        same_solid = same_solid && solid == test::scan_rect(terrain, bl, tr, true);
+
+        counts.empty += empty;
+        counts.solid += solid;
+        counts.mixed += !empty && !solid;
+    }
+    CHECK(same_empty);
+    CHECK(same_solid);
+    return counts;
+}
+
+int check_segments(entities::LevelTerrain const& terrain, std::mt19937& rng)
+{
+    std::uniform_real_distribution<float> x(-10.0f, WIDTH + 10.0f);
+    std::uniform_real_distribution<float> y(-10.0f, HEIGHT + 10.0f);
+    std::uniform_real_distribution<float> reach(-60.0f, 60.0f);
+
+    int  num_empty = 0;
+    bool same      = true;
+    for (int i = 0; i < 20000; ++i)
+    {
+        math::Vector2f const a({ x(rng), y(rng) });
+        math::Vector2f b = a + math::Vector2f({ reach(rng), reach(rng) });
+        // Axis-aligned and zero-length segments take their own slab path
+        if (i % 5 == 0)
+            b = math::Vector2f({ b[X], a[Y] });
+        else if (i % 5 == 1)
+            b = math::Vector2f({ a[X], b[Y] });
+        else if (i % 50 == 2)
+            b = a;
+
+        bool const empty = terrain.is_segment_empty(a, b);
+        same = same && empty == test::scan_segment_empty(terrain, a, b);
+        num_empty += empty;
+    }
+    CHECK(same);
+    return num_empty;
+}
+
+void test_queries_match_scans()
+{
+    test::TestLevel level(WIDTH, HEIGHT, is_solid);
+    entities::LevelTerrain& terrain = level.get_terrain();
+
+    std::mt19937 rng(17);
+    Counts const before = check_rects(terrain, rng);
+    int    const clear  = check_segments(terrain, rng);
+
+    // Every kind of answer has to come up for the comparison to mean much
+    CHECK(before.empty > 1000 && before.solid > 1000 && before.mixed > 1000);
+    CHECK(clear > 1000);
+
+    // Destroyed circles split uniform nodes, the refreshed pyramid has to
+    // follow them all the way up
+    std::uniform_int_distribution<int> cx(0, WIDTH - 1);
+    std::uniform_int_distribution<int> cy(0, HEIGHT - 1);
+    std::uniform_int_distribution<int> r(3, 25);
+    for (int round = 0; round < 4; ++round)
+    {
+        for (int i = 0; i < 10; ++i)
+            terrain.destroy_circle(math::Vector2i({ cx(rng), cy(rng) }), r(rng));
+        terrain.update();
+
+        Counts const after = check_rects(terrain, rng);
+        CHECK(after.mixed > 1000);
+        check_segments(terrain, rng);
+    }
+
+    // Once everything is gone the root alone answers
+    for (int y = 0; y < HEIGHT; y += 20)
+        for (int x = 0; x < WIDTH; x += 20)
+            terrain.destroy_circle(math::Vector2i({ x, y }), 20);
+    terrain.update();
+    math::Vector2i const far_corner({ WIDTH - 1, HEIGHT - 1 });
+    CHECK(test::scan_rect(terrain, math::Vector2i({ 0, 0 }), far_corner, false));
+    CHECK(terrain.is_rect_empty(math::Vector2i({ 0, 0 }), far_corner));
+    CHECK(!terrain.is_rect_solid(math::Vector2i({ 0, 0 }), far_corner));
+    CHECK(terrain.is_segment_empty(math::Vector2f({ 0.5f, 0.5f }),
+                                   math::Vector2f({ WIDTH - 0.5f, HEIGHT - 0.5f })));
+}
+
+} // namespace
+
+int main()
+{
+    test_queries_match_scans();
+    return test::finish("terrain_occupancy_test");
+}
@@ -0,0 +1,52 @@
+#ifndef TESTS_TEST_HPP
+#define TESTS_TEST_HPP
+
+#include <chrono>
+#include <cstdio>
+
+// Minimal checks for the headless tests under tests/. A failed check is
+// reported and counted but does not stop the test, and finish() turns the
+// count into the exit status that make test looks at.
+#define CHECK(cond) test::check((cond), #cond, __FILE__, __LINE__)
+
+namespace test {
+
+inline int& failures()
+{
+    static int n = 0;
+    return n;
+}
+
+inline bool check(bool const ok, char const* const expr, char const* const file, int const line)
+{
+    if (!ok)
+    {
+        ++failures();
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, expr);
+    }
+    return ok;
+}
+
+inline int finish(char const* const name)
+{
+    if (failures() == 0)
+        std::printf("%s: ok\n", name);
+    else
+        std::printf("%s: %d check(s) failed\n", name, failures());
+    return failures() == 0 ? 0 : 1;
+}
+
+// Nanoseconds one call of func takes, averaged over iterations calls
+template<class Func>
+double time_ns(long const iterations, Func const& func)
+{
+    auto const start = std::chrono::steady_clock::now();
+    for (long i = 0; i < iterations; ++i)
+        func();
+    std::chrono::duration<double, std::nano> const total = std::chrono::steady_clock::now() - start;
+    return total.count() / static_cast<double>(iterations);
+}
+
+} // namespace test
+
+#endif // TESTS_TEST_HPP
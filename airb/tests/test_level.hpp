@@ -0,0 +1,157 @@
+#ifndef TESTS_TEST_LEVEL_HPP
+#define TESTS_TEST_LEVEL_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../src/entities/level_terrain.hpp"
+#include "../src/graphics/image.hpp"
+#include "../src/graphics/texture_uploader.hpp"
+
+namespace test {
+
+// Writes an uncompressed 32-bit TGA laid out like the level images: the
+// terrain takes the first half of the rows and the second half is left
+// empty. A pixel is opaque where solid(x, y) holds.
+template<class Solid>
+std::string write_level_image(std::string const& path, int const width, int const height,
+                              Solid const& solid)
+{
+    unsigned char const header[18] = {
+        0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        static_cast<unsigned char>(width & 0xff),  static_cast<unsigned char>(width >> 8),
+        static_cast<unsigned char>((2 * height) & 0xff), static_cast<unsigned char>((2 * height) >> 8),
+        32, 0
+    };
+
+    std::ofstream f(path, std::ios::binary);
+    f.write(reinterpret_cast<char const*>(header), sizeof header);
+
+    std::vector<char> row(static_cast<size_t>(width) * 4);
+    for (int y = 0; y < 2 * height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+        {
+            bool const s = y < height && solid(x, y);
+            char* px = &row[static_cast<size_t>(x) * 4];
+            px[0] = px[1] = px[2] = s ? 0x40 : 0;
+            px[3] = s ? static_cast<char>(0xff) : 0;
+        }
+        f.write(row.data(), static_cast<std::streamsize>(row.size()));
+    }
+    return path;
+}
+
+// A LevelTerrain built from a generated image. The image file is only
+// needed while loading and is removed again. Its name is random so tests
+// and benches run side by side under make -j keep to their own files.
+class TestLevel final
+{
+private:
+    graphics::NullTextureUploader m_null_uploader;
+    std::string                   m_image_path;
+    graphics::Image               m_image;
+    entities::LevelTerrain        m_terrain;
+
+public:
+    template<class Solid>
+    TestLevel(int const width, int const height, Solid const& solid,
+              graphics::TextureUploader* const uploader = nullptr)
+        : m_null_uploader ()
+        , m_image_path    ("test_level_" + std::to_string(std::random_device()()) + ".tga")
+        , m_image         (write_level_image(m_image_path, width, height, solid))
+        , m_terrain       (m_image, uploader ? *uploader : m_null_uploader)
+    {
+        std::remove(m_image_path.c_str());
+    }
+
+    TestLevel            (TestLevel const&) = delete;
+    TestLevel& operator= (TestLevel const&) = delete;
+
+    entities::LevelTerrain& get_terrain() { return m_terrain; }
+
+    // The RGBA data the terrain clears destroyed pixels in
+    GLubyte const* get_image_data() const { return m_image.get_image_data(); }
+};
+
+// Per-pixel answer to LevelTerrain::is_rect_empty (solid false) and
+// is_rect_solid (solid true), clamped to the terrain the same way
+inline bool scan_rect(entities::LevelTerrain const& terrain, math::Vector2i const& bl,
+                      math::Vector2i const& tr, bool const solid)
+{
+    math::Vector2i const& dim = terrain.get_dimensions();
+    int const x0 = std::max(bl[X], 0);
+    int const y0 = std::max(bl[Y], 0);
+    int const x1 = std::min(tr[X], dim[X] - 1);
+    int const y1 = std::min(tr[Y], dim[Y] - 1);
+    if (x0 > x1 || y0 > y1)
+        return !solid;
+
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+            if (terrain.is_pixel_solid(math::Vector2i({ x, y })) != solid)
+                return false;
+    return true;
+}
+
+// Per-pixel answer to LevelTerrain::is_segment_empty: no solid pixel
+// square, closed, is touched by the segment from a to b
+inline bool scan_segment_empty(entities::LevelTerrain const& terrain,
+                               math::Vector2f const& a, math::Vector2f const& b)
+{
+    math::Vector2i const& dim = terrain.get_dimensions();
+    auto const inside = [&dim](math::Vector2f const& p)
+    {
+        return p[X] >= 0.0f && p[X] < static_cast<float>(dim[X])
+            && p[Y] >= 0.0f && p[Y] < static_cast<float>(dim[Y]);
+    };
+    if (!inside(a) || !inside(b))
+        return false;
+
+    math::Vector2f const d = b - a;
+    auto const hits_pixel = [&a, &d](int const x, int const y)
+    {
+        float t0 = 0.0f;
+        float t1 = 1.0f;
+        float const lo[2] = { static_cast<float>(x), static_cast<float>(y) };
+        float const hi[2] = { lo[0] + 1.0f, lo[1] + 1.0f };
+        for (int i = 0; i < 2; ++i)
+        {
+            if (d[i] == 0.0f)
+            {
+                if (a[i] < lo[i] || a[i] > hi[i])
+                    return false;
+                continue;
+            }
+            float ta = (lo[i] - a[i]) / d[i];
+            float tb = (hi[i] - a[i]) / d[i];
+            if (ta > tb)
+                std::swap(ta, tb);
+            t0 = std::max(t0, ta);
+            t1 = std::min(t1, tb);
+            if (t0 > t1)
+                return false;
+        }
+        return true;
+    };
+
+    int const x0 = std::max(static_cast<int>(std::floor(std::min(a[X], b[X]))) - 1, 0);
+    int const y0 = std::max(static_cast<int>(std::floor(std::min(a[Y], b[Y]))) - 1, 0);
+    int const x1 = std::min(static_cast<int>(std::floor(std::max(a[X], b[X]))) + 1, dim[X] - 1);
+    int const y1 = std::min(static_cast<int>(std::floor(std::max(a[Y], b[Y]))) + 1, dim[Y] - 1);
+    for (int y = y0; y <= y1; ++y)
+        for (int x = x0; x <= x1; ++x)
+            if (terrain.is_pixel_solid(math::Vector2i({ x, y })) && hits_pixel(x, y))
+                return false;
+    return true;
+}
+
+} // namespace test
+
+#endif // TESTS_TEST_LEVEL_HPP
@@ -0,0 +1,54 @@
+#ifndef TESTS_TEST_PLANES_HPP
+#define TESTS_TEST_PLANES_HPP
+
+#include <vector>
+
+#include "../src/math/matrix.hpp"
+#include "../src/physics/box_collider.hpp"
+#include "../src/physics/rigid_body_with_collider.hpp"
+
+namespace test {
+
+// A body with the two boxes the server gives every plane, fuselage and
+// wings, moved to pos and turned by rot radians
+inline physics::RigidBodyWithCollider make_plane_body(math::Vector2f const& pos, float const rot)
+{
+    math::Vector2f const origin(math::Vector2f::one() * 900.0f);
+    std::vector<physics::BoxCollider> const colliders
+    {
+        physics::BoxCollider(std::vector<math::Vector2f>
+        {
+            math::Vector2f({ 879.0f, 991.0f }),
+            math::Vector2f({ 905.0f, 991.0f }),
+            math::Vector2f({ 905.0f, 812.0f }),
+            math::Vector2f({ 879.0f, 812.0f })
+        }),
+        physics::BoxCollider(std::vector<math::Vector2f>
+        {
+            math::Vector2f({ 819.0f, 916.0f }),
+            math::Vector2f({ 916.0f, 916.0f }),
+            math::Vector2f({ 916.0f, 879.0f }),
+            math::Vector2f({ 819.0f, 879.0f })
+        })
+    };
+
+    physics::RigidBodyWithCollider body(1.0f, 1.0f, 1.0f, colliders, origin);
+    body.set_transform(pos, rot);
+    return body;
+}
+
+// The narrow phase the gameplay loops run on each candidate plane
+inline bool hits(physics::RigidBodyWithCollider& body, math::Vector2f const& point)
+{
+    for (auto const& c : body.get_collider())
+    {
+        math::Vector2f const coll = c.check_collision(point);
+        if (coll[X] != 0 || coll[Y] != 0)
+            return true;
+    }
+    return false;
+}
+
+} // namespace test
+
+#endif // TESTS_TEST_PLANES_HPP
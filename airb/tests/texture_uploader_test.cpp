@@ -0,0 +1,132 @@
+#include <vector>
+
+#include "test.hpp"
+#include "test_level.hpp"
+#include "../src/graphics/dirty_region.hpp"
+
+namespace {
+
+// Keeps the areas of every upload instead of sending them anywhere
+class RecordingUploader final : public graphics::TextureUploader
+{
+public:
+    std::vector<std::vector<graphics::TextureArea>> m_uploads;
+    int                                             m_row_length;
+
+     RecordingUploader() : m_uploads(), m_row_length(0) { }
+    ~RecordingUploader() = default;
+
+    void upload(std::vector<graphics::TextureArea> const& areas, GLubyte const*,
+                int const row_length) override
+    {
+        m_uploads.push_back(areas);
+        m_row_length = row_length;
+    }
+};
+
+std::size_t area_bytes(std::vector<graphics::TextureArea> const& areas)
+{
+    std::size_t bytes = 0;
+    for (auto const& a : areas)
+        bytes += static_cast<std::size_t>(a.second[X] * a.second[Y]) * 4;
+    return bytes;
+}
+
+bool overlaps(graphics::TextureArea const& a, graphics::TextureArea const& b)
+{
+    return a.first[X] < b.first[X] + b.second[X] && b.first[X] < a.first[X] + a.second[X]
+        && a.first[Y] < b.first[Y] + b.second[Y] && b.first[Y] < a.first[Y] + a.second[Y];
+}
+
+bool covers(std::vector<graphics::TextureArea> const& areas, int const x, int const y)
+{
+    for (auto const& a : areas)
+        if (x >= a.first[X] && x < a.first[X] + a.second[X]
+         && y >= a.first[Y] && y < a.first[Y] + a.second[Y])
+            return true;
+    return false;
+}
+
+void test_overlapping_circles_upload_once()
+{
+    int const width  = 300;
+    int const height = 200;
+    RecordingUploader uploader;
+    test::TestLevel level(width, height, [](int const, int const) { return true; }, &uploader);
+    entities::LevelTerrain& terrain = level.get_terrain();
+
+    // A burst of explosions on the same spot, as a weapon hitting a wall
+    for (int i = 0; i < 20; ++i)
+        terrain.destroy_circle(math::Vector2i({ 150 + i % 3, 100 + i % 2 }), 30);
+    terrain.update();
+
+    graphics::DirtyRegion const& dirty = terrain.get_dirty_region();
+    CHECK(uploader.m_uploads.size() == 1);
+    CHECK(uploader.m_row_length == width);
+
+    // The figures of the flush survive it, the pending ones start over
+    std::vector<graphics::TextureArea> const& areas = uploader.m_uploads.back();
+    CHECK(!areas.empty());
+    CHECK(dirty.get_last_uploaded_bytes() == area_bytes(areas));
+    CHECK(dirty.get_last_requested_bytes() == 20u * 61u * 61u * 4u);
+    CHECK(dirty.get_last_uploaded_bytes() < dirty.get_last_requested_bytes());
+    CHECK(dirty.get_pending_upload_bytes() == 0);
+    CHECK(dirty.get_requested_upload_bytes() == 0);
+    CHECK(dirty.is_empty());
+
+    for (size_t i = 0; i < areas.size(); ++i)
+        for (size_t j = i + 1; j < areas.size(); ++j)
+            CHECK(!overlaps(areas[i], areas[j]));
+
+    // Every destroyed pixel is in some uploaded area
+    GLubyte const* const rgba = level.get_image_data();
+    bool covered = true;
+    for (int y = 0; y < height; ++y)
+        for (int x = 0; x < width; ++x)
+            if (rgba[(y * width + x) * 4 + 3] == 0)
+                covered = covered && covers(areas, x, y);
+    CHECK(covered);
+}
+
+void test_quiet_frame_uploads_nothing()
+{
+    RecordingUploader uploader;
+    test::TestLevel level(100, 100, [](int const, int const) { return true; }, &uploader);
+    entities::LevelTerrain& terrain = level.get_terrain();
+
+    terrain.destroy_circle(math::Vector2i({ 50, 50 }), 10);
+    terrain.update();
+    CHECK(terrain.get_dirty_region().get_last_uploaded_bytes() > 0);
+
+    terrain.update();
+    CHECK(uploader.m_uploads.size() == 2);
+    CHECK(uploader.m_uploads.back().empty());
+    CHECK(terrain.get_dirty_region().get_last_uploaded_bytes() == 0);
+    CHECK(terrain.get_dirty_region().get_last_requested_bytes() == 0);
+}
+
+void test_region_clipped_to_image()
+{
+    // 64px tiles cut short by a 100x70 image
+    graphics::DirtyRegion dirty(math::Vector2i({ 100, 70 }), 4);
+    RecordingUploader uploader;
+    dirty.mark(math::Vector2i({ 90, 60 }), math::Vector2i({ 99, 69 }));
+    dirty.mark(math::Vector2i({ 0, 0 }), math::Vector2i({ 0, 0 }));
+    CHECK(dirty.get_pending_upload_bytes() == (36u * 70u + 64u * 64u) * 4u);
+    CHECK(dirty.get_requested_upload_bytes() == (100u + 1u) * 4u);
+
+    dirty.flush(uploader, nullptr);
+    CHECK(area_bytes(uploader.m_uploads.back()) == dirty.get_last_uploaded_bytes());
+    CHECK(dirty.get_last_uploaded_bytes() == (36u * 70u + 64u * 64u) * 4u);
+    CHECK(dirty.get_last_requested_bytes() == 101u * 4u);
+}
+
+} // namespace
+
+int main()
+{
+    test_overlapping_circles_upload_once();
+    test_quiet_frame_uploads_nothing();
+    test_region_clipped_to_image();
+    return test::finish("texture_uploader_test");
+}
@@ -0,0 +1,62 @@
+#include <cstdio>
+#include <vector>
+
+#include "test.hpp"
+#include "../src/network/utilities/udp_packet.hpp"
+
+// Building, validating and copying packets the way the sockets do: an
+// input packet as the clients send every frame, and a full binary block
+// like a snapshot.
+
+namespace {
+
+long const ITERATIONS = 2000000;
+
+volatile int g_sink;
+
+void report(char const* const name, int const size, double const ns)
+{
+    std::printf("  %-22s %4d B  %8.1f ns  %10.0f packets/s  %8.1f MB/s\n",
+                name, size, ns, 1e9 / ns, static_cast<double>(size) * 1e3 / ns);
+}
+
+// What the listener does per datagram before anything is queued
+void bench_receive(char const* const name, network::UdpPacket const& packet)
+{
+    report(name, packet.get_size(), test::time_ns(ITERATIONS, [&]()
+    {
+        network::UdpPacketView const view(packet.to_char_array(), packet.get_size());
+        if (view.is_valid())
+            g_sink = static_cast<int>(network::UdpPacket(view).get_token());
+    }));
+}
+
+} // namespace
+
+int main()
+{
+    std::printf("udp_packet_bench: %ld iterations\n", ITERATIONS);
+
+    network::UdpPacket const input(network::UDP_H_INPUT | network::UDP_H_POS, 0x05, 0x81, 2);
+    std::vector<char> block(network::UDP_MAX_DATA_SIZE, 'x');
+    network::UdpPacket full(network::UDP_H_POS);
+    full.set_binary_data(block.data(), static_cast<int>(block.size()));
+
+    report("build input", input.get_size(), test::time_ns(ITERATIONS, [&]()
+    {
+        network::UdpPacket p(network::UDP_H_INPUT | network::UDP_H_POS, 0x05, 0x81, 2);
+        p.set_token(0xdeadbeef);
+        g_sink = p.get_size();
+    }));
+
+    report("build full block", full.get_size(), test::time_ns(ITERATIONS, [&]()
+    {
+        network::UdpPacket p(network::UDP_H_POS);
+        p.set_binary_data(block.data(), static_cast<int>(block.size()));
+        g_sink = p.get_size();
+    }));
+
+    bench_receive("validate+copy input", input);
+    bench_receive("validate+copy full",  full);
+    return 0;
+}
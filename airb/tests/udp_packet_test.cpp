@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test.hpp"
+#include "../src/network/utilities/udp_packet.hpp"
+
+namespace {
+
+void write_length(char* buffer, int const length)
+{
+    buffer[8] = static_cast<char>(length & 0xff);
+    buffer[9] = static_cast<char>(length >> 8);
+}
+
+void test_round_trip()
+{
+    std::mt19937 rng(10);
+    std::uniform_int_distribution<int>           byte(0, 255);
+    std::uniform_int_distribution<int>           size(0, network::UDP_MAX_DATA_SIZE + 40);
+    std::uniform_int_distribution<std::uint32_t> token;
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        std::vector<char> data(static_cast<size_t>(size(rng)));
+        for (auto& c : data)
+            c = static_cast<char>(byte(rng));
+
+        network::UdpPacket packet(static_cast<network::U8>(byte(rng)),
+                                  static_cast<network::U8>(byte(rng)),
+                                  static_cast<network::U8>(byte(rng)),
+                                  static_cast<network::U8>(byte(rng)));
+        packet.set_token(token(rng));
+        packet.set_binary_data(data.data(), static_cast<int>(data.size()));
+
+        // Oversize blocks are cut to what fits in a datagram
+        int const expected = std::min(static_cast<int>(data.size()), network::UDP_MAX_DATA_SIZE);
+        CHECK(packet.get_data_size() == expected);
+        CHECK(packet.get_size() == network::UDP_HEADER_SIZE + expected);
+        CHECK(packet.header_contains(network::UDP_H_BINARY));
+
+        network::UdpPacketView const view(packet.to_char_array(), packet.get_size());
+        CHECK(view.is_valid());
+        CHECK(view.get_header_byte() == packet.get_header_byte());
+        CHECK(view.get_move_byte()   == packet.get_move_byte());
+        CHECK(view.get_action_byte() == packet.get_action_byte());
+        CHECK(view.get_pos_byte()    == packet.get_pos_byte());
+        CHECK(view.get_token()       == packet.get_token());
+        CHECK(view.get_data_size()   == expected);
+        CHECK(std::memcmp(view.get_data_block(), data.data(), static_cast<size_t>(expected)) == 0);
+
+        network::UdpPacket const copy(view);
+        CHECK(copy.get_size() == packet.get_size());
+        CHECK(std::memcmp(copy.to_char_array(), packet.to_char_array(),
+                          static_cast<size_t>(packet.get_size())) == 0);
+    }
+}
+
+void test_text_blocks()
+{
+    network::UdpPacket empty(network::UDP_H_DATABLOCK, "");
+    CHECK(empty.get_data_size() == 0);
+    CHECK(empty.get_data_block()[0] == '\0');
+
+    // Zero bytes survive in binary blocks since the length is explicit
+    char const binary[] = { 'a', '\0', 'b' };
+    network::UdpPacket packet(network::UDP_H_DATABLOCK);
+    packet.set_binary_data(binary, 3);
+    network::UdpPacketView const view(packet.to_char_array(), packet.get_size());
+    CHECK(view.is_valid() && view.get_data_size() == 3 && view.get_data_block()[2] == 'b');
+
+    // Text longer than a datagram is cut and stays terminated
+    std::string const text(network::UDP_MAX_DATA_SIZE * 2, 'x');
+    network::UdpPacket const long_text(network::UDP_H_DATABLOCK, text.c_str());
+    CHECK(long_text.get_data_size() == network::UDP_MAX_DATA_SIZE);
+    CHECK(std::strlen(long_text.get_data_block()) == static_cast<size_t>(network::UDP_MAX_DATA_SIZE));
+}
+
+void test_truncated_and_bad_lengths()
+{
+    network::UdpPacket packet(network::UDP_H_DATABLOCK, "12.5|300.25");
+    packet.set_token(0x12345678);
+    int const size = packet.get_size();
+
+    // Every truncation of the datagram is refused, header cuts included
+    for (int n = 0; n < size; ++n)
+        CHECK(!network::UdpPacketView(packet.to_char_array(), n).is_valid());
+
+    // Length fields that disagree with the datagram size either way
+    char buffer[network::UDP_MAX_PACKET_SIZE + 64];
+    std::memcpy(buffer, packet.to_char_array(), static_cast<size_t>(size));
+    for (int length = 0; length <= 0xffff; ++length)
+    {
+        write_length(buffer, length);
+        bool const valid = network::UdpPacketView(buffer, size).is_valid();
+        CHECK(valid == (length == size - network::UDP_HEADER_SIZE));
+    }
+
+    // A datagram over the maximum is refused even if its length agrees
+    int const oversize = network::UDP_MAX_PACKET_SIZE + 1;
+    std::memset(buffer, 0, sizeof buffer);
+    write_length(buffer, oversize - network::UDP_HEADER_SIZE);
+    CHECK(!network::UdpPacketView(buffer, oversize).is_valid());
+    write_length(buffer, network::UDP_MAX_DATA_SIZE);
+    CHECK(network::UdpPacketView(buffer, network::UDP_MAX_PACKET_SIZE).is_valid());
+}
+
+void test_random_datagrams()
+{
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::uniform_int_distribution<int> size(0, network::UDP_MAX_PACKET_SIZE + 32);
+
+    // Whatever passes validation is self-consistent and fits a packet
+    std::vector<char> buffer(network::UDP_MAX_PACKET_SIZE + 32);
+    int accepted = 0;
+    for (int i = 0; i < 200000; ++i)
+    {
+        int const n = size(rng);
+        for (int j = 0; j < n; ++j)
+            buffer[static_cast<size_t>(j)] = static_cast<char>(byte(rng));
+        // Half the time make the length agree so the accept path gets hit
+        if (n >= network::UDP_HEADER_SIZE && i % 2 == 0)
+            write_length(buffer.data(), n - network::UDP_HEADER_SIZE);
+
+        network::UdpPacketView const view(buffer.data(), n);
+        if (!view.is_valid())
+            continue;
+
+        ++accepted;
+        CHECK(n <= network::UDP_MAX_PACKET_SIZE);
+        CHECK(view.get_data_size() == n - network::UDP_HEADER_SIZE);
+
+        network::UdpPacket const copy(view);
+        CHECK(copy.get_data_size() == view.get_data_size());
+        CHECK(copy.get_token() == view.get_token());
+    }
+    CHECK(accepted > 0);
+}
+
+} // namespace
+
+int main()
+{
+    test_round_trip();
+    test_text_blocks();
+    test_truncated_and_bad_lengths();
+    test_random_datagrams();
+    return test::finish("udp_packet_test");
+}